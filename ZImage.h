@@ -9,6 +9,17 @@ Includes the following functions which all return true or false
  - is_mng(char *filename)
  - is_ppm(char *filename)
  - is_psd(char *filename)
+
+and the same checks on encoded payloads already in memory, which only decode
+the first few bytes: base64, hex, or a data URI ("data:image/png;base64,...")
+ - is_png_payload(char *payload, size_t length)
+ - ...
+ - is_psd_payload(char *payload, size_t length)
+
+and a metadata walker for JPEG and PNG that reports where the EXIF, ICC and XMP
+blocks and PNG text chunks are, and the EXIF orientation, without decoding
+ - read_image_metadata(char *filename, ImageMetadata *metadata)
+ - read_image_metadata_data(const unsigned char *data, size_t length, ImageMetadata *metadata)
 */
 
 #ifndef ZIMAGE_H
@@ -16,6 +27,18 @@ Includes the following functions which all return true or false
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>     // size_t
+#include <stdint.h>     // uint32_t
+
+#if !defined(ZIMAGE_NO_SIMD) && defined(__SSSE3__)
+	#define ZIMAGE_SSSE3
+	#include <tmmintrin.h>  // _mm_shuffle_epi8(), _mm_maddubs_epi16()
+#endif
+
+#if !defined(ZIMAGE_NO_SIMD) && defined(__AVX2__)
+	#define ZIMAGE_AVX2
+	#include <immintrin.h>  // _mm256_shuffle_epi8(), _mm256_permutevar8x32_epi32()
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,42 +52,107 @@ extern "C" {
 #define is_ppm(a) has_header(a, HEADER_PPM)
 #define is_psd(a) has_header(a, HEADER_PSD)
 
-const int HEADER_PNG[8] = {137, 80, 78, 71, 13, 10, 26, 10};
-const int HEADER_JPG[3] = {255, 216, 255};
-const int HEADER_GIF[6] = {71, 73, 70, 56, 57, 97}; // {71, 73, 70, 56, 55, 97}
-const int HEADER_BMP[2] = {66, 77};
-const int HEADER_MNG[8] = {138, 77, 78, 71, 13, 10, 26, 10};
-const int HEADER_PPM[2] = {80, 52};
-const int HEADER_PSD[4] = {56, 66, 80, 83};
+#define is_png_payload(a, n) has_header_payload(a, n, HEADER_PNG)
+#define is_jpg_payload(a, n) has_header_payload(a, n, HEADER_JPG)
+#define is_gif_payload(a, n) has_header_payload(a, n, HEADER_GIF)
+#define is_bmp_payload(a, n) has_header_payload(a, n, HEADER_BMP)
+#define is_mng_payload(a, n) has_header_payload(a, n, HEADER_MNG)
+#define is_ppm_payload(a, n) has_header_payload(a, n, HEADER_PPM)
+#define is_psd_payload(a, n) has_header_payload(a, n, HEADER_PSD)
+
+// Signatures end with -1
+const int HEADER_PNG[9] = {137, 80, 78, 71, 13, 10, 26, 10, -1};
+const int HEADER_JPG[4] = {255, 216, 255, -1};
+const int HEADER_GIF[7] = {71, 73, 70, 56, 57, 97, -1}; // {71, 73, 70, 56, 55, 97}
+const int HEADER_BMP[3] = {66, 77, -1};
+const int HEADER_MNG[9] = {138, 77, 78, 71, 13, 10, 26, 10, -1};
+const int HEADER_PPM[3] = {80, 52, -1};
+const int HEADER_PSD[5] = {56, 66, 80, 83, -1};
+
+// Longest signature, and so the most a payload probe decodes
+#define ZIMAGE_PROBE_BYTES 8
+
+// Most PNG text chunks kept in an ImageMetadata
+#ifndef ZIMAGE_TEXT_CHUNKS
+	#define ZIMAGE_TEXT_CHUNKS 16
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Where a block of metadata sits in the file, length 0 if there is none
+typedef struct ImageBlock
+{
+	size_t offset;
+	size_t length;
+} ImageBlock;
+
+// A PNG tEXt, zTXt or iTXt chunk, <text> being what follows its header fields
+typedef struct ImageText
+{
+	char type[5];
+	char keyword[80];
+	ImageBlock text;
+} ImageText;
+
+typedef struct ImageMetadata
+{
+	ImageBlock exif;        // from the TIFF header on
+	ImageBlock icc;         // the first APP2 segment of a split JPEG profile, zlib data in PNG
+	ImageBlock xmp;
+	int orientation;        // EXIF orientation 1-8, 0 if there is none
+	size_t text_count;      // text chunks found, the first ZIMAGE_TEXT_CHUNKS of them in <texts>
+	ImageText texts[ZIMAGE_TEXT_CHUNKS];
+} ImageMetadata;
 
 //----------------------------------------------------------------------------------
 // ZImage Function Declarations
 //----------------------------------------------------------------------------------
 
 bool has_header(char *filename, const int *header);
+bool has_header_data(const unsigned char *data, size_t length, const int *header);
+bool has_header_payload(char *payload, size_t length, const int *header);
+
+size_t decode_payload_head(char *payload, size_t length, unsigned char *output, size_t capacity);
+size_t decode_base64(char *input, size_t length, unsigned char *output);
+
+bool read_image_metadata(char *filename, ImageMetadata *metadata);
+bool read_image_metadata_data(const unsigned char *data, size_t length, ImageMetadata *metadata);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // ZIMAGE_H
 
 //----------------------------------------------------------------------------------
-// ZString Function Definitions
+// ZImage Function Definitions
 //----------------------------------------------------------------------------------
 
 #ifdef ZIMAGE_IMPLEMENTATION
 
+#include <string.h>     // memcmp(), memchr(), memcpy(), memset()
+#include <limits.h>     // LONG_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 bool has_header(char *filename, const int *header)
 {
 	int byte;
 	bool result = true;
 
-	FILE *fp = fopen(filename, "r");
+	FILE *fp = fopen(filename, "rb");
 	if (fp == NULL) {return false;}
 
 	fseek(fp, 0, SEEK_SET);
 
 	int i = 0;
-	while (i < sizeof(header)/sizeof(header[0]) && (byte = (int)fgetc(fp)) != EOF)
+	while (header[i] >= 0)
 	{
-		if (byte != header[i])
+		if ((byte = (int)fgetc(fp)) == EOF || byte != header[i])
 		{
 			result = false;
 			break;
@@ -77,6 +165,668 @@ bool has_header(char *filename, const int *header)
 	return result;
 }
 
+bool has_header_data(const unsigned char *data, size_t length, const int *header)
+{
+	if (data == NULL) {return false;}
+
+	size_t i = 0;
+	while (header[i] >= 0)
+	{
+		if (i >= length || data[i] != header[i]) {return false;}
+
+		++i;
+	}
+
+	return true;
+}
+
+bool has_header_payload(char *payload, size_t length, const int *header)
+{
+	unsigned char head[ZIMAGE_PROBE_BYTES];
+	size_t length_head = decode_payload_head(payload, length, head, sizeof(head));
+
+	return has_header_data(head, length_head, header);
+}
+
+//----------------------------------------------------------------------------------
+// Payload Decoding
+//----------------------------------------------------------------------------------
+
+// 0-63 for the alphabet (standard and URL-safe), 64 for whitespace, 65 for '=', 255 for the rest
+static const unsigned char zimage__base64_values[256] = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255,  64,  64, 255, 255,  64, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	 64, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255,  62, 255,  63,
+	 52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255,  65, 255, 255,
+	255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+	 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255,  63,
+	255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+	 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+static int zimage__hex_value(unsigned char c)
+{
+	if (c >= '0' && c <= '9') {return c - '0';}
+	if (c >= 'a' && c <= 'f') {return c - 'a' + 10;}
+	if (c >= 'A' && c <= 'F') {return c - 'A' + 10;}
+
+	return -1;
+}
+
+/*
+size_t decode_payload_head(char *payload, size_t length, unsigned char *output, size_t capacity)
+
+returns:
+	> the number of bytes (at most <capacity>) decoded to <output> from the start of <payload>,
+	  which is a data URI (base64 or percent-encoded), hex if its first 2 * <capacity> characters
+	  are all hex digits, or base64 otherwise; decoding stops at the first invalid character
+
+example:
+	> decode_payload_head("data:image/png;base64,iVBORw0KGgo=", 34, head, 8) -> 8 (the PNG signature)
+*/
+size_t decode_payload_head(char *payload, size_t length, unsigned char *output, size_t capacity)
+{
+	if (payload == NULL || output == NULL) {return 0;}
+
+	const unsigned char *ptr = (const unsigned char *)payload;
+	const unsigned char *end = ptr + length;
+	size_t count = 0;
+
+	if (length >= 5 && strncmp(payload, "data:", 5) == 0)
+	{
+		const unsigned char *comma = (const unsigned char *)memchr(ptr, ',', length);
+		if (comma == NULL) {return 0;}
+
+		bool base64 = (comma - ptr >= 12 && memcmp(comma - 7, ";base64", 7) == 0);
+		ptr = comma + 1;
+
+		if (!base64)
+		{
+			while (ptr < end && count < capacity)
+			{
+				if (*ptr == '%' && end - ptr >= 3 && zimage__hex_value(ptr[1]) >= 0 && zimage__hex_value(ptr[2]) >= 0)
+				{
+					output[count++] = (unsigned char)(zimage__hex_value(ptr[1]) * 16 + zimage__hex_value(ptr[2]));
+					ptr += 3;
+				}
+				else {output[count++] = *ptr++;}
+			}
+
+			return count;
+		}
+	}
+	else
+	{
+		size_t probe = (length < capacity * 2) ? length : capacity * 2;
+		size_t i = 0;
+
+		while (i < probe && zimage__hex_value(ptr[i]) >= 0) {++i;}
+
+		if (i == probe && probe > 0)
+		{
+			for (i = 0; i + 1 < probe; i += 2)
+			{
+				output[count++] = (unsigned char)(zimage__hex_value(ptr[i]) * 16 + zimage__hex_value(ptr[i + 1]));
+			}
+
+			return count;
+		}
+	}
+
+	uint32_t bits = 0;
+	int sextets = 0;
+
+	for (; ptr < end && count < capacity; ++ptr)
+	{
+		unsigned char value = zimage__base64_values[*ptr];
+
+		if (value == 64) {continue;}
+		if (value > 64) {break;}
+
+		bits = (bits << 6) | value;
+
+		if (++sextets == 4)
+		{
+			for (int shift = 16; shift >= 0 && count < capacity; shift -= 8) {output[count++] = (unsigned char)(bits >> shift);}
+
+			bits = 0;
+			sextets = 0;
+		}
+	}
+
+	// A partial group still carries whole bytes (two sextets make one, three make two)
+	if (sextets >= 2 && count < capacity) {output[count++] = (unsigned char)(bits >> (sextets * 6 - 8));}
+	if (sextets == 3 && count < capacity) {output[count++] = (unsigned char)(bits >> 2);}
+
+	return count;
+}
+
+#if defined(ZIMAGE_SSSE3)
+
+/*
+	Base64 to bytes 16 (or 32) characters at a time, after Wojciech Muła and Daniel Lemire's
+	"Faster Base64 Encoding and Decoding Using AVX2 Instructions": the high nibble picks a
+	validity mask and an offset that turns each character into its 6-bit value, then two
+	multiply-adds pack four sextets into three bytes.
+*/
+#define ZIMAGE__BASE64_LUT_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define ZIMAGE__BASE64_LUT_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define ZIMAGE__BASE64_ROLL   0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define ZIMAGE__BASE64_PACK   2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+// Decodes whole blocks from input[*i] to output[*o] while they hold nothing but the alphabet
+static void zimage__base64_blocks(const char *input, size_t length, size_t *i, unsigned char *output, size_t *o)
+{
+#if defined(ZIMAGE_AVX2)
+	{
+		const __m256i lut_lo = _mm256_setr_epi8(ZIMAGE__BASE64_LUT_LO, ZIMAGE__BASE64_LUT_LO);
+		const __m256i lut_hi = _mm256_setr_epi8(ZIMAGE__BASE64_LUT_HI, ZIMAGE__BASE64_LUT_HI);
+		const __m256i roll = _mm256_setr_epi8(ZIMAGE__BASE64_ROLL, ZIMAGE__BASE64_ROLL);
+		const __m256i pack = _mm256_setr_epi8(ZIMAGE__BASE64_PACK, ZIMAGE__BASE64_PACK);
+		const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+		// Stores are 32 bytes for 24 decoded ones, so stay clear of the end of <output>
+		while (*i + 48 <= length)
+		{
+			__m256i str = _mm256_loadu_si256((const __m256i *)(input + *i));
+
+			__m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+			__m256i lo_nibbles = _mm256_and_si256(str, mask_2f);
+			__m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+			__m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+
+			if (!_mm256_testz_si256(lo, hi)) {break;}
+
+			__m256i eq_2f = _mm256_cmpeq_epi8(str, mask_2f);
+			str = _mm256_add_epi8(str, _mm256_shuffle_epi8(roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+
+			str = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+			str = _mm256_madd_epi16(str, _mm256_set1_epi32(0x00011000));
+			str = _mm256_shuffle_epi8(str, pack);
+			str = _mm256_permutevar8x32_epi32(str, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+
+			_mm256_storeu_si256((__m256i *)(output + *o), str);
+
+			*i += 32;
+			*o += 24;
+		}
+	}
+#endif
+
+	const __m128i lut_lo = _mm_setr_epi8(ZIMAGE__BASE64_LUT_LO);
+	const __m128i lut_hi = _mm_setr_epi8(ZIMAGE__BASE64_LUT_HI);
+	const __m128i roll = _mm_setr_epi8(ZIMAGE__BASE64_ROLL);
+	const __m128i pack = _mm_setr_epi8(ZIMAGE__BASE64_PACK);
+	const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+	while (*i + 28 <= length)
+	{
+		__m128i str = _mm_loadu_si128((const __m128i *)(input + *i));
+
+		__m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+		__m128i lo_nibbles = _mm_and_si128(str, mask_2f);
+		__m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+		__m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {break;}
+
+		__m128i eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+		str = _mm_add_epi8(str, _mm_shuffle_epi8(roll, _mm_add_epi8(eq_2f, hi_nibbles)));
+
+		str = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+		str = _mm_madd_epi16(str, _mm_set1_epi32(0x00011000));
+		str = _mm_shuffle_epi8(str, pack);
+
+		_mm_storeu_si128((__m128i *)(output + *o), str);
+
+		*i += 16;
+		*o += 12;
+	}
+}
+
+#endif
+
+/*
+size_t decode_base64(char *input, size_t length, unsigned char *output)
+
+returns:
+	> the number of bytes decoded from the <length> characters of base64 at <input> to <output>
+	  (which holds at least length / 4 * 3 + 2 bytes); whitespace is skipped, padding is optional
+	  and the URL-safe alphabet ('-' and '_') is accepted
+	> (size_t)-1 if <input> is not base64
+
+example:
+	> decode_base64("aGVsbG8=", 8, output) -> 5 ("hello")
+*/
+size_t decode_base64(char *input, size_t length, unsigned char *output)
+{
+	if (input == NULL || output == NULL) {return (size_t)-1;}
+
+	size_t i = 0;
+	size_t o = 0;
+	uint32_t bits = 0;
+	int sextets = 0;
+
+	while (i < length)
+	{
+#if defined(ZIMAGE_SSSE3)
+		// Blocks only start on a group boundary; anything they stop at goes through the loop below
+		if (sextets == 0)
+		{
+			zimage__base64_blocks(input, length, &i, output, &o);
+			if (i >= length) {break;}
+		}
+#endif
+
+		unsigned char value = zimage__base64_values[(unsigned char)input[i]];
+
+		if (value == 65) {break;}
+		if (value == 255) {return (size_t)-1;}
+
+		++i;
+
+		if (value == 64) {continue;}
+
+		bits = (bits << 6) | value;
+
+		if (++sextets == 4)
+		{
+			output[o++] = (unsigned char)(bits >> 16);
+			output[o++] = (unsigned char)(bits >> 8);
+			output[o++] = (unsigned char)bits;
+
+			bits = 0;
+			sextets = 0;
+		}
+	}
+
+	// Only padding and whitespace may follow the first '='
+	for (; i < length; ++i)
+	{
+		unsigned char value = zimage__base64_values[(unsigned char)input[i]];
+		if (value != 64 && value != 65) {return (size_t)-1;}
+	}
+
+	if (sextets == 1) {return (size_t)-1;}
+	if (sextets >= 2) {output[o++] = (unsigned char)(bits >> (sextets * 6 - 8));}
+	if (sextets == 3) {output[o++] = (unsigned char)(bits >> 2);}
+
+	return o;
+}
+
+//----------------------------------------------------------------------------------
+// Metadata
+//----------------------------------------------------------------------------------
+
+// Either a buffer already in memory or an open file that is read only where asked
+typedef struct zimage__source
+{
+	const unsigned char *data;
+	size_t length;
+	FILE *file;
+} zimage__source;
+
+// Copies up to <count> bytes from <offset> of <source> to <output>, returning how many there were
+static size_t zimage__read(zimage__source *source, size_t offset, void *output, size_t count)
+{
+	if (source->file == NULL)
+	{
+		if (offset >= source->length) {return 0;}
+		if (count > source->length - offset) {count = source->length - offset;}
+
+		memcpy(output, source->data + offset, count);
+		return count;
+	}
+
+	if (offset > LONG_MAX || fseek(source->file, (long)offset, SEEK_SET) != 0) {return 0;}
+
+	return fread(output, 1, count, source->file);
+}
+
+#if defined(ZIMAGE_SSSE3) || defined(ZIMAGE_AVX2)
+
+static unsigned int zimage__ctz(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (unsigned int)__builtin_ctz(x);
+#else
+	unsigned int n = 0;
+	while ((x & 1) == 0) {x >>= 1; ++n;}
+	return n;
+#endif
+}
+
+#endif
+
+// Index of the first 0xFF in <data>, or <length> if there is none
+static size_t zimage__find_ff(const unsigned char *data, size_t length)
+{
+	size_t i = 0;
+
+#if defined(ZIMAGE_AVX2)
+	const __m256i ff_32 = _mm256_set1_epi8((char)0xFF);
+
+	for (; i + 32 <= length; i += 32)
+	{
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), ff_32));
+		if (mask) {return i + zimage__ctz(mask);}
+	}
+#endif
+
+#if defined(ZIMAGE_SSSE3)
+	const __m128i ff_16 = _mm_set1_epi8((char)0xFF);
+
+	for (; i + 16 <= length; i += 16)
+	{
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), ff_16));
+		if (mask) {return i + zimage__ctz(mask);}
+	}
+#endif
+
+	for (; i < length; ++i)
+	{
+		if (data[i] == 0xFF) {return i;}
+	}
+
+	return length;
+}
+
+// Offset of the first 0xFF at or after <offset>, or (size_t)-1 if there is none
+static size_t zimage__next_ff(zimage__source *source, size_t offset)
+{
+	if (source->file == NULL)
+	{
+		if (offset >= source->length) {return (size_t)-1;}
+
+		size_t i = zimage__find_ff(source->data + offset, source->length - offset);
+		return (offset + i < source->length) ? offset + i : (size_t)-1;
+	}
+
+	unsigned char window[4096];
+
+	for (;;)
+	{
+		size_t count = zimage__read(source, offset, window, sizeof(window));
+		if (count == 0) {return (size_t)-1;}
+
+		size_t i = zimage__find_ff(window, count);
+		if (i < count) {return offset + i;}
+
+		offset += count;
+	}
+}
+
+static ImageBlock zimage__block(size_t offset, size_t length)
+{
+	ImageBlock block = {offset, length};
+	return block;
+}
+
+static uint32_t zimage__u16(const unsigned char *ptr, bool little)
+{
+	return little ? (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) : ((uint32_t)ptr[0] << 8) | (uint32_t)ptr[1];
+}
+
+static uint32_t zimage__u32(const unsigned char *ptr, bool little)
+{
+	return little ? zimage__u16(ptr, true) | (zimage__u16(ptr + 2, true) << 16) : (zimage__u16(ptr, false) << 16) | zimage__u16(ptr + 2, false);
+}
+
+// The orientation tag (0x0112) of IFD0 in the TIFF data of <exif>, 0 if it has none
+static int zimage__exif_orientation(zimage__source *source, ImageBlock exif)
+{
+	unsigned char tiff[8];
+	if (exif.length < 8 || zimage__read(source, exif.offset, tiff, 8) != 8) {return 0;}
+
+	bool little = (tiff[0] == 'I' && tiff[1] == 'I');
+	if (!little && !(tiff[0] == 'M' && tiff[1] == 'M')) {return 0;}
+
+	size_t ifd = zimage__u32(tiff + 4, little);
+	if (ifd < 8 || ifd > exif.length - 2) {return 0;}
+
+	unsigned char entries[16 * 12];
+	if (zimage__read(source, exif.offset + ifd, entries, 2) != 2) {return 0;}
+
+	size_t count = zimage__u16(entries, little);
+	size_t available = (exif.length - ifd - 2) / 12;
+	if (count > available) {count = available;}
+
+	// Entries are read sixteen at a time, rather than with a read each
+	for (size_t i = 0; i < count; i += 16)
+	{
+		size_t batch = (count - i < 16) ? count - i : 16;
+		if (zimage__read(source, exif.offset + ifd + 2 + i * 12, entries, batch * 12) != batch * 12) {return 0;}
+
+		for (size_t e = 0; e < batch; ++e)
+		{
+			const unsigned char *entry = entries + e * 12;
+			if (zimage__u16(entry, little) != 0x0112) {continue;}
+
+			int orientation = (int)zimage__u16(entry + 8, little);
+			return (orientation >= 1 && orientation <= 8) ? orientation : 0;
+		}
+	}
+
+	return 0;
+}
+
+static void zimage__jpeg_metadata(zimage__source *source, ImageMetadata *metadata)
+{
+	unsigned char head[32];
+	size_t offset = 2;
+
+	for (;;)
+	{
+		size_t count = zimage__read(source, offset, head, 4);
+		if (count < 2) {return;}
+
+		// Not on a marker, so skip whatever is in the way to the next 0xFF
+		if (head[0] != 0xFF)
+		{
+			if ((offset = zimage__next_ff(source, offset)) == (size_t)-1) {return;}
+			continue;
+		}
+
+		unsigned char marker = head[1];
+
+		if (marker == 0xFF) {++offset; continue;}              // fill byte
+		if (marker == 0xDA || marker == 0xD9) {return;}        // scan data or the end, nothing more to find
+		if (marker == 0x00 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {offset += 2; continue;}
+
+		if (count < 4) {return;}
+
+		size_t length = zimage__u16(head + 2, false);
+		if (length < 2) {return;}
+
+		size_t data = offset + 4;
+		size_t size = length - 2;
+
+		if (marker == 0xE1 || marker == 0xE2)
+		{
+			size_t read = zimage__read(source, data, head, (size < sizeof(head)) ? size : sizeof(head));
+
+			if (marker == 0xE1 && read >= 6 && memcmp(head, "Exif\0\0", 6) == 0 && metadata->exif.length == 0)
+			{
+				metadata->exif = zimage__block(data + 6, size - 6);
+			}
+			else if (marker == 0xE1 && read >= 29 && memcmp(head, "http://ns.adobe.com/xap/1.0/", 29) == 0 && metadata->xmp.length == 0)
+			{
+				metadata->xmp = zimage__block(data + 29, size - 29);
+			}
+			else if (marker == 0xE2 && read >= 14 && memcmp(head, "ICC_PROFILE", 12) == 0 && metadata->icc.length == 0)
+			{
+				metadata->icc = zimage__block(data + 14, size - 14);
+			}
+		}
+
+		offset = data + size;
+	}
+}
+
+// Keyword and fields of a tEXt, zTXt or iTXt chunk of <length> bytes at <data>
+static void zimage__png_text(zimage__source *source, const unsigned char *type, size_t data, size_t length, ImageMetadata *metadata)
+{
+	unsigned char head[256];
+	size_t read = zimage__read(source, data, head, (length < sizeof(head)) ? length : sizeof(head));
+
+	const unsigned char *nul = (const unsigned char *)memchr(head, 0, (read < 80) ? read : 80);
+	if (nul == NULL || nul == head) {return;}
+
+	size_t skip = (size_t)(nul - head) + 1;
+	bool compressed = false;
+
+	if (memcmp(type, "zTXt", 4) == 0) {++skip;}
+	else if (memcmp(type, "iTXt", 4) == 0)
+	{
+		// Compression flag and method, then a language tag and a translated keyword
+		if (skip + 2 > read) {return;}
+
+		compressed = (head[skip] != 0);
+		skip += 2;
+
+		for (int field = 0; field < 2; ++field)
+		{
+			nul = (const unsigned char *)memchr(head + skip, 0, read - skip);
+			if (nul == NULL) {return;}
+
+			skip = (size_t)(nul - head) + 1;
+		}
+	}
+
+	if (skip > length) {return;}
+
+	ImageBlock text = zimage__block(data + skip, length - skip);
+
+	if (memcmp(type, "iTXt", 4) == 0 && !compressed && strcmp((const char *)head, "XML:com.adobe.xmp") == 0 && metadata->xmp.length == 0)
+	{
+		metadata->xmp = text;
+	}
+
+	if (metadata->text_count < ZIMAGE_TEXT_CHUNKS)
+	{
+		ImageText *entry = &metadata->texts[metadata->text_count];
+
+		memcpy(entry->type, type, 4);
+		entry->type[4] = '\0';
+		memcpy(entry->keyword, head, (size_t)(strchr((const char *)head, '\0') - (const char *)head) + 1);
+		entry->text = text;
+	}
+
+	++metadata->text_count;
+}
+
+static void zimage__png_metadata(zimage__source *source, ImageMetadata *metadata)
+{
+	unsigned char head[81];
+	size_t offset = 8;
+
+	// Chunk headers only: the length field says where the next one is, the data is never read
+	while (zimage__read(source, offset, head, 8) == 8)
+	{
+		size_t length = zimage__u32(head, false);
+		if (length > 0x7FFFFFFF) {return;}
+
+		unsigned char type[4];
+		memcpy(type, head + 4, 4);
+
+		size_t data = offset + 8;
+
+		if (memcmp(type, "IEND", 4) == 0) {return;}
+
+		if (memcmp(type, "eXIf", 4) == 0 && metadata->exif.length == 0)
+		{
+			metadata->exif = zimage__block(data, length);
+		}
+		else if (memcmp(type, "iCCP", 4) == 0 && metadata->icc.length == 0)
+		{
+			// Profile name, compression method, then the zlib stream
+			size_t read = zimage__read(source, data, head, (length < sizeof(head)) ? length : sizeof(head));
+			const unsigned char *nul = (const unsigned char *)memchr(head, 0, read);
+
+			if (nul != NULL && (size_t)(nul - head) + 2 <= length)
+			{
+				size_t skip = (size_t)(nul - head) + 2;
+				metadata->icc = zimage__block(data + skip, length - skip);
+			}
+		}
+		else if (memcmp(type, "tEXt", 4) == 0 || memcmp(type, "zTXt", 4) == 0 || memcmp(type, "iTXt", 4) == 0)
+		{
+			zimage__png_text(source, type, data, length, metadata);
+		}
+
+		offset = data + length + 4;
+	}
+}
+
+static bool zimage__metadata(zimage__source *source, ImageMetadata *metadata)
+{
+	memset(metadata, 0, sizeof(ImageMetadata));
+
+	unsigned char head[ZIMAGE_PROBE_BYTES];
+	size_t length = zimage__read(source, 0, head, sizeof(head));
+
+	if (has_header_data(head, length, HEADER_JPG)) {zimage__jpeg_metadata(source, metadata);}
+	else if (has_header_data(head, length, HEADER_PNG)) {zimage__png_metadata(source, metadata);}
+	else {return false;}
+
+	metadata->orientation = zimage__exif_orientation(source, metadata->exif);
+
+	return true;
+}
+
+/*
+bool read_image_metadata(char *filename, ImageMetadata *metadata)
+
+returns:
+	> true if <filename> is a JPEG or PNG, with <metadata> filled in by walking its marker
+	  segments or chunks: only their headers and the first bytes of those that can hold
+	  metadata are read, by seeking past everything else, so the image data is never touched
+	> false if it can not be opened or is neither
+
+example:
+	> read_image_metadata("photo.jpg", &metadata) -> true (metadata.orientation == 6, metadata.icc.length != 0)
+*/
+bool read_image_metadata(char *filename, ImageMetadata *metadata)
+{
+	if (filename == NULL || metadata == NULL) {return false;}
+
+	FILE *fp = fopen(filename, "rb");
+	if (fp == NULL) {return false;}
+
+	zimage__source source = {NULL, 0, fp};
+	bool result = zimage__metadata(&source, metadata);
+
+	fclose(fp);
+	return result;
+}
+
+/*
+bool read_image_metadata_data(const unsigned char *data, size_t length, ImageMetadata *metadata)
+
+returns:
+	> read_image_metadata() on the <length> bytes at <data>, such as an mmap()ed file, of
+	  which only the pages holding the headers and metadata are then read
+
+example:
+	> read_image_metadata_data(mapped, size, &metadata) -> true (metadata.text_count == 2)
+*/
+bool read_image_metadata_data(const unsigned char *data, size_t length, ImageMetadata *metadata)
+{
+	if (data == NULL || metadata == NULL) {return false;}
+
+	zimage__source source = {data, length, NULL};
+
+	return zimage__metadata(&source, metadata);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,17 +5,160 @@
 #ifndef ZSTRING_H
 #define ZSTRING_H
 
-#include <stdio.h>      // vsprintf()
+#include <stdio.h>      // snprintf()
 #include <ctype.h>      // toupper(), tolower()
 #include <stdlib.h>     // malloc(), free()
 #include <string.h>     // strlen(), strstr(), strncmp(), memcpy()
 #include <stdarg.h>     // va_list(), va_start(), va_end()
 #include <stdbool.h>    // true, false
+#include <stddef.h>     // size_t, ptrdiff_t
+#include <stdint.h>     // uint64_t, intmax_t
+#include <wchar.h>      // wint_t, wchar_t
+#include <time.h>       // timespec_get(), time()
+
+#if !defined(ZSTRING_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define ZSTRING_SSE2
+    #include <emmintrin.h>  // _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#endif
+
+#if !defined(ZSTRING_NO_SIMD) && defined(__SSSE3__)
+    #define ZSTRING_SSSE3
+    #include <tmmintrin.h>  // _mm_shuffle_epi8(), _mm_alignr_epi8()
+#endif
+
+#if !defined(ZSTRING_NO_SIMD) && defined(__AVX2__)
+    #define ZSTRING_AVX2
+    #include <immintrin.h>  // _mm256_shuffle_epi8(), _mm256_permute4x64_epi64()
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>     // _InterlockedExchangeAdd64()
+#endif
+
+#if !defined(ZSTRING_NO_SIMD) && defined(__PCLMUL__) && defined(__x86_64__)
+    #define ZSTRING_PCLMUL
+    #include <wmmintrin.h>  // _mm_clmulepi64_si128()
+#endif
+
+#if defined(ZSTRING_THREADS)
+    #include <pthread.h>    // pthread_create(), pthread_join()
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//----------------------------------------------------------------------------
+// ZString Types
+//----------------------------------------------------------------------------
+
+// Read-only view into another string, not NUL terminated; data is NULL if there is nothing to view
+typedef struct StringSpan
+{
+    char *data;
+    size_t length;
+} StringSpan;
+
+// Column of strings in one contiguous buffer (Arrow-style offsets),
+// string <i> is data[offsets[i]] up to data[offsets[i + 1]] and is not NUL terminated
+typedef struct StringColumn
+{
+    char *data;
+    size_t *offsets;    // count + 1 entries
+    size_t count;
+} StringColumn;
+
+// Iterator over the lines of a buffer, see string_lines()
+typedef struct StringLines
+{
+    char *data;
+    size_t length;
+    size_t pos;
+} StringLines;
+
+// Field boundaries of a CSV/TSV stream, see string_csv_parse() and string_csv_feed()
+typedef struct StringCsv
+{
+    size_t *ends;       // stream offset of the delimiter or '\n' ending each field
+    size_t count;
+    size_t capacity;
+
+    size_t start;       // stream offset where field 0 starts
+    size_t consumed;    // bytes fed so far
+    uint64_t in_quotes; // all ones while the stream is inside a quoted field
+    bool open;          // the stream ended in the middle of a row
+    char delimiter;
+} StringCsv;
+
+// Suffix array over a copy of a text, see string_index_build()
+typedef struct StringIndex
+{
+    char *text;             // NUL terminated copy of the indexed buffer
+    size_t length;
+    int32_t *suffixes;      // start of every suffix of text, in sorted order
+
+    int32_t *sorted;        // positions of the last range of suffixes string_index_find_nth() sorted
+    size_t sorted_first;    // that range
+    size_t sorted_count;
+} StringIndex;
+
+// Chain of transforms run as one streaming pass, see string_pipeline_create()
+typedef struct StringPipeline StringPipeline;
+
+// One distinct key of a StringCounts and how often it occurred
+typedef struct StringCount
+{
+    StringSpan key;         // points into the counted buffer
+    size_t count;
+} StringCount;
+
+// Frequency table (open addressing) of the keys of one buffer, which must outlive it
+typedef struct StringCounts
+{
+    uint64_t *hashes;       // 0 in empty slots
+    StringCount *slots;
+    size_t capacity;        // power of two
+    size_t length;          // distinct keys
+    size_t total;           // keys counted
+} StringCounts;
+
+// What one worker of string_pipeline_run_files() did
+typedef struct StringBatchWorker
+{
+    size_t files;           // files written
+    size_t failed;          // files that could not be read or written
+    size_t bytes_read;
+    size_t bytes_written;
+    double seconds;         // busy time
+} StringBatchWorker;
+
+// Allocations made by one ZString function, see string_allocations()
+typedef struct StringAllocations
+{
+    const char *function;
+    size_t live;            // blocks not freed yet
+    size_t live_bytes;
+    size_t peak_bytes;      // the most live bytes there have been at once
+    size_t total;           // blocks ever allocated
+} StringAllocations;
+
+// Glob or regex compiled to a DFA, see string_pattern_compile()
+typedef struct StringPattern StringPattern;
+
+typedef enum StringPatternSyntax
+{
+    STRING_PATTERN_GLOB,    // * ? [a-z] [!a-z] \x
+    STRING_PATTERN_REGEX    // . [a-z] [^a-z] \d \w \s ( | ) * + ? and a leading ^ / trailing $
+} StringPatternSyntax;
+
+typedef enum StringEscape
+{
+    STRING_ESCAPE_JSON,     // \" \\ \b \f \n \r \t \u00XX
+    STRING_ESCAPE_HTML,     // &amp; &lt; &gt; &quot; &#39;
+    STRING_ESCAPE_URL,      // %XX for everything but A-Z a-z 0-9 - . _ ~
+    STRING_ESCAPE_C         // \" \\ \a \b \f \n \r \t \v \ooo
+} StringEscape;
+
 //----------------------------------------------------------------------------
 // ZString Function Declarations
 //----------------------------------------------------------------------------
@@ -35,12 +178,112 @@ bool string_contains(char *str, char *substr);
 bool string_starts_with(char *str, char *substr);
 bool string_ends_with(char *str, char *substr);
 
+// --- Patterns --- //
+bool string_pattern_match(StringPattern *pattern, char *str);
+int string_pattern_find(StringPattern *pattern, char *str, unsigned int *length);
+unsigned int string_pattern_count(StringPattern *pattern, char *str);
+
+StringPattern *string_pattern_cached(char *pattern, StringPatternSyntax syntax);
+void string_pattern_cache_clear(void);
+
+// --- Case-Insensitive --- //
+int string_find_ci(char *str, char *substr);
+unsigned int string_count_ci(char *str, char *substr);
+bool string_contains_ci(char *str, char *substr);
+bool string_starts_with_ci(char *str, char *substr);
+bool string_ends_with_ci(char *str, char *substr);
+
+// --- Number Formatting --- //
+unsigned int string_write_int(char *buffer, long long value);
+unsigned int string_write_uint(char *buffer, unsigned long long value);
+unsigned int string_write_double(char *buffer, double value);
+
+void string_format_release(void);
+
+// --- Number Parsing --- //
+size_t string_parse_i64(char *buffer, size_t length, int64_t *value);
+size_t string_parse_u64(char *buffer, size_t length, uint64_t *value);
+size_t string_parse_f64(char *buffer, size_t length, double *value);
+
+// --- In-Place --- //
+char *string_reverse_in_place(char *str);
+char *string_shift_left_in_place(char *str, unsigned int amount);
+char *string_shift_right_in_place(char *str, unsigned int amount);
+
+// --- UTF-8 --- //
+bool string_utf8_valid(char *str);
+unsigned int string_utf8_length(char *str);
+
+// --- Spans --- //
+StringSpan string_span(char *str);
+StringSpan string_span_slice(char *str, unsigned int start, unsigned int end);
+StringSpan string_span_cut_left(char *str, unsigned int amount);
+StringSpan string_span_cut_right(char *str, unsigned int amount);
+StringSpan string_span_trim_left(char *str, char *substr);
+StringSpan string_span_trim_right(char *str, char *substr);
+StringSpan string_span_before(char *str, char *substr);
+StringSpan string_span_after(char *str, char *substr);
+StringSpan string_span_between(char *str, char *a, char *b);
+
+bool string_span_equals(StringSpan span, char *str);
+
+// --- Approximate Matching --- //
+unsigned int string_edit_distance(char *a, char *b);
+void string_edit_distance_batch(char *query, char **candidates, size_t count, unsigned int *distances);
+int string_find_k(char *str, char *pattern, unsigned int k, unsigned int *length);
+
+// --- Sorting --- //
+void string_sort(char **strings, size_t count);
+void string_sort_parallel(char **strings, size_t count, unsigned int threads);
+size_t string_unique(char **strings, size_t count);
+
+// --- Frequency Queries --- //
+size_t string_counts_get(StringCounts *counts, char *key, size_t length);
+size_t string_counts_top(StringCounts *counts, size_t k, StringCount *output);
+
+// --- Index Queries --- //
+unsigned int string_index_count(StringIndex *index, char *substr);
+int string_index_find(StringIndex *index, char *substr);
+int string_index_find_nth(StringIndex *index, char *substr, unsigned int nth);
+
+// --- Pipeline Batches --- //
+size_t string_pipeline_run_files(StringPipeline *pipeline, char **inputs, char **outputs, size_t count, unsigned int threads, StringBatchWorker *workers);
+
+// --- Lines --- //
+StringLines string_lines(char *buffer, size_t length);
+bool string_lines_next(StringLines *lines, StringSpan *line);
+size_t string_count_lines(char *buffer, size_t length);
+
+// --- CSV --- //
+StringCsv string_csv_init(char delimiter);
+void string_csv_feed(StringCsv *csv, char *chunk, size_t length);
+bool string_csv_finish(StringCsv *csv);
+void string_csv_clear(StringCsv *csv);
+
+StringSpan string_csv_field(StringCsv *csv, char *stream, size_t index);
+bool string_csv_row_end(StringCsv *csv, char *stream, size_t index);
+
+// --- Large Buffers --- //
+ptrdiff_t string_buffer_find(char *buffer, size_t length, char *substr);
+ptrdiff_t string_buffer_find_nth(char *buffer, size_t length, char *substr, size_t nth);
+size_t string_buffer_count(char *buffer, size_t length, char *substr);
+size_t string_buffer_count_overlap(char *buffer, size_t length, char *substr);
+
+// --- Allocation Tracking (ZSTRING_TRACK_ALLOCATIONS) --- //
+void string_free(void *ptr);
+size_t string_allocations(StringAllocations *output, size_t capacity);
+void string_allocations_dump(FILE *stream);
+
 //----------------------------------------------------------------------------
 // Functions that require "free()"
 //----------------------------------------------------------------------------
 
 // --- Formatting --- //
 char *string_format(char *str, ...);
+char *string_vformat(char *str, va_list args);
+
+char *string_from_int(long long value);
+char *string_from_double(double value);
 
 // --- Slicing --- //
 char *string_slice(char *str, unsigned int start, unsigned int end);
@@ -83,6 +326,101 @@ char *string_before(char *str, char *substr);
 char *string_after(char *str, char *substr);
 char *string_between(char *str, char *a, char *b);
 
+// --- UTF-8 Slicing --- //
+char *string_utf8_slice(char *str, unsigned int start, unsigned int end);
+char *string_utf8_cut_left(char *str, unsigned int amount);
+char *string_utf8_cut_right(char *str, unsigned int amount);
+char *string_utf8_shift_left(char *str, unsigned int amount);
+char *string_utf8_shift_right(char *str, unsigned int amount);
+char *string_utf8_reverse(char *str);
+
+// --- Set/Substring Splitting --- //
+char **string_split_any(char *str, char *delimiters, bool skip_empty);
+char **string_split_substr(char *str, char *delimiter);
+
+// --- Span Copying --- //
+char *string_span_copy(StringSpan span);
+
+// --- Case-Insensitive Replacing/Splitting --- //
+char *string_replace_all_ci(char *str, char *substr, char *replacement);
+char **string_split_substr_ci(char *str, char *delimiter);
+
+// --- CSV Parsing --- //
+StringCsv string_csv_parse(char *buffer, size_t length, char delimiter);
+char *string_csv_unquote(StringSpan field);
+char **string_csv_split(char *str, char delimiter);
+void string_csv_free(StringCsv *csv);
+
+// --- Frequency Counting --- //
+StringCounts string_count_ngrams(char *buffer, size_t length, size_t n, unsigned int threads);
+StringCounts string_count_tokens(char *buffer, size_t length, char *delimiters, unsigned int threads);
+void string_counts_free(StringCounts *counts);
+
+// --- Index Building --- //
+StringIndex string_index_build(char *buffer, size_t length);
+void string_index_free(StringIndex *index);
+
+// --- Pipelines --- //
+StringPipeline *string_pipeline_create(void);
+StringPipeline *string_pipeline_trim_left(StringPipeline *pipeline, char *substr);
+StringPipeline *string_pipeline_trim_right(StringPipeline *pipeline, char *substr);
+StringPipeline *string_pipeline_upper(StringPipeline *pipeline);
+StringPipeline *string_pipeline_lower(StringPipeline *pipeline);
+StringPipeline *string_pipeline_replace_all(StringPipeline *pipeline, char *substr, char *replacement);
+StringPipeline *string_pipeline_remove_all(StringPipeline *pipeline, char *substr);
+char *string_pipeline_run(StringPipeline *pipeline, char *str);
+void string_pipeline_free(StringPipeline *pipeline);
+
+// --- Refcounted Strings (release with string_ref_release()) --- //
+char *string_ref_new(char *str);
+char *string_ref_format(char *str, ...);
+
+char *string_ref_retain(char *ref);
+void string_ref_release(char *ref);
+char *string_ref_mutable(char *ref);
+
+size_t string_ref_length(char *ref);
+size_t string_ref_count(char *ref);
+
+char *string_ref_trim_left(char *ref, char *substr);
+char *string_ref_trim_right(char *ref, char *substr);
+char *string_ref_remove(char *ref, char *substr);
+char *string_ref_remove_all(char *ref, char *substr);
+char *string_ref_replace(char *ref, char *substr, char *replacement);
+char *string_ref_replace_all(char *ref, char *substr, char *replacement);
+char *string_ref_shift_left(char *ref, unsigned int amount);
+char *string_ref_shift_right(char *ref, unsigned int amount);
+char *string_ref_upper(char *ref);
+char *string_ref_lower(char *ref);
+
+// --- Pattern Compiling/Replacing --- //
+StringPattern *string_pattern_compile(char *pattern, StringPatternSyntax syntax);
+char *string_pattern_replace_all(StringPattern *pattern, char *str, char *replacement);
+void string_pattern_free(StringPattern *pattern);
+
+// --- Escaping --- //
+char *string_escape(char *str, StringEscape kind);
+char *string_unescape(char *str, StringEscape kind);
+
+// --- Large Buffer Editing --- //
+char *string_buffer_replace_all(char *buffer, size_t length, char *substr, char *replacement, size_t *length_output);
+char *string_buffer_remove_all(char *buffer, size_t length, char *substr, size_t *length_output);
+char *string_buffer_reverse(char *buffer, size_t length);
+
+// --- Columns --- //
+StringColumn string_column_from_array(char **strings, size_t count);
+StringColumn string_column_upper(StringColumn column);
+StringColumn string_column_lower(StringColumn column);
+StringColumn string_column_trim_left(StringColumn column, char *substr);
+StringColumn string_column_trim_right(StringColumn column, char *substr);
+StringColumn string_column_replace_all(StringColumn column, char *substr, char *replacement);
+StringColumn string_column_remove_all(StringColumn column, char *substr);
+void string_column_free(StringColumn *column);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // ZSTRING_H
 
 //----------------------------------------------------------------------------
@@ -91,1095 +429,10364 @@ char *string_between(char *str, char *a, char *b);
 
 #ifdef ZSTRING_IMPLEMENTATION
 
-//----------------|
-// Location Index |
-//----------------|
+#if !defined(_WIN32)
+    #include <sys/stat.h>   // stat(), chmod()
+#endif
 
-/*
-int string_find(char *str, char *substr)
+#if defined(__linux__)
+    #include <sys/mman.h>   // madvise()
+#endif
 
-returns:
-    > position of the first occurence of <substr> in <str>
-    > -1 if <substr> wasn't found
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-example:
-    > string_find("Foo Bar Foo Bar", "Foo") -> 0
-                   ^
-    > string_find("Bar Foo Bar Foo", "Foo") -> 4
-                       ^
+#if defined(_MSC_VER)
+    #define STRING__THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+    #define STRING__THREAD_LOCAL _Thread_local
+#else
+    #define STRING__THREAD_LOCAL __thread
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STRING__ATOMIC_ADD(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_ACQ_REL)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    #define STRING__ATOMIC_ADD(ptr, value) ((size_t)_InterlockedExchangeAdd64((volatile long long *)(ptr), (long long)(value)) + (value))
+#else
+    #define STRING__ATOMIC_ADD(ptr, value) (*(ptr) += (value))
+#endif
+
+//---------------------|
+// Allocation Tracking |
+//---------------------|
+
+/*
+    With ZSTRING_TRACK_ALLOCATIONS defined, every malloc(), calloc(), realloc() and free() below
+    goes through these, which note each live block in a table of their own. A block is booked to
+    the outermost public function being run on the thread (marked with STRING__TRACK_PUBLIC()),
+    so the helpers, other public functions and workers it uses don't show up on their own.
+    Results come off the books through string_free(); one handed to plain free() stays on them
+    until its address is reused by ZString.
+
+    The table is split into shards by address, each with its own lock, and the counters of each
+    function are updated atomically, so threads allocating at the same time rarely wait on each other.
 */
-int string_find(char *str, char *substr) 
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define STRING__LOCK(flag) while (__atomic_test_and_set((flag), __ATOMIC_ACQUIRE)) {}
+    #define STRING__UNLOCK(flag) __atomic_clear((flag), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+    #define STRING__LOCK(flag) while (_InterlockedExchange8((volatile char *)(flag), 1)) {}
+    #define STRING__UNLOCK(flag) _InterlockedExchange8((volatile char *)(flag), 0)
+#else
+    #define STRING__LOCK(flag)
+    #define STRING__UNLOCK(flag)
+#endif
+
+// More than there are functions in ZString that allocate
+#define STRING__TRACK_FUNCTIONS 512
+
+// Power of two
+#define STRING__TRACK_SHARDS 64
+
+typedef struct string__track_block
 {
-    if (!str || !substr) {return -1;}
+    void *ptr;              // NULL in empty slots
+    size_t size;
+    size_t sequence;        // order of creation
+    StringAllocations *owner;
+} string__track_block;
+
+// Live blocks whose address hashes to this shard
+typedef struct string__track_shard
+{
+    string__track_block *blocks;    // open addressing on <ptr>
+    size_t capacity;                // power of two
+    size_t length;
+    volatile char lock;
+    char padding[64 - 3 * sizeof(size_t) - 1];  // one cache line each, so that shards in use by different threads don't share one
+} string__track_shard;
+
+typedef struct string__tracker
+{
+    string__track_shard shards[STRING__TRACK_SHARDS];
 
-    size_t length_str = strlen(str);
-    int pos = -1;
+    size_t sequence;
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t invalid_frees;
+    size_t failed;          // no memory for a table, so nothing is tracked any more
 
-    if (length_str > 0)
-    {
-        const char *ptr = str;
+    StringAllocations functions[STRING__TRACK_FUNCTIONS];   // open addressing on the <function> pointer, never removed
+} string__tracker;
 
-        ptr = strstr(ptr, substr);
-    
-        if (ptr != NULL)
-        {
-            pos = ptr - str;
-        }
-    }
+static string__tracker string__track;
 
-    return pos;
+// Outermost public function being run on this thread, NULL outside of them
+static STRING__THREAD_LOCAL const char *string__track_caller;
+
+static inline const char *string__track_enter(const char *function)
+{
+    const char *outer = string__track_caller;
+    if (outer == NULL) {string__track_caller = function;}
+
+    return outer;
 }
 
-/*
-int string_find_nth(char *str, char *substr, unsigned int count)
+static inline void string__track_leave(const char **outer)
+{
+    string__track_caller = *outer;
+}
 
-returns:
-    > position of nth <count> occurence of <substr> in <str>
-    > -1 if <substr> wasn't found
-    > -1 if <str>, <substr> or <count> are invalid  
+// Needs the cleanup attribute to leave on every return, without it blocks stay with the function allocating them
+#if defined(__GNUC__) || defined(__clang__)
+    #define STRING__TRACK_PUBLIC() const char *string__track_outer __attribute__((cleanup(string__track_leave))) = string__track_enter(__func__)
+#endif
 
-example:
-    > string_find_nth("Foo Bar Foo Bar", "Foo", 2) -> 8
-                               ^
-*/
-int string_find_nth(char *str, char *substr, unsigned int count)
+// The public function being run, or <function> (the one allocating) outside of any
+static inline const char *string__track_owner(const char *function)
 {
-    if (!str || !substr || count == 0) {return -1;}
-    
-    size_t length_str = strlen(str);
-    int pos = -1;
+    return string__track_caller ? string__track_caller : function;
+}
 
-    if (length_str > 0)
+static inline uint64_t string__track_hash(const void *ptr)
+{
+    return ((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL;
+}
+
+// Slots from the middle bits of the hash, shards from the top ones, so that a shard's blocks still spread over its table
+static inline size_t string__track_slot(const void *ptr, size_t mask)
+{
+    return (size_t)(string__track_hash(ptr) >> 32) & mask;
+}
+
+static inline string__track_shard *string__track_shard_of(const void *ptr)
+{
+    return &string__track.shards[string__track_hash(ptr) >> 58 & (STRING__TRACK_SHARDS - 1)];
+}
+
+// <value> if it is more than *<ptr>, compared and swapped so that no bigger value is lost
+static inline void string__track_max(size_t *ptr, size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    size_t seen = __atomic_load_n(ptr, __ATOMIC_RELAXED);
+    while (seen < value && !__atomic_compare_exchange_n(ptr, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    long long seen = *(volatile long long *)ptr;
+    while ((size_t)seen < value)
     {
-        const char *ptr = str;
+        long long before = _InterlockedCompareExchange64((volatile long long *)ptr, (long long)value, seen);
+        if (before == seen) {break;}
+        seen = before;
+    }
+#else
+    if (*ptr < value) {*ptr = value;}
+#endif
+}
 
-        for (int i = 0; i < count; ++i) 
-        {
-            ptr = strstr(ptr, substr);
-    
-            if (ptr == NULL)
-            {
-                break;
-            } 
+// Counters of <function>, claimed lock-free on its first allocation
+static StringAllocations *string__track_function(const char *function)
+{
+    size_t mask = STRING__TRACK_FUNCTIONS - 1;
 
-            pos = (ptr - str);
-            ++ptr;
-        }
+    for (size_t i = string__track_slot(function, mask);; i = (i + 1) & mask)
+    {
+        StringAllocations *entry = &string__track.functions[i];
+
+#if defined(__GNUC__) || defined(__clang__)
+        const char *seen = __atomic_load_n(&entry->function, __ATOMIC_ACQUIRE);
+        if (seen == NULL && __atomic_compare_exchange_n(&entry->function, &seen, function, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {return entry;}
+#elif defined(_MSC_VER)
+        const char *seen = (const char *)_InterlockedCompareExchangePointer((void *volatile *)&entry->function, (void *)function, NULL);
+        if (seen == NULL) {return entry;}
+#else
+        const char *seen = entry->function;
+        if (seen == NULL) {entry->function = function; return entry;}
+#endif
+
+        if (seen == function) {return entry;}
     }
+}
 
-    return pos;
+static void string__track_book(StringAllocations *owner, size_t size)
+{
+    STRING__ATOMIC_ADD(&owner->live, 1);
+    STRING__ATOMIC_ADD(&owner->total, 1);
+    string__track_max(&owner->peak_bytes, STRING__ATOMIC_ADD(&owner->live_bytes, size));
+    string__track_max(&string__track.peak_bytes, STRING__ATOMIC_ADD(&string__track.live_bytes, size));
 }
 
-//----------|
-// Counting |
-//----------|
+static void string__track_unbook(StringAllocations *owner, size_t size)
+{
+    STRING__ATOMIC_ADD(&owner->live, (size_t)-1);
+    STRING__ATOMIC_ADD(&owner->live_bytes, (size_t)0 - size);
+    STRING__ATOMIC_ADD(&string__track.live_bytes, (size_t)0 - size);
+}
 
-/*
-unsigned int string_count(char *str, char *substr)
+// Puts <ptr> on the books of <shard>, which is locked
+static void string__track_insert(string__track_shard *shard, void *ptr, size_t size, StringAllocations *owner, size_t sequence)
+{
+    if (STRING__ATOMIC_ADD(&string__track.failed, 0)) {return;}
 
-returns:
-    > the amount of times <substr> occurs in <str>
+    if (shard->length * 2 >= shard->capacity)
+    {
+        size_t capacity = shard->capacity ? shard->capacity * 2 : 64;
+        string__track_block *blocks = calloc(capacity, sizeof(string__track_block));
 
-example:
-    > string_count("Fooo Foo", "oo") -> 2
-                     ^    ^
-*/
-unsigned int string_count(char *str, char *substr)
-{
-    if (!str || !substr) {return 0;}
+        // An incomplete table would report false leaks and invalid frees, so stop instead
+        if (blocks == NULL)
+        {
+            STRING__ATOMIC_ADD(&string__track.failed, 1);
+            return;
+        }
 
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+        for (size_t i = 0; i < shard->capacity; ++i)
+        {
+            string__track_block *block = &shard->blocks[i];
+            if (block->ptr == NULL) {continue;}
 
-    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+            size_t slot = string__track_slot(block->ptr, capacity - 1);
+            while (blocks[slot].ptr) {slot = (slot + 1) & (capacity - 1);}
 
-    char *ptr = str;
-    unsigned int count = 0;
+            blocks[slot] = *block;
+        }
 
-    while (ptr = strstr(ptr, substr)) 
-    {
-        ptr += length_sub;
-        ++count;
+        free(shard->blocks);
+        shard->blocks = blocks;
+        shard->capacity = capacity;
     }
 
-    return count;
-}
+    size_t mask = shard->capacity - 1;
+    size_t slot = string__track_slot(ptr, mask);
 
-/*
-unsigned int string_count_overlap(char *str, char *substr) 
+    // A block handed to plain free() leaves its entry behind, which the next owner of the address replaces
+    while (shard->blocks[slot].ptr && shard->blocks[slot].ptr != ptr) {slot = (slot + 1) & mask;}
 
-returns:
-    > the amount of times <substr> occurs in <str> with overlap
+    string__track_block *block = &shard->blocks[slot];
 
-example:
-    > string_count("Fooo Foo", "oo") -> 3
-                     ^^   ^
-*/
-unsigned int string_count_overlap(char *str, char *substr)
+    if (block->ptr) {string__track_unbook(block->owner, block->size);}
+    else {++shard->length;}
+
+    block->ptr = ptr;
+    block->size = size;
+    block->sequence = sequence;
+    block->owner = owner;
+
+    string__track_book(owner, size);
+}
+
+// Takes <ptr> off the books of <shard> (locked), returning false if it was not on them
+static bool string__track_remove(string__track_shard *shard, void *ptr, string__track_block *removed)
 {
-    if (!str || !substr) {return 0;}
+    if (shard->capacity == 0) {return false;}
 
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+    size_t mask = shard->capacity - 1;
+    size_t slot = string__track_slot(ptr, mask);
 
-    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+    while (shard->blocks[slot].ptr != ptr)
+    {
+        if (shard->blocks[slot].ptr == NULL) {return false;}
+        slot = (slot + 1) & mask;
+    }
 
-    char *ptr = str;
-    unsigned int count = 0;
+    string__track_block *block = &shard->blocks[slot];
+    string__track_unbook(block->owner, block->size);
 
-    while (ptr = strstr(ptr, substr)) 
+    if (removed) {*removed = *block;}
+
+    // Backward shift, so that no probe sequence is broken and no tombstones are needed
+    for (size_t next = (slot + 1) & mask; shard->blocks[next].ptr; next = (next + 1) & mask)
     {
-        ++ptr;
-        ++count;
+        size_t home = string__track_slot(shard->blocks[next].ptr, mask);
+
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            shard->blocks[slot] = shard->blocks[next];
+            slot = next;
+        }
     }
 
-    return count;
+    shard->blocks[slot].ptr = NULL;
+    --shard->length;
+
+    return true;
 }
 
-/*
-unsigned int string_streak(char *str, char *substr)
+static void string__track_add(void *ptr, size_t size, StringAllocations *owner, size_t sequence)
+{
+    string__track_shard *shard = string__track_shard_of(ptr);
 
-returns:
-    > the amount of times the first occurence of 
-      <substr> is repeated in a row in <str>
+    STRING__LOCK(&shard->lock);
+    string__track_insert(shard, ptr, size, owner, sequence);
+    STRING__UNLOCK(&shard->lock);
+}
 
-example:
-    > string_streak_("Bar Foo Foo Bar Foo", "Foo ") -> 2
-                          ^   ^
-*/
-unsigned int string_streak(char *str, char *substr)
+static bool string__track_take(void *ptr, string__track_block *removed)
 {
-    if (!str || !substr) {return 0;}
+    string__track_shard *shard = string__track_shard_of(ptr);
 
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+    STRING__LOCK(&shard->lock);
+    bool tracked = string__track_remove(shard, ptr, removed);
+    STRING__UNLOCK(&shard->lock);
 
-    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+    return tracked;
+}
 
-    int pos = -1;
-    unsigned int count = 0;
+static void *string__track_malloc(size_t size, const char *function)
+{
+    void *ptr = malloc(size);
+    if (ptr == NULL) {return NULL;}
 
-    const char *ptr = str;
+    string__track_add(ptr, size, string__track_function(string__track_owner(function)), STRING__ATOMIC_ADD(&string__track.sequence, 1));
 
-    ptr = strstr(ptr, substr);
+    return ptr;
+}
 
-    if (ptr != NULL)
-    {
-        pos = ptr - str;
-    }
+static void *string__track_calloc(size_t count, size_t size, const char *function)
+{
+    void *ptr = calloc(count, size);
+    if (ptr == NULL) {return NULL;}
 
-    while (strncmp(str + pos, substr, length_sub) == 0)
+    string__track_add(ptr, count * size, string__track_function(string__track_owner(function)), STRING__ATOMIC_ADD(&string__track.sequence, 1));
+
+    return ptr;
+}
+
+// A grown block stays with the function that first created it
+static void *string__track_realloc(void *ptr, size_t size, const char *function)
+{
+    // Off the books before realloc() frees it, so another thread that is handed the address can book it
+    string__track_block block = {NULL, 0, 0, NULL};
+    bool tracked = (ptr && string__track_take(ptr, &block));
+
+    void *result = realloc(ptr, size);
+
+    if (!tracked)
     {
-        ++count;
-        pos += length_sub;
+        block.owner = string__track_function(string__track_owner(function));
+        block.sequence = STRING__ATOMIC_ADD(&string__track.sequence, 1);
     }
 
-    return count;
+    // On failure <ptr> is still live and goes back on the books as it was
+    if (result) {string__track_add(result, size, block.owner, block.sequence);}
+    else if (tracked && size != 0) {string__track_add(block.ptr, block.size, block.owner, block.sequence);}
+
+    return result;
 }
 
-//----------|
-// Booleans |
-//----------|
+// Frees any block, taking it off the books if it is on them
+static void string__track_free(void *ptr)
+{
+    if (ptr == NULL) {return;}
 
-/*
-bool string_contains(char *str, char *substr)
+    string__track_take(ptr, NULL);
 
-returns:
-    > true if <str> contains <substr>
+    free(ptr);
+}
 
-example:
-    > string_contains("Hello World", "Hello") -> true
-*/
-bool string_contains(char *str, char *substr)
+#if defined(ZSTRING_THREADS)
+typedef struct string__track_thread
 {
-    return (strstr(str, substr) != 0 ? true : false);
+    void *(*routine)(void *);
+    void *argument;
+    const char *caller;
+} string__track_thread;
+
+// Workers book what they allocate to the function that started them
+static void *string__track_thread_run(void *argument)
+{
+    string__track_thread thread = *(string__track_thread *)argument;
+    free(argument);
+
+    string__track_caller = thread.caller;
+
+    return thread.routine(thread.argument);
+}
+
+static int string__track_thread_create(pthread_t *handle, const pthread_attr_t *attributes, void *(*routine)(void *), void *argument)
+{
+    string__track_thread *thread = malloc(sizeof(string__track_thread));
+    if (thread == NULL) {return -1;}
+
+    thread->routine = routine;
+    thread->argument = argument;
+    thread->caller = string__track_caller;
+
+    int result = pthread_create(handle, attributes, string__track_thread_run, thread);
+    if (result != 0) {free(thread);}
+
+    return result;
+}
+
+#define pthread_create(handle, attributes, routine, argument) string__track_thread_create((handle), (attributes), (routine), (argument))
+#endif
+
+#define malloc(size) string__track_malloc((size), __func__)
+#define calloc(count, size) string__track_calloc((count), (size), __func__)
+#define realloc(ptr, size) string__track_realloc((ptr), (size), __func__)
+#define free(ptr) string__track_free(ptr)
+
+static int string__track_compare(const void *a, const void *b)
+{
+    const StringAllocations *x = a;
+    const StringAllocations *y = b;
+
+    if (x->live_bytes != y->live_bytes) {return (x->live_bytes < y->live_bytes) ? 1 : -1;}
+    if (x->peak_bytes != y->peak_bytes) {return (x->peak_bytes < y->peak_bytes) ? 1 : -1;}
+
+    return strcmp(x->function, y->function);
+}
+
+static int string__track_compare_blocks(const void *a, const void *b)
+{
+    const string__track_block *x = a;
+    const string__track_block *y = b;
+
+    return (x->sequence > y->sequence) - (x->sequence < y->sequence);
 }
 
+#endif
+
+#if !defined(STRING__TRACK_PUBLIC)
+    #define STRING__TRACK_PUBLIC()
+#endif
+
 /*
-bool string_starts_with(char *str, char *substr)
+void string_free(void *ptr)
 
-returns:
-    > true if <str> starts with <substr>
+frees:
+    > <ptr>, which is NULL or a result of a ZString function that needs to be freed; with
+      ZSTRING_TRACK_ALLOCATIONS this is what takes it off the books, and a <ptr> that is not a
+      live ZString block (freed twice, or never allocated here) is counted and reported on
+      stderr instead of being passed to free()
 
 example:
-    > string_starts_with("Hello World", "Hello") -> true
-    > string_starts_with("Hello World", "World") -> false
+    > string_free(string_format("%d", 42))
 */
-bool string_starts_with(char *str, char *substr)
+void string_free(void *ptr)
 {
-    return (strncmp(str, substr, strlen(substr)) == 0 ? true : false);
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    if (ptr == NULL) {return;}
+
+    bool tracked = string__track_take(ptr, NULL) || STRING__ATOMIC_ADD(&string__track.failed, 0);
+
+    if (tracked) {free(ptr);}
+    else
+    {
+        STRING__ATOMIC_ADD(&string__track.invalid_frees, 1);
+        fprintf(stderr, "ZString: string_free(%p) of a block that is not live\n", ptr);
+    }
+#else
+    free(ptr);
+#endif
 }
 
 /*
-bool string_ends_with(char *str, char *substr)
+size_t string_allocations(StringAllocations *output, size_t capacity)
 
 returns:
-    > true if <str> ends with <substr>
+    > the number of ZString functions that have allocated so far, with up to <capacity> of
+      them written to <output> (if not NULL) by live bytes, then peak bytes
+    > 0 without ZSTRING_TRACK_ALLOCATIONS
 
 example:
-    > string_ends_with("Hello World", "Hello") -> false
-    > string_ends_with("Hello World", "World") -> true
+    > string_allocations(rows, 64) -> 2 ({"string_format", 1, 3, 3, 1}, {"string_slice", 0, 0, 6, 1})
 */
-bool string_ends_with(char *str, char *substr)
+size_t string_allocations(StringAllocations *output, size_t capacity)
 {
-    return (strncmp(str + (strlen(str) - strlen(substr)), substr, strlen(substr)) == 0 ? true : false);
-}
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    StringAllocations rows[STRING__TRACK_FUNCTIONS];
+    size_t count = 0;
 
-//------------|
-// Formatting |
-//------------|
+    // Each counter is read atomically, but not all of them at one instant
+    for (size_t i = 0; i < STRING__TRACK_FUNCTIONS; ++i)
+    {
+        StringAllocations *entry = &string__track.functions[i];
+        StringAllocations row;
+
+#if defined(__GNUC__) || defined(__clang__)
+        row.function = __atomic_load_n(&entry->function, __ATOMIC_ACQUIRE);
+#else
+        row.function = *(const char *volatile *)&entry->function;
+#endif
+
+        if (row.function == NULL) {continue;}
+
+        row.live = STRING__ATOMIC_ADD(&entry->live, 0);
+        row.live_bytes = STRING__ATOMIC_ADD(&entry->live_bytes, 0);
+        row.peak_bytes = STRING__ATOMIC_ADD(&entry->peak_bytes, 0);
+        row.total = STRING__ATOMIC_ADD(&entry->total, 0);
+
+        rows[count++] = row;
+    }
+
+    qsort(rows, count, sizeof(StringAllocations), string__track_compare);
+
+    if (output)
+    {
+        for (size_t i = 0; i < count && i < capacity; ++i) {output[i] = rows[i];}
+    }
+
+    return count;
+#else
+    (void)output;
+    (void)capacity;
+
+    return 0;
+#endif
+}
 
 /*
-int string_format(char *str, ...)
+void string_allocations_dump(FILE *stream)
 
-returns:
-    > <str> formatted with extra arguments
-    > needs to be freed!
-    > NULL if invalid <str>
+writes:
+    > to <stream> the live and peak bytes of ZString and of each function that allocated,
+      then every block that is still live (oldest first) with its size and creator
 
 example:
-    > string_format("Hello %s", "World") -> "Hello World"
+    > string_allocations_dump(stderr)
 */
-char *string_format(char *str, ...) 
+void string_allocations_dump(FILE *stream)
 {
-    if (!str) {return NULL;}
+    if (stream == NULL) {return;}
 
-    va_list args;
-    
-    va_start(args, str);
-    int length_buf = vsnprintf(NULL, 0, str, args);
-    va_end(args);
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    StringAllocations rows[STRING__TRACK_FUNCTIONS];
+    size_t count = string_allocations(rows, STRING__TRACK_FUNCTIONS);
+
+    size_t live_bytes = STRING__ATOMIC_ADD(&string__track.live_bytes, 0);
+    size_t peak_bytes = STRING__ATOMIC_ADD(&string__track.peak_bytes, 0);
+    size_t invalid_frees = STRING__ATOMIC_ADD(&string__track.invalid_frees, 0);
+    bool failed = STRING__ATOMIC_ADD(&string__track.failed, 0) != 0;
+
+    // One shard at a time, into an array grown with the real realloc() so the dump does not show up in itself
+    string__track_block *blocks = NULL;
+    size_t length = 0;
 
-    if (length_buf > 0)
+    for (size_t s = 0; s < STRING__TRACK_SHARDS; ++s)
     {
-        ++length_buf;
-        char *output = malloc(length_buf);
+        string__track_shard *shard = &string__track.shards[s];
 
-        va_start(args, str);
-        vsnprintf(output, length_buf, str, args);
-        va_end(args);
+        STRING__LOCK(&shard->lock);
 
-        output[length_buf] = '\0';
-        return output;
+        string__track_block *grown = (string__track_block *)(realloc)(blocks, sizeof(string__track_block) * (length + shard->length + 1));
+
+        if (grown)
+        {
+            blocks = grown;
+
+            for (size_t i = 0; i < shard->capacity; ++i)
+            {
+                if (shard->blocks[i].ptr) {blocks[length++] = shard->blocks[i];}
+            }
+        }
+
+        STRING__UNLOCK(&shard->lock);
     }
 
-    return str;
+    fprintf(stream, "ZString: %zu live blocks, %zu live bytes, %zu peak bytes, %zu invalid frees\n", length, live_bytes, peak_bytes, invalid_frees);
+    if (failed) {fprintf(stream, "ZString: out of memory for the allocation table, tracking stopped\n");}
+    fprintf(stream, "%-40s %10s %14s %14s %10s\n", "function", "live", "live bytes", "peak bytes", "total");
 
-}
+    for (size_t i = 0; i < count; ++i)
+    {
+        fprintf(stream, "%-40s %10zu %14zu %14zu %10zu\n", rows[i].function, rows[i].live, rows[i].live_bytes, rows[i].peak_bytes, rows[i].total);
+    }
 
-//---------|
-// Slicing |
-//---------|
+    if (blocks == NULL) {return;}
 
-/*
-char *string_slice(char *str, unsigned int start, unsigned int end)
+    qsort(blocks, length, sizeof(string__track_block), string__track_compare_blocks);
 
-returns:
-    > <str> sliced from <start> to <end> (inclusive)
-    > needs to be freed!
-    > NULL if invalid <str>
+    for (size_t i = 0; i < length; ++i)
+    {
+        fprintf(stream, "  #%zu %p %zu bytes from %s\n", blocks[i].sequence, blocks[i].ptr, blocks[i].size, blocks[i].owner->function);
+    }
 
-example:
-    > string_slice("Hello World", 0, 4) -> "Hello"
-                    ^---^
-*/
-char *string_slice(char *str, unsigned int start, unsigned int end)
+    (free)(blocks);
+#else
+    fprintf(stream, "ZString: define ZSTRING_TRACK_ALLOCATIONS to track allocations\n");
+#endif
+}
+
+//------------------|
+// Internal Helpers |
+//------------------|
+
+static inline unsigned int string__ctz(unsigned int x)
 {
-    size_t length_str = strlen(str);
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctz(x);
+#else
+    unsigned int n = 0;
+    while ((x & 1) == 0) {x >>= 1; ++n;}
+    return n;
+#endif
+}
 
-    if (!str || start > end || length_str == 0 || length_str < start || length_str < end) {return NULL;}
+static inline unsigned int string__ctz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int n = 0;
+    while ((x & 1) == 0) {x >>= 1; ++n;}
+    return n;
+#endif
+}
 
-    char *output = malloc((end - start) + 1);
+static inline unsigned int string__clz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_clzll(x);
+#else
+    unsigned int n = 0;
+    while ((x & (1ull << 63)) == 0) {x <<= 1; ++n;}
+    return n;
+#endif
+}
 
-    memcpy(output, str + start, (end - start) + 1);
-    
-    output[length_str] = '\0';
-    return output;
+static inline unsigned int string__popcount(unsigned int x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return (((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
 }
 
-//---------|
-// Cutting |
-//---------|
+#if defined(ZSTRING_SSE2)
+static inline __m128i string__reverse_16(__m128i x)
+{
+#ifdef ZSTRING_SSSE3
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+#else
+    x = _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3));
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+    x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+#endif
+}
+#endif
 
-/*
-char *string_cut_left(char *str, unsigned int amount)
+#ifdef ZSTRING_AVX2
+static inline __m256i string__reverse_32(__m256i x)
+{
+    const __m256i mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                          15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-returns:
-    > <str> with <amount> sliced off from the left
-    > NULL if invalid <str>
-    > needs to be freed!
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, mask), _MM_SHUFFLE(1, 0, 3, 2));
+}
+#endif
 
-example:
-    > string_cut_left("Hello World", 5) -> " World"
-                       ----^
-*/
-char *string_cut_left(char *str, unsigned int amount)
+// Length-aware substring search, returns the offset of the first match or (size_t)-1
+static size_t string__find(const char *hay, size_t length_hay, const char *needle, size_t length_needle)
 {
-    size_t length_str = strlen(str);
+    if (length_needle == 0)         {return 0;}
+    if (length_needle > length_hay) {return (size_t)-1;}
 
-    if (!str || length_str < amount) {return NULL;}
+    if (length_needle == 1)
+    {
+        const char *ptr = memchr(hay, needle[0], length_hay);
+        return ptr ? (size_t)(ptr - hay) : (size_t)-1;
+    }
 
-    char *output = malloc((length_str + 1) - amount);
+    // Candidates must match both the first and last byte of <needle>, which is checked a block at a time
+    size_t last = length_needle - 1;
+    size_t i = 0;
 
-    memcpy(output, str + amount, length_str - amount);
+#ifdef ZSTRING_AVX2
+    {
+        const __m256i first_v = _mm256_set1_epi8(needle[0]);
+        const __m256i last_v = _mm256_set1_epi8(needle[last]);
 
-    output[length_str] = '\0';
+        for (; i + last + 32 <= length_hay; i += 32)
+        {
+            __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(hay + i)), first_v);
+            __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(hay + i + last)), last_v);
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(a, b));
 
-    return output;
+            while (mask)
+            {
+                unsigned int bit = string__ctz(mask);
+
+                if (memcmp(hay + i + bit + 1, needle + 1, last - 1) == 0) {return i + bit;}
+
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+#ifdef ZSTRING_SSE2
+    {
+        const __m128i first_v = _mm_set1_epi8(needle[0]);
+        const __m128i last_v = _mm_set1_epi8(needle[last]);
+
+        for (; i + last + 16 <= length_hay; i += 16)
+        {
+            __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(hay + i)), first_v);
+            __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(hay + i + last)), last_v);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(a, b));
+
+            while (mask)
+            {
+                unsigned int bit = string__ctz(mask);
+
+                if (memcmp(hay + i + bit + 1, needle + 1, last - 1) == 0) {return i + bit;}
+
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; i + last < length_hay; ++i)
+    {
+        if (hay[i] == needle[0] && memcmp(hay + i, needle, length_needle) == 0) {return i;}
+    }
+
+    return (size_t)-1;
 }
 
-/*
-char *string_cut_right(char *str, unsigned int amount)
+static inline unsigned char string__fold(unsigned char c)
+{
+    return (unsigned char)(c - 'A') < 26 ? (unsigned char)(c | 0x20) : c;
+}
 
-returns:
-    > <str> with <amount> sliced off from the right
-    > NULL if invalid <str>
-    > needs to be freed!
+#ifdef ZSTRING_SSE2
+// ASCII lower case of 16 bytes: moves 'A'..'Z' to the bottom of the signed range so one compare finds them
+static inline __m128i string__fold_16(__m128i x)
+{
+    __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - 'A'))), _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
 
-example:
-    > string_cut_right("Hello World", 5) -> "Hello "
-                              ^----
-*/
-char *string_cut_right(char *str, unsigned int amount)
+#ifdef ZSTRING_AVX2
+static inline __m256i string__fold_32(__m256i x)
 {
-    size_t length_str = strlen(str);
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), _mm256_add_epi8(x, _mm256_set1_epi8((char)(0x80 - 'A'))));
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+#endif
 
-    if (!str || length_str < amount) {return NULL;}
+// Compares <length> bytes ignoring ASCII case
+static bool string__equal_ci(const char *a, const char *b, size_t length)
+{
+    size_t i = 0;
 
-    char *output = malloc((length_str + 1) - amount);
+#ifdef ZSTRING_SSE2
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i x = string__fold_16(_mm_loadu_si128((const __m128i *)(a + i)));
+        __m128i y = string__fold_16(_mm_loadu_si128((const __m128i *)(b + i)));
 
-    memcpy(output, str, length_str - amount);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF) {return false;}
+    }
+#endif
 
-    output[length_str] = '\0';
+    for (; i < length; ++i)
+    {
+        if (string__fold((unsigned char)a[i]) != string__fold((unsigned char)b[i])) {return false;}
+    }
 
-    return output;
+    return true;
 }
 
-/*
-char *string_split(char *str, char *delimiter)
+// string__find() ignoring ASCII case, folding the haystack inside the compare loop
+static size_t string__find_ci(const char *hay, size_t length_hay, const char *needle, size_t length_needle)
+{
+    if (length_needle == 0)         {return 0;}
+    if (length_needle > length_hay) {return (size_t)-1;}
 
-returns:
-    > an array containing contents of <str> split by <delimiter>
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+    size_t last = length_needle - 1;
+    unsigned char first_c = string__fold((unsigned char)needle[0]);
+    unsigned char last_c = string__fold((unsigned char)needle[last]);
+    size_t i = 0;
 
-example:
-    > string_split("Hello World", " ") -> {"Hello", "World"}
-*/
+#ifdef ZSTRING_AVX2
+    {
+        const __m256i first_v = _mm256_set1_epi8((char)first_c);
+        const __m256i last_v = _mm256_set1_epi8((char)last_c);
 
-char **string_split(char *str, char *delimiter)
+        for (; i + last + 32 <= length_hay; i += 32)
+        {
+            __m256i a = _mm256_cmpeq_epi8(string__fold_32(_mm256_loadu_si256((const __m256i *)(hay + i))), first_v);
+            __m256i b = _mm256_cmpeq_epi8(string__fold_32(_mm256_loadu_si256((const __m256i *)(hay + i + last))), last_v);
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+
+            while (mask)
+            {
+                unsigned int bit = string__ctz(mask);
+
+                if (string__equal_ci(hay + i + bit, needle, length_needle)) {return i + bit;}
+
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+#ifdef ZSTRING_SSE2
+    {
+        const __m128i first_v = _mm_set1_epi8((char)first_c);
+        const __m128i last_v = _mm_set1_epi8((char)last_c);
+
+        for (; i + last + 16 <= length_hay; i += 16)
+        {
+            __m128i a = _mm_cmpeq_epi8(string__fold_16(_mm_loadu_si128((const __m128i *)(hay + i))), first_v);
+            __m128i b = _mm_cmpeq_epi8(string__fold_16(_mm_loadu_si128((const __m128i *)(hay + i + last))), last_v);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(a, b));
+
+            while (mask)
+            {
+                unsigned int bit = string__ctz(mask);
+
+                if (string__equal_ci(hay + i + bit, needle, length_needle)) {return i + bit;}
+
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; i + last < length_hay; ++i)
+    {
+        if (string__fold((unsigned char)hay[i]) == first_c && string__fold((unsigned char)hay[i + last]) == last_c &&
+            string__equal_ci(hay + i, needle, length_needle))
+        {
+            return i;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+// ASCII-only case mapping of <length> bytes from <src> into <dst> (may alias)
+static void string__ascii_case(unsigned char *dst, const unsigned char *src, size_t length, bool upper)
 {
-    if (!str || !delimiter) {return NULL;}
+    unsigned char from = upper ? 'a' : 'A';
+    size_t i = 0;
 
-    size_t length_str = strlen(str);
-    unsigned int count = 0;
-    
+#ifdef ZSTRING_AVX2
     {
-        size_t length_sub = strlen(delimiter);
+        // Moves [from, from + 26) to the bottom of the signed range, so one compare finds it
+        const __m256i shift = _mm256_set1_epi8((char)(0x80 - from));
+        const __m256i limit = _mm256_set1_epi8((char)(0x80 + 26));
+        const __m256i flip = _mm256_set1_epi8(0x20);
 
-        if (length_str < length_sub || length_str == 0 || length_sub == 0) {return NULL;}
+        for (; i + 32 <= length; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i *)(src + i));
+            __m256i in_range = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, shift));
+            _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(block, _mm256_and_si256(in_range, flip)));
+        }
+    }
+#endif
 
-        char *ptr = str;
+#ifdef ZSTRING_SSE2
+    {
+        const __m128i shift = _mm_set1_epi8((char)(0x80 - from));
+        const __m128i limit = _mm_set1_epi8((char)(0x80 + 26));
+        const __m128i flip = _mm_set1_epi8(0x20);
 
-        while (ptr = strstr(ptr, delimiter)) 
+        for (; i + 16 <= length; i += 16)
         {
-            ptr += length_sub;
-            ++count;
+            __m128i block = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(block, shift), limit);
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(block, _mm_and_si128(in_range, flip)));
         }
     }
+#endif
 
-    char *copy = malloc(length_str + 1);
-    memcpy(copy, str, length_str + 1);
+    for (; i < length; ++i)
+    {
+        unsigned char c = src[i];
+        dst[i] = (unsigned char)(c - from) < 26 ? (unsigned char)(c ^ 0x20) : c;
+    }
+}
 
-    char **output = malloc(sizeof(char*) * (count + 1));
+// Reverses <length> bytes at <s> in place, swapping whole blocks from both ends
+static void string__reverse_bytes(unsigned char *s, size_t length)
+{
+    unsigned char *lo = s;
+    unsigned char *hi = s + length;
+
+#ifdef ZSTRING_AVX2
+    while (hi - lo >= 64)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)lo);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(hi - 32));
+
+        _mm256_storeu_si256((__m256i *)lo, string__reverse_32(b));
+        _mm256_storeu_si256((__m256i *)(hi - 32), string__reverse_32(a));
+
+        lo += 32;
+        hi -= 32;
+    }
+#endif
+
+#ifdef ZSTRING_SSE2
+    while (hi - lo >= 32)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)lo);
+        __m128i b = _mm_loadu_si128((const __m128i *)(hi - 16));
+
+        _mm_storeu_si128((__m128i *)lo, string__reverse_16(b));
+        _mm_storeu_si128((__m128i *)(hi - 16), string__reverse_16(a));
+
+        lo += 16;
+        hi -= 16;
+    }
+#endif
+
+    while (hi - lo >= 2)
+    {
+        --hi;
+
+        unsigned char tmp = *lo;
+        *lo = *hi;
+        *hi = tmp;
+
+        ++lo;
+    }
+}
+
+// Writes the <length> bytes at <src> reversed into <dst> (no overlap)
+static void string__reverse_copy(unsigned char *dst, const unsigned char *src, size_t length)
+{
+    size_t i = 0;
+
+#ifdef ZSTRING_AVX2
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(src + length - i - 32));
+        _mm256_storeu_si256((__m256i *)(dst + i), string__reverse_32(block));
+    }
+#endif
+
+#ifdef ZSTRING_SSE2
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(src + length - i - 16));
+        _mm_storeu_si128((__m128i *)(dst + i), string__reverse_16(block));
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        dst[i] = src[length - 1 - i];
+    }
+}
+
+//----------------|
+// Location Index |
+//----------------|
+
+/*
+int string_find(char *str, char *substr)
+
+returns:
+    > position of the first occurence of <substr> in <str>
+    > -1 if <substr> wasn't found
+      (an int, so see string_buffer_find() for strings past 2 GB)
+
+example:
+    > string_find("Foo Bar Foo Bar", "Foo") -> 0
+                   ^
+    > string_find("Bar Foo Bar Foo", "Foo") -> 4
+                       ^
+*/
+int string_find(char *str, char *substr) 
+{
+    if (!str || !substr) {return -1;}
+
+    size_t length_str = strlen(str);
+    int pos = -1;
+
+    if (length_str > 0)
+    {
+        const char *ptr = str;
+
+        ptr = strstr(ptr, substr);
+    
+        if (ptr != NULL)
+        {
+            pos = ptr - str;
+        }
+    }
+
+    return pos;
+}
+
+/*
+int string_find_nth(char *str, char *substr, unsigned int count)
+
+returns:
+    > position of nth <count> occurence of <substr> in <str>
+    > -1 if <substr> wasn't found <count> times
+    > -1 if <str>, <substr> or <count> are invalid  
+
+example:
+    > string_find_nth("Foo Bar Foo Bar", "Foo", 2) -> 8
+                               ^
+*/
+int string_find_nth(char *str, char *substr, unsigned int count)
+{
+    if (!str || !substr || count == 0) {return -1;}
+    
+    size_t length_str = strlen(str);
+    int pos = -1;
+
+    // An empty <substr> occurs at every position, the end included
+    if (*substr == '\0') {return (count - 1 <= length_str) ? (int)(count - 1) : -1;}
+
+    if (length_str > 0)
+    {
+        const char *ptr = str;
+
+        for (unsigned int i = 0; i < count; ++i) 
+        {
+            ptr = strstr(ptr, substr);
+    
+            if (ptr == NULL)
+            {
+                return -1;
+            } 
+
+            pos = (ptr - str);
+            ++ptr;
+        }
+    }
+
+    return pos;
+}
+
+//----------|
+// Counting |
+//----------|
+
+/*
+unsigned int string_count(char *str, char *substr)
+
+returns:
+    > the amount of times <substr> occurs in <str>
+      (an unsigned int, so see string_buffer_count() for strings past 4 GB)
+
+example:
+    > string_count("Fooo Foo", "oo") -> 2
+                     ^    ^
+*/
+unsigned int string_count(char *str, char *substr)
+{
+    if (!str || !substr) {return 0;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    char *ptr = str;
+    unsigned int count = 0;
+
+    while (ptr = strstr(ptr, substr)) 
+    {
+        ptr += length_sub;
+        ++count;
+    }
+
+    return count;
+}
+
+/*
+unsigned int string_count_overlap(char *str, char *substr) 
+
+returns:
+    > the amount of times <substr> occurs in <str> with overlap
+
+example:
+    > string_count("Fooo Foo", "oo") -> 3
+                     ^^   ^
+*/
+unsigned int string_count_overlap(char *str, char *substr)
+{
+    if (!str || !substr) {return 0;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    char *ptr = str;
+    unsigned int count = 0;
+
+    while (ptr = strstr(ptr, substr)) 
+    {
+        ++ptr;
+        ++count;
+    }
+
+    return count;
+}
+
+/*
+unsigned int string_streak(char *str, char *substr)
+
+returns:
+    > the amount of times the first occurence of 
+      <substr> is repeated in a row in <str>
+
+example:
+    > string_streak_("Bar Foo Foo Bar Foo", "Foo ") -> 2
+                          ^   ^
+*/
+unsigned int string_streak(char *str, char *substr)
+{
+    if (!str || !substr) {return 0;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    int pos = -1;
+    unsigned int count = 0;
+
+    const char *ptr = str;
+
+    ptr = strstr(ptr, substr);
+
+    if (ptr == NULL) {return 0;}
+
+    pos = ptr - str;
+
+    while (strncmp(str + pos, substr, length_sub) == 0)
+    {
+        ++count;
+        pos += length_sub;
+    }
+
+    return count;
+}
+
+//----------|
+// Booleans |
+//----------|
+
+/*
+bool string_contains(char *str, char *substr)
+
+returns:
+    > true if <str> contains <substr>
+
+example:
+    > string_contains("Hello World", "Hello") -> true
+*/
+bool string_contains(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    return (strstr(str, substr) != 0 ? true : false);
+}
+
+/*
+bool string_starts_with(char *str, char *substr)
+
+returns:
+    > true if <str> starts with <substr>
+
+example:
+    > string_starts_with("Hello World", "Hello") -> true
+    > string_starts_with("Hello World", "World") -> false
+*/
+bool string_starts_with(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    return (strncmp(str, substr, strlen(substr)) == 0 ? true : false);
+}
+
+/*
+bool string_ends_with(char *str, char *substr)
+
+returns:
+    > true if <str> ends with <substr>
+
+example:
+    > string_ends_with("Hello World", "Hello") -> false
+    > string_ends_with("Hello World", "World") -> true
+*/
+bool string_ends_with(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_sub > length_str) {return false;}
+
+    return (strncmp(str + (length_str - length_sub), substr, length_sub) == 0 ? true : false);
+}
+
+//------------|
+// Formatting |
+//------------|
+
+static const char string__digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the decimal digits of <value> so they end right before <end>, returns the first digit
+static char *string__u64_digits(char *end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        unsigned int pair = (unsigned int)(value % 100) * 2;
+        value /= 100;
+
+        end -= 2;
+        end[0] = string__digit_pairs[pair];
+        end[1] = string__digit_pairs[pair + 1];
+    }
+
+    if (value >= 10)
+    {
+        unsigned int pair = (unsigned int)value * 2;
+
+        end -= 2;
+        end[0] = string__digit_pairs[pair];
+        end[1] = string__digit_pairs[pair + 1];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+
+    return end;
+}
+
+/*
+    Shortest round-trip conversion of doubles, after Ulf Adams' Ryu
+    ("Ryu: Fast Float-to-String Conversion", PLDI 2018).
+    The tables hold 5^i and 2^k / 5^i rounded to 125 significant bits.
+*/
+static const uint64_t string__pow5_inv_split[342][2] = {
+    {0x0000000000000001u, 0x2000000000000000u}, {0x999999999999999Au, 0x1999999999999999u},
+    {0x47AE147AE147AE15u, 0x147AE147AE147AE1u}, {0x6C8B4395810624DEu, 0x10624DD2F1A9FBE7u},
+    {0x7A786C226809D496u, 0x1A36E2EB1C432CA5u}, {0x61F9F01B866E43ABu, 0x14F8B588E368F084u},
+    {0xB4C7F34938583622u, 0x10C6F7A0B5ED8D36u}, {0x87A6520EC08D236Au, 0x1AD7F29ABCAF4857u},
+    {0x9FB841A566D74F88u, 0x15798EE2308C39DFu}, {0xE62D01511F12A607u, 0x112E0BE826D694B2u},
+    {0xD6AE6881CB5109A4u, 0x1B7CDFD9D7BDBAB7u}, {0xDEF1ED34A2A73AEAu, 0x15FD7FE17964955Fu},
+    {0x7F27F0F6E885C8BBu, 0x119799812DEA1119u}, {0x650CB4BE40D60DF8u, 0x1C25C268497681C2u},
+    {0xEA70909833DE7193u, 0x16849B86A12B9B01u}, {0x21F3A6E0297EC143u, 0x1203AF9EE756159Bu},
+    {0x6985D7CD0F313537u, 0x1CD2B297D889BC2Bu}, {0x2137DFD73F5A90F9u, 0x170EF54646D49689u},
+    {0xE75FE645CC4873FAu, 0x12725DD1D243ABA0u}, {0xA5663D3C7A0D865Du, 0x1D83C94FB6D2AC34u},
+    {0x511E976394D79EB1u, 0x179CA10C9242235Du}, {0xDA7EDF82DD794BC1u, 0x12E3B40A0E9B4F7Du},
+    {0x2A6498D1625BAC68u, 0x1E392010175EE596u}, {0xEEB6E0A781E2F053u, 0x182DB34012B25144u},
+    {0x58924D52CE4F26A9u, 0x1357C299A88EA76Au}, {0x27507BB7B07EA441u, 0x1EF2D0F5DA7DD8AAu},
+    {0x52A6C95FC0655034u, 0x18C240C4AECB13BBu}, {0x0EEBD44C99EAA690u, 0x13CE9A36F23C0FC9u},
+    {0xB17953ADC3110A80u, 0x1FB0F6BE50601941u}, {0xC12DDC8B02740867u, 0x195A5EFEA6B34767u},
+    {0x3424B06F3529A052u, 0x14484BFEEBC29F86u}, {0x901D59F290EE19DBu, 0x1039D66589687F9Eu},
+    {0x4CFBC31DB4B0295Fu, 0x19F623D5A8A73297u}, {0x3D9635B15D59BAB2u, 0x14C4E977BA1F5BACu},
+    {0x97AB5E277DE16228u, 0x109D8792FB4C4956u}, {0xF2ABC9D8C9689D0Du, 0x1A95A5B7F87A0EF0u},
+    {0x5BBCA17A3ABA173Eu, 0x154484932D2E725Au}, {0xAFCA1AC82EFB45CBu, 0x11039D428A8B8EAEu},
+    {0xB2DCF7A6B1920945u, 0x1B38FB9DAA78E44Au}, {0xF57D92EBC141A104u, 0x15C72FB1552D836Eu},
+    {0xC46475896767B403u, 0x116C262777579C58u}, {0x6D6D88DBD8A5ECD2u, 0x1BE03D0BF225C6F4u},
+    {0x8ABE071646EB23DBu, 0x164CFDA3281E38C3u}, {0x6EFE6C11D255B649u, 0x11D7314F534B609Cu},
+    {0xB197134FB6EF8A0Eu, 0x1C8B821885456760u}, {0x27AC0F72F8BFA1A5u, 0x16D601AD376AB91Au},
+    {0xB95672C260994E1Eu, 0x1244CE242C5560E1u}, {0xF5571E03CDC21695u, 0x1D3AE36D13BBCE35u},
+    {0x2AAC18030B01ABABu, 0x17624F8A762FD82Bu}, {0xBBBCE0026F348956u, 0x12B50C6EC4F31355u},
+    {0x92C7CCD0B1EDA889u, 0x1DEE7A4AD4B81EEFu}, {0xDBD30A408E57BA07u, 0x17F1FB6F10934BF2u},
+    {0x7CA8D50071DFC806u, 0x1327FC58DA0F6FF5u}, {0xFAA7BB33E9660CD6u, 0x1EA6608E29B24CBBu},
+    {0x9552FC298784D711u, 0x18851A0B548EA3C9u}, {0xAAA8C9BAD2D0AC0Eu, 0x139DAE6F76D88307u},
+    {0xDDDADC5E1E1AACE3u, 0x1F62B0B257C0D1A5u}, {0x7E48B04B4B488A4Fu, 0x191BC08EAC9A4151u},
+    {0xCB6D59D5D5D3A1D9u, 0x141633A556E1CDDAu}, {0x3C577B1177DC817Bu, 0x1011C2EAABE7D7E2u},
+    {0xC6F25E825960CF2Au, 0x19B604AAACA62636u}, {0x6BF518684780A5BBu, 0x14919D5556EB51C5u},
+    {0x232A79ED06008496u, 0x10747DDDDF22A7D1u}, {0xD1DD8FE1A3340756u, 0x1A53FC9631D10C81u},
+    {0xA7E4731AE8F66C45u, 0x150FFD44F4A73D34u}, {0x531D28E253F8569Eu, 0x10D9976A5D52975Du},
+    {0xEB61DB03B98D5762u, 0x1AF5BF109550F22Eu}, {0xBC4E48CFC7A445E8u, 0x159165A6DDDA5B58u},
+    {0x6371D3D96C836B20u, 0x11411E1F17E1E2ADu}, {0x9F1C8628AD9F11CDu, 0x1B9B6364F3030448u},
+    {0xE5B06B53BE18DB0Bu, 0x1615E91D8F359D06u}, {0xEAF3890FCB4715A2u, 0x11AB20E472914A6Bu},
+    {0x44B8DB4C7871BC37u, 0x1C45016D841BAA46u}, {0x03C715D6C6C1635Fu, 0x169D9ABE03495505u},
+    {0x3638DE456BCDE919u, 0x1217AEFE69077737u}, {0x56C163A2461641C1u, 0x1CF2B1970E725858u},
+    {0xDF011C81D1AB67CEu, 0x17288E1271F51379u}, {0x7F3416CE4155ECA5u, 0x1286D80EC190DC61u},
+    {0x6520247D3556476Eu, 0x1DA48CE468E7C702u}, {0xEA801D30F7783925u, 0x17B6D71D20B96C01u},
+    {0xBB99B0F3F92CFA84u, 0x12F8AC174D612334u}, {0x5F5C4E532847F739u, 0x1E5AACF215683854u},
+    {0x7F7D0B75B9D32C2Eu, 0x18488A5B44536043u}, {0x9930D5F7C7DC2358u, 0x136D3B7C36A919CFu},
+    {0x8EB4898C72F9D226u, 0x1F152BF9F10E8FB2u}, {0x722A07A38F2E41B8u, 0x18DDBCC7F40BA628u},
+    {0xC1BB394FA5BE9AFAu, 0x13E497065CD61E86u}, {0x9C5EC2190930F7F6u, 0x1FD424D6FAF030D7u},
+    {0x49E56814075A5FF8u, 0x197683DF2F268D79u}, {0x6E51201005E1E660u, 0x145ECFE5BF520AC7u},
+    {0xF1DA800CD181851Au, 0x104BD984990E6F05u}, {0x4FC400148268D4F5u, 0x1A12F5A0F4E3E4D6u},
+    {0xD96999AA01ED772Bu, 0x14DBF7B3F71CB711u}, {0xADEE1488018AC5BCu, 0x10AFF95CC5B09274u},
+    {0x497CEDA668DE092Cu, 0x1AB328946F80EA54u}, {0x3ACA57B853E4D424u, 0x155C2076BF9A5510u},
+    {0x623B7960431D7683u, 0x1116805EFFAEAA73u}, {0x9D2BF566D1C8BD9Eu, 0x1B5733CB32B110B8u},
+    {0x7DBCC452416D647Fu, 0x15DF5CA28EF40D60u}, {0xCAFD69DB678AB6CCu, 0x117F7D4ED8C33DE6u},
+    {0xAB2F0FC572778ADFu, 0x1BFF2EE48E052FD7u}, {0x88F273045B92D580u, 0x1665BF1D3E6A8CACu},
+    {0xD3F528D049424466u, 0x11EAFF4A98553D56u}, {0xB988414D4203A0A3u, 0x1CAB3210F3BB9557u},
+    {0x6139CDD76802E6E9u, 0x16EF5B40C2FC7779u}, {0xE761717920025254u, 0x125915CD68C9F92Du},
+    {0xA568B58E999D5086u, 0x1D5B561574765B7Cu}, {0x5120913EE14AA6D2u, 0x177C44DDF6C515FDu},
+    {0xA74D40FF1AA21F0Eu, 0x12C9D0B1923744CAu}, {0x0BAECE64F769CB4Au, 0x1E0FB44F50586E11u},
+    {0x3C8BD850C5EE3C3Bu, 0x180C903F7379F1A7u}, {0xCA0979DA37F1C9C9u, 0x133D4032C2C7F485u},
+    {0xA9A8C2F6BFE942DBu, 0x1EC866B79E0CBA6Fu}, {0x2153CF2BCCBA9BE3u, 0x18A0522C7E709526u},
+    {0x1AA9728970954982u, 0x13B374F06526DDB8u}, {0xF775840F1A88759Du, 0x1F8587E7083E2F8Cu},
+    {0x5F9136727BA05E17u, 0x19379FEC0698260Au}, {0x1940F85B9619E4DFu, 0x142C7FF0054684D5u},
+    {0xE100C6AFAB47EA4Cu, 0x1023998CD1053710u}, {0xCE67A44C453FDD47u, 0x19D28F47B4D524E7u},
+    {0xD852E9D69DCCB106u, 0x14A8729FC3DDB71Fu}, {0x79DBEE454B0A2738u, 0x1086C219697E2C19u},
+    {0x295FE3A211A9D859u, 0x1A71368F0F30468Fu}, {0xBAB31C81A7BB137Au, 0x15275ED8D8F36BA5u},
+    {0x6228E39AEC95A92Fu, 0x10EC4BE0AD8F8951u}, {0x9D0E38F7E0EF7517u, 0x1B13AC9AAF4C0EE8u},
+    {0xB0D82D931A592A79u, 0x15A956E225D67253u}, {0x8D79BE0F4847552Eu, 0x11544581B7DEC1DCu},
+    {0x158F967EDA0BBB7Cu, 0x1BBA08CF8C979C94u}, {0x77A611FF14D62F97u, 0x162E6D72D6DFB076u},
+    {0xF951A7FF43DE8C79u, 0x11BEBDF578B2F391u}, {0xC21C3FFED2FDAD8Eu, 0x1C6463225AB7EC1Cu},
+    {0x01B0333242648AD8u, 0x16B6B5B5155FF017u}, {0x0159C28E9B83A246u, 0x122BC490DDE659ACu},
+    {0xCEF604175F3903A3u, 0x1D12D41AFCA3C2ACu}, {0x725E69AC4C2D9C83u, 0x17424348CA1C9BBDu},
+    {0xF5185489D68AE39Cu, 0x129B69070816E2FDu}, {0xEE8D540FBDAB05C6u, 0x1DC574D80CF16B2Fu},
+    {0xBED77672FE226B05u, 0x17D12A4670C1228Cu}, {0xFF12C528CB4EBC04u, 0x130DBB6B8D674ED6u},
+    {0xCB513B74787DF9A0u, 0x1E7C5F127BD87E24u}, {0x090DC929F9FE614Du, 0x18637F41FCAD31B7u},
+    {0xA0D7D42194CB810Au, 0x1382CC34CA2427C5u}, {0x67BFB9CF5478CE77u, 0x1F37AD21436D0C6Fu},
+    {0x1FCC94A5DD2D71F9u, 0x18F9574DCF8A7059u}, {0x7FD6DD517DBDF4C7u, 0x13FAAC3E3FA1F37Au},
+    {0xFFBE2EE8C92FEE0Bu, 0x1FF779FD329CB8C3u}, {0x6631BF20A0F324D6u, 0x1992C7FDC216FA36u},
+    {0xB827CC1A1A5C1D78u, 0x14756CCB01ABFB5Eu}, {0x935309AE7B7CE460u, 0x105DF0A267BCC918u},
+    {0x1EEB42B0C594A099u, 0x1A2FE76A3F9474F4u}, {0xE58902270476E6E1u, 0x14F31F8832DD2A5Cu},
+    {0xB7A0CE859D2BEBE7u, 0x10C27FA028B0EEB0u}, {0x59014A6F61DFDFD8u, 0x1AD0CC33744E4AB4u},
+    {0xE0CDD525E7E64CADu, 0x1573D68F903EA229u}, {0x4D7177518651D6F1u, 0x11297872D9CBB4EEu},
+    {0x7BE8BEE8D6E957E8u, 0x1B758D848FAC54B0u}, {0xFCBA3253DF211320u, 0x15F7A46A0C89DD59u},
+    {0x63C8284318E74280u, 0x1192E9EE706E4AAEu}, {0x060D0D3827D86A66u, 0x1C1E43171A4A1117u},
+    {0x6B3DA42CECAD21EBu, 0x167E9C127B6E7412u}, {0x88FE1CF0BD574E56u, 0x11FEE341FC585CDBu},
+    {0x419694B462254A23u, 0x1CCB0536608D615Fu}, {0x67ABAA29E81DD4E9u, 0x1708D0F84D3DE77Fu},
+    {0xB95621BB2017DD87u, 0x126D73F9D764B932u}, {0xC223692B668C95A5u, 0x1D7BECC2F23AC1EAu},
+    {0xCE82BA891ED6DE1Du, 0x179657025B6234BBu}, {0xA53562074BDF1818u, 0x12DEAC01E2B4F6FCu},
+    {0x3B889CD87964F359u, 0x1E3113363787F194u}, {0xFC6D4A46C783F5E1u, 0x18274291C6065ADCu},
+    {0x30576E9F06032B1Au, 0x13529BA7D19EAF17u}, {0x1A257DCB3CD1DE90u, 0x1EEA92A61C311825u},
+    {0x481DFE3C30A7E540u, 0x18BBA884E35A79B7u}, {0xD34B31C9C0865100u, 0x13C9539D82AEC7C5u},
+    {0x5211E942CDA3B4CDu, 0x1FA885C8D117A609u}, {0x74DB21023E1C90A4u, 0x19539E3A40DFB807u},
+    {0xF715B401CB4A0D50u, 0x1442E4FB67196005u}, {0xF8DE299B09080AA7u, 0x103583FC527AB337u},
+    {0x8E304291A80CDDD7u, 0x19EF3993B72AB859u}, {0x3E8D020E200A4B13u, 0x14BF6142F8EEF9E1u},
+    {0x653D9B3E80083C0Fu, 0x10991A9BFA58C7E7u}, {0x6EC8F864000D2CE4u, 0x1A8E90F9908E0CA5u},
+    {0x8BD3F9E999A423EAu, 0x153EDA614071A3B7u}, {0x3CA994BAE1501CBBu, 0x10FF151A99F482F9u},
+    {0xC775BAC49BB3612Bu, 0x1B31BB5DC320D18Eu}, {0xD2C4956A16291A89u, 0x15C162B168E70E0Bu},
+    {0xDBD0778811BA7BA1u, 0x11678227871F3E6Fu}, {0x2C80BF401C5D929Bu, 0x1BD8D03F3E9863E6u},
+    {0xBD33CC3349E47549u, 0x16470CFF6546B651u}, {0xCA8FD68F6E505DD4u, 0x11D270CC51055EA7u},
+    {0x4419574BE3B3C953u, 0x1C83E7AD4E6EFDD9u}, {0x0347790982F63AA9u, 0x16CFEC8AA52597E1u},
+    {0xCF6C60D468C4FBBAu, 0x123FF06EEA847980u}, {0xE57A34870E07F92Au, 0x1D331A4B10D3F59Au},
+    {0x512E906C0B399422u, 0x175C1508DA432AE2u}, {0xDA8BA6BCD5C7A9B5u, 0x12B010D3E1CF5581u},
+    {0x90DF712E22D90F87u, 0x1DE6815302E5559Cu}, {0xDA4C5A8B4F140C6Cu, 0x17EB9AA8CF1DDE16u},
+    {0xAEA37BA2A5A9A38Au, 0x1322E220A5B17E78u}, {0x7DD25F6AA2A905A9u, 0x1E9E369AA2B59727u},
+    {0x97DB7F888220D154u, 0x187E92154EF7AC1Fu}, {0x797C6606CE80A777u, 0x139874DDD8C6234Cu},
+    {0x8F2D700AE4010BF1u, 0x1F5A549627A36BADu}, {0x0C2459A25000D65Au, 0x191510781FB5EFBEu},
+    {0x701D1481D99A4515u, 0x1410D9F9B2F7F2FEu}, {0xC017439B147B6A77u, 0x100D7B2E28C65BFEu},
+    {0xCCF205C4ED9243F2u, 0x19AF2B7D0E0A2CCAu}, {0x0A5B37D0BE0E9CC2u, 0x148C22CA71A1BD6Fu},
+    {0x0848F973CB3EE3CEu, 0x10701BD527B4978Cu}, {0xDA0E5BEC78649FB0u, 0x1A4CF9550C5425ACu},
+    {0x7B3EAFF060507FC0u, 0x150A6110D6A9B7BDu}, {0x95CBBFF380406633u, 0x10D51A73DEEE2C97u},
+    {0xEFAC665266CD7052u, 0x1AEE90B964B04758u}, {0x2623850EB8A459DBu, 0x158BA6FAB6F36C47u},
+    {0x1E82D0D893B6AE49u, 0x113C85955F29236Cu}, {0xFD9E1AF41F8AB075u, 0x1B9408EEFEA838ACu},
+    {0x97B1AF29B2D559F7u, 0x16100725988693BDu}, {0xAC8E25BAF5777B2Cu, 0x11A66C1E139EDC97u},
+    {0x7A7D092B2258C513u, 0x1C3D79C9B8FE2DBFu}, {0x61FDA0EF4EAD6A76u, 0x169794A160CB57CCu},
+    {0xE7FE1A590BBDEEC5u, 0x1212DD4DE7091309u}, {0xA6635D5B45FCB13Au, 0x1CEAFBAFD80E84DCu},
+    {0x851C4AAF6B308DC8u, 0x172262F3133ED0B0u}, {0xD0E36EF2BC26D7D4u, 0x1281E8C275CBDA26u},
+    {0xB49F17EAC6A48C86u, 0x1D9CA79D894629D7u}, {0x2A18DFEF0550706Bu, 0x17B08617A104EE46u},
+    {0x54E0B3259DD9F389u, 0x12F39E794D9D8B6Bu}, {0x87CDEB6F62F65274u, 0x1E5297287C2F4578u},
+    {0xD30B22BF825EA85Du, 0x18421286C9BF6AC6u}, {0x0F3C1BCC684BB9E4u, 0x13680ED23AFF889Fu},
+    {0x18602C7A4079296Du, 0x1F0CE4839198DA98u}, {0x46B356C833942124u, 0x18D71D360E13E213u},
+    {0x388F78A029434DB6u, 0x13DF4A91A4DCB4DCu}, {0x5A7F2766A86BAF8Au, 0x1FCBAA82A1612160u},
+    {0x153285EBB9EFBFA2u, 0x196FBB9BB44DB44Du}, {0xAA8ED189618C994Eu, 0x145962E2F6A4903Du},
+    {0xEED8A7A11AD6E10Cu, 0x1047824F2BB6D9CAu}, {0x7E27729B5E249B45u, 0x1A0C03B1DF8AF611u},
+    {0xFE85F549181D4904u, 0x14D6695B193BF80Du}, {0xCB9E5DD4134AA0D0u, 0x10AB877C142FF9A4u},
+    {0xDF63C9535211014Du, 0x1AAC0BF9B9E65C3Au}, {0x191CA10F74DA6771u, 0x15566FFAFB1EB02Fu},
+    {0xADB080D92A4852C1u, 0x1111F32F2F4BC025u}, {0x15E7348EAA0D5134u, 0x1B4FEB7EB212CD09u},
+    {0xAB1F5D3EEE710DC4u, 0x15D98932280F0A6Du}, {0xBC1917658B8DA49Du, 0x117AD428200C0857u},
+    {0x2CF4F23C127C3A94u, 0x1BF7B9D9CCE00D59u}, {0xF0C3F4FCDB969543u, 0x165FC7E170B33DE0u},
+    {0x5A365D9716121103u, 0x11E6398126F5CB1Au}, {0x9056FC24F01CE804u, 0x1CA38F350B22DE90u},
+    {0xD9DF301D8CE3ECD0u, 0x16E93F5DA2824BA6u}, {0xE17F59B13D8323DAu, 0x125432B14ECEA2EBu},
+    {0x68CBC2B52F38395Cu, 0x1D53844EE47DD179u}, {0x53D6355DBF602DE3u, 0x177603725064A794u},
+    {0xA9782AB165E68B1Cu, 0x12C4CF8EA6B6EC76u}, {0x0F26AAB56FD744FAu, 0x1E07B27DD78B13F1u},
+    {0x3F52222ABFDF6A62u, 0x18062864AC6F4327u}, {0x65DB4E88997F884Eu, 0x1338205089F29C1Fu},
+    {0x6FC54A7428CC0D4Au, 0x1EC033B40FEA9365u}, {0x596AA1F68709A43Bu, 0x1899C2F673220F84u},
+    {0xADEEE7F86C07B696u, 0x13AE3591F5B4D936u}, {0x497E3FF3E00C5756u, 0x1F7D228322BAF524u},
+    {0xD464FFF64CD6AC45u, 0x1930E868E89590E9u}, {0x4383FFF83D7889D1u, 0x14272053ED4473EEu},
+    {0xCF9CCCC69793A174u, 0x101F4D0FF1038FF1u}, {0x7F6147A425B90252u, 0x19CBAE7FE805B31Cu},
+    {0xCC4DD2E9B7C7350Fu, 0x14A2F1FFECD15C16u}, {0x3D0B0F215FD290D9u, 0x10825B3323DAB012u},
+    {0x61AB4B689950E7C1u, 0x1A6A2B85062AB350u}, {0x4E22A2BA1440B967u, 0x1521BC6A6B555C40u},
+    {0x0B4EE894DD009453u, 0x10E7C9EEBC4449CDu}, {0x1217DA87C800ED51u, 0x1B0C764AC6D3A948u},
+    {0xDB46486CA000BDDAu, 0x15A391D56BDC876Cu}, {0x490506BD4CCD64AFu, 0x114FA7DDEFE39F8Au},
+    {0xA8080AC87AE23AB1u, 0x1BB2A62FE638FF43u}, {0x5339A239FBE82EF4u, 0x162884F31E93FF69u},
+    {0x75C7B4FB2FECF25Du, 0x11BA03F5B20FFF87u}, {0x22D92191E647EA2Eu, 0x1C5CD322B67FFF3Fu},
+    {0xB57A8141850654F2u, 0x16B0A8E891FFFF65u}, {0xC4620101373843F5u, 0x1226ED86DB3332B7u},
+    {0x3A366801F1F39FEEu, 0x1D0B15A491EB8459u}, {0xFB5EB99B27F6198Bu, 0x173C115074BC69E0u},
+    {0x2F7EFAE2865E7AD6u, 0x129674405D6387E7u}, {0xE597F7D0D6FD9156u, 0x1DBD86CD6238D971u},
+    {0x8479930D78CADAABu, 0x17CAD23DE82D7AC1u}, {0xD06142712D6F1556u, 0x1308A831868AC89Au},
+    {0x4D686A4EAF182222u, 0x1E74404F3DAADA91u}, {0xA453883EF279B4E8u, 0x185D003F6488AEDAu},
+    {0xE9DC6CFF28615D87u, 0x137D99CC506D58AEu}, {0xA960AE650D6895A4u, 0x1F2F5C7A1A488DE4u},
+    {0xBAB3BEB73DED4483u, 0x18F2B061AEA07183u}, {0x2EF6322C318A9D36u, 0x13F559E7BEE6C136u},
+    {0xE4BD1D13827761F0u, 0x1FEEF63F97D79B89u}, {0x83CA7DA9352C4E5Au, 0x198BF832DFDFAFA1u},
+    {0x9CA1FE20F756A515u, 0x146FF9C24CB2F2E7u}, {0x4A1B31B3F9121DAAu, 0x1059949B708F28B9u},
+    {0x435EB5ECC1B695DDu, 0x1A28EDC580E50DF5u}, {0x35E55E57015EDE4Au, 0x14ED8B04671DA4C4u},
+    {0xC4B77EAC0118B1D5u, 0x10BE08D0527E1D69u}, {0xA12597799B5AB622u, 0x1AC9A7B3B7302F0Fu},
+    {0x4DB7AC6149155E81u, 0x156E1FC2F8F358D9u}, {0xD7C6238107444B9Bu, 0x1124E63593F5E0ADu},
+    {0x593D059B3ED3AC2Bu, 0x1B6E3D2286563449u}, {0xE0FD9E15CBDC89BCu, 0x15F1CA820511C36Du},
+    {0xB3FE18116FE3A163u, 0x118E3B9B37416924u}, {0x866359B57FD29BD1u, 0x1C16C5C525357507u},
+    {0xD1E91491330EE30Eu, 0x16789E3750F790D2u}, {0x74BA76DA8F3F1C0Bu, 0x11FA182C40C60D75u},
+    {0xEDF72490E531C678u, 0x1CC359E067A348BBu}, {0x8B2C1D40B75B052Du, 0x1702AE4D1FB5D3C9u},
+    {0x6F567DCD5F7C0424u, 0x12688B70E62B0FD4u}, {0x7EF0C94898C66D06u, 0x1D74124E3D11B2EDu},
+    {0x98C0A106E09EBD9Fu, 0x17900EA4FDA7C257u}, {0x470080D24D4BCAE6u, 0x12D9A550CAEC9B79u},
+    {0xD800CE1D487944A2u, 0x1E29088144ADC58Eu}, {0x1333D8176D2DD082u, 0x1820D39A9D57D13Fu},
+    {0xA8F646792424A6CEu, 0x134D76154AACA765u}, {0x74BD3D8EA03AA47Du, 0x1EE25688777AA56Fu},
+    {0x5D64313EE6955064u, 0x18B51206C5FBB78Cu}, {0x4AB68DCBEBAAA6B7u, 0x13C40E6BD1962C70u},
+    {0x1124161312AAA457u, 0x1FA01712E8F0471Au}, {0xDA8344DC0EEEE9DFu, 0x194CDF4253F36C14u},
+    {0xE2029D7CD8BF2180u, 0x143D7F6843292343u}, {0x4E687DFD7A328133u, 0x103132B9CF541C36u},
+    {0x4A40C9959050CEB8u, 0x19E851294BB9C6BDu}, {0x0833D477A6A70BC6u, 0x14B9DA876FC7D231u},
+    {0xA02976C61EEC096Bu, 0x1094AED2BFD30E8Du}, {0x004257A364ACDBDFu, 0x1A877E1DFFB81749u},
+    {0xCD01DFB5EA23E319u, 0x153931B1996012A0u}, {0x70CE4C91881CB5AEu, 0x10FA8E27ADE6754Du},
+    {0x1AE3ADB5A69455E2u, 0x1B2A7D0C4970BBAFu}, {0x7BE957C4854377E8u, 0x15BB973D078D62F2u},
+    {0xC987796A0435F987u, 0x1162DF64060AB58Eu}, {0x75A58F1006BCC271u, 0x1BD1656CD67788E4u},
+    {0xF7B7A5A66BCA3527u, 0x16411DF0AB92D3E9u}, {0x5FC61E1EBCA1C41Fu, 0x11CDB18D560F0FEEu},
+    {0xFFA363646102D365u, 0x1C7C4F4889B1B316u}, {0x32E91C504D9BDC51u, 0x16C9D906D48E28DFu},
+    {0x8F20E37371497D0Eu, 0x123B140576D820B2u}, {0x7E9B0585820F2E7Cu, 0x1D2B533BF159CDEAu},
+    {0xCBAF379E01A5BECAu, 0x1755DC2FF447D7EEu}, {0x0958F94B348498A1u, 0x12AB168CC36CACBFu}
+};
+
+static const uint64_t string__pow5_split[326][2] = {
+    {0x0000000000000000u, 0x1000000000000000u}, {0x0000000000000000u, 0x1400000000000000u},
+    {0x0000000000000000u, 0x1900000000000000u}, {0x0000000000000000u, 0x1F40000000000000u},
+    {0x0000000000000000u, 0x1388000000000000u}, {0x0000000000000000u, 0x186A000000000000u},
+    {0x0000000000000000u, 0x1E84800000000000u}, {0x0000000000000000u, 0x1312D00000000000u},
+    {0x0000000000000000u, 0x17D7840000000000u}, {0x0000000000000000u, 0x1DCD650000000000u},
+    {0x0000000000000000u, 0x12A05F2000000000u}, {0x0000000000000000u, 0x174876E800000000u},
+    {0x0000000000000000u, 0x1D1A94A200000000u}, {0x0000000000000000u, 0x12309CE540000000u},
+    {0x0000000000000000u, 0x16BCC41E90000000u}, {0x0000000000000000u, 0x1C6BF52634000000u},
+    {0x0000000000000000u, 0x11C37937E0800000u}, {0x0000000000000000u, 0x16345785D8A00000u},
+    {0x0000000000000000u, 0x1BC16D674EC80000u}, {0x0000000000000000u, 0x1158E460913D0000u},
+    {0x0000000000000000u, 0x15AF1D78B58C4000u}, {0x0000000000000000u, 0x1B1AE4D6E2EF5000u},
+    {0x0000000000000000u, 0x10F0CF064DD59200u}, {0x0000000000000000u, 0x152D02C7E14AF680u},
+    {0x0000000000000000u, 0x1A784379D99DB420u}, {0x0000000000000000u, 0x108B2A2C28029094u},
+    {0x0000000000000000u, 0x14ADF4B7320334B9u}, {0x4000000000000000u, 0x19D971E4FE8401E7u},
+    {0x8800000000000000u, 0x1027E72F1F128130u}, {0xAA00000000000000u, 0x1431E0FAE6D7217Cu},
+    {0xD480000000000000u, 0x193E5939A08CE9DBu}, {0xC9A0000000000000u, 0x1F8DEF8808B02452u},
+    {0xBE04000000000000u, 0x13B8B5B5056E16B3u}, {0xAD85000000000000u, 0x18A6E32246C99C60u},
+    {0xD8E6400000000000u, 0x1ED09BEAD87C0378u}, {0x878FE80000000000u, 0x13426172C74D822Bu},
+    {0x6973E20000000000u, 0x1812F9CF7920E2B6u}, {0x03D0DA8000000000u, 0x1E17B84357691B64u},
+    {0x8262889000000000u, 0x12CED32A16A1B11Eu}, {0x22FB2AB400000000u, 0x178287F49C4A1D66u},
+    {0xABB9F56100000000u, 0x1D6329F1C35CA4BFu}, {0xCB54395CA0000000u, 0x125DFA371A19E6F7u},
+    {0xBE2947B3C8000000u, 0x16F578C4E0A060B5u}, {0x2DB399A0BA000000u, 0x1CB2D6F618C878E3u},
+    {0xFC90400474400000u, 0x11EFC659CF7D4B8Du}, {0x7BB4500591500000u, 0x166BB7F0435C9E71u},
+    {0xDAA16406F5A40000u, 0x1C06A5EC5433C60Du}, {0xA8A4DE8459868000u, 0x118427B3B4A05BC8u},
+    {0xD2CE16256FE82000u, 0x15E531A0A1C872BAu}, {0x87819BAECBE22800u, 0x1B5E7E08CA3A8F69u},
+    {0xF4B1014D3F6D5900u, 0x111B0EC57E6499A1u}, {0x71DD41A08F48AF40u, 0x1561D276DDFDC00Au},
+    {0x0E549208B31ADB10u, 0x1ABA4714957D300Du}, {0x28F4DB456FF0C8EAu, 0x10B46C6CDD6E3E08u},
+    {0x33321216CBECFB24u, 0x14E1878814C9CD8Au}, {0xBFFE969C7EE839EDu, 0x1A19E96A19FC40ECu},
+    {0xF7FF1E21CF512434u, 0x105031E2503DA893u}, {0xF5FEE5AA43256D41u, 0x14643E5AE44D12B8u},
+    {0x337E9F14D3EEC892u, 0x197D4DF19D605767u}, {0x005E46DA08EA7AB6u, 0x1FDCA16E04B86D41u},
+    {0xA03AEC4845928CB2u, 0x13E9E4E4C2F34448u}, {0xC849A75A56F72FDEu, 0x18E45E1DF3B0155Au},
+    {0x7A5C1130ECB4FBD6u, 0x1F1D75A5709C1AB1u}, {0xEC798ABE93F11D65u, 0x13726987666190AEu},
+    {0xA797ED6E38ED64BFu, 0x184F03E93FF9F4DAu}, {0x517DE8C9C728BDEFu, 0x1E62C4E38FF87211u},
+    {0xD2EEB17E1C7976B5u, 0x12FDBB0E39FB474Au}, {0x87AA5DDDA397D462u, 0x17BD29D1C87A191Du},
+    {0xE994F5550C7DC97Bu, 0x1DAC74463A989F64u}, {0x11FD195527CE9DEDu, 0x128BC8ABE49F639Fu},
+    {0xD67C5FAA71C24568u, 0x172EBAD6DDC73C86u}, {0x8C1B77950E32D6C2u, 0x1CFA698C95390BA8u},
+    {0x57912ABD28DFC639u, 0x121C81F7DD43A749u}, {0xAD75756C7317B7C8u, 0x16A3A275D494911Bu},
+    {0x98D2D2C78FDDA5BAu, 0x1C4C8B1349B9B562u}, {0x9F83C3BCB9EA8794u, 0x11AFD6EC0E14115Du},
+    {0x0764B4ABE8652979u, 0x161BCCA7119915B5u}, {0x493DE1D6E27E73D7u, 0x1BA2BFD0D5FF5B22u},
+    {0x6DC6AD264D8F0866u, 0x1145B7E285BF98F5u}, {0xC938586FE0F2CA80u, 0x159725DB272F7F32u},
+    {0x7B866E8BD92F7D20u, 0x1AFCEF51F0FB5EFFu}, {0xAD34051767BDAE34u, 0x10DE1593369D1B5Fu},
+    {0x9881065D41AD19C1u, 0x15159AF804446237u}, {0x7EA147F492186032u, 0x1A5B01B605557AC5u},
+    {0x6F24CCF8DB4F3C1Fu, 0x1078E111C3556CBBu}, {0x4AEE003712230B27u, 0x14971956342AC7EAu},
+    {0xDDA98044D6ABCDF0u, 0x19BCDFABC13579E4u}, {0x0A89F02B062B60B6u, 0x10160BCB58C16C2Fu},
+    {0xCD2C6C35C7B638E4u, 0x141B8EBE2EF1C73Au}, {0x8077874339A3C71Du, 0x1922726DBAAE3909u},
+    {0xE0956914080CB8E4u, 0x1F6B0F092959C74Bu}, {0x6C5D61AC8507F38Eu, 0x13A2E965B9D81C8Fu},
+    {0x4774BA17A649F072u, 0x188BA3BF284E23B3u}, {0x1951E89D8FDC6C8Fu, 0x1EAE8CAEF261ACA0u},
+    {0x0FD3316279E9C3D9u, 0x132D17ED577D0BE4u}, {0x13C7FDBB186434CFu, 0x17F85DE8AD5C4EDDu},
+    {0x58B9FD29DE7D4203u, 0x1DF67562D8B36294u}, {0xB7743E3A2B0E4942u, 0x12BA095DC7701D9Cu},
+    {0xE5514DC8B5D1DB92u, 0x17688BB5394C2503u}, {0xDEA5A13AE3465277u, 0x1D42AEA2879F2E44u},
+    {0x0B2784C4CE0BF38Au, 0x1249AD2594C37CEBu}, {0xCDF165F6018EF06Du, 0x16DC186EF9F45C25u},
+    {0x416DBF7381F2AC88u, 0x1C931E8AB871732Fu}, {0x88E497A83137ABD5u, 0x11DBF316B346E7FDu},
+    {0xEB1DBD923D8596CAu, 0x1652EFDC6018A1FCu}, {0x25E52CF6CCE6FC7Du, 0x1BE7ABD3781ECA7Cu},
+    {0x97AF3C1A40105DCEu, 0x1170CB642B133E8Du}, {0xFD9B0B20D0147542u, 0x15CCFE3D35D80E30u},
+    {0x3D01CDE904199292u, 0x1B403DCC834E11BDu}, {0x462120B1A28FFB9Bu, 0x1108269FD210CB16u},
+    {0xD7A968DE0B33FA82u, 0x154A3047C694FDDBu}, {0xCD93C3158E00F923u, 0x1A9CBC59B83A3D52u},
+    {0xC07C59ED78C09BB6u, 0x10A1F5B813246653u}, {0xB09B7068D6F0C2A3u, 0x14CA732617ED7FE8u},
+    {0xDCC24C830CACF34Cu, 0x19FD0FEF9DE8DFE2u}, {0xC9F96FD1E7EC180Fu, 0x103E29F5C2B18BEDu},
+    {0x3C77CBC661E71E13u, 0x144DB473335DEEE9u}, {0x8B95BEB7FA60E598u, 0x1961219000356AA3u},
+    {0x6E7B2E65F8F91EFEu, 0x1FB969F40042C54Cu}, {0xC50CFCFFBB9BB35Fu, 0x13D3E2388029BB4Fu},
+    {0xB6503C3FAA82A037u, 0x18C8DAC6A0342A23u}, {0xA3E44B4F95234844u, 0x1EFB1178484134ACu},
+    {0xE66EAF11BD360D2Bu, 0x135CEAEB2D28C0EBu}, {0xE00A5AD62C839075u, 0x183425A5F872F126u},
+    {0x980CF18BB7A47493u, 0x1E412F0F768FAD70u}, {0x5F0816F752C6C8DCu, 0x12E8BD69AA19CC66u},
+    {0xF6CA1CB527787B13u, 0x17A2ECC414A03F7Fu}, {0xF47CA3E2715699D7u, 0x1D8BA7F519C84F5Fu},
+    {0xF8CDE66D86D62026u, 0x127748F9301D319Bu}, {0xF7016008E88BA830u, 0x17151B377C247E02u},
+    {0xB4C1B80B22AE923Cu, 0x1CDA62055B2D9D83u}, {0x50F91306F5AD1B65u, 0x12087D4358FC8272u},
+    {0xE53757C8B318623Fu, 0x168A9C942F3BA30Eu}, {0x9E852DBADFDE7ACFu, 0x1C2D43B93B0A8BD2u},
+    {0xA3133C94CBEB0CC1u, 0x119C4A53C4E69763u}, {0x8BD80BB9FEE5CFF1u, 0x16035CE8B6203D3Cu},
+    {0xAECE0EA87E9F43EEu, 0x1B843422E3A84C8Bu}, {0x4D40C9294F238A75u, 0x1132A095CE492FD7u},
+    {0x2090FB73A2EC6D12u, 0x157F48BB41DB7BCDu}, {0x68B53A508BA78856u, 0x1ADF1AEA12525AC0u},
+    {0x417144725748B536u, 0x10CB70D24B7378B8u}, {0x51CD958EED1AE283u, 0x14FE4D06DE5056E6u},
+    {0xE640FAF2A8619B24u, 0x1A3DE04895E46C9Fu}, {0xEFE89CD7A93D00F7u, 0x1066AC2D5DAEC3E3u},
+    {0xEBE2C40D938C4134u, 0x14805738B51A74DCu}, {0x26DB7510F86F5181u, 0x19A06D06E2611214u},
+    {0x9849292A9B4592F1u, 0x100444244D7CAB4Cu}, {0xBE5B73754216F7ADu, 0x1405552D60DBD61Fu},
+    {0xADF25052929CB598u, 0x1906AA78B912CBA7u}, {0x996EE4673743E2FFu, 0x1F485516E7577E91u},
+    {0xFFE54EC0828A6DDFu, 0x138D352E5096AF1Au}, {0xBFDEA270A32D0957u, 0x18708279E4BC5AE1u},
+    {0x2FD64B0CCBF84BADu, 0x1E8CA3185DEB719Au}, {0x5DE5EEE7FF7B2F4Cu, 0x1317E5EF3AB32700u},
+    {0x755F6AA1FF59FB1Fu, 0x17DDDF6B095FF0C0u}, {0x92B7454A7F3079E7u, 0x1DD55745CBB7ECF0u},
+    {0x5BB28B4E8F7E4C30u, 0x12A5568B9F52F416u}, {0xF29F2E22335DDF3Cu, 0x174EAC2E8727B11Bu},
+    {0xEF46F9AAC035570Bu, 0x1D22573A28F19D62u}, {0xD58C5C0AB8215667u, 0x123576845997025Du},
+    {0x4AEF730D6629AC01u, 0x16C2D4256FFCC2F5u}, {0x9DAB4FD0BFB41701u, 0x1C73892ECBFBF3B2u},
+    {0xA28B11E277D08E60u, 0x11C835BD3F7D784Fu}, {0x8B2DD65B15C4B1F9u, 0x163A432C8F5CD663u},
+    {0x6DF94BF1DB35DE77u, 0x1BC8D3F7B3340BFCu}, {0xC4BBCF772901AB0Au, 0x115D847AD000877Du},
+    {0x35EAC354F34215CDu, 0x15B4E5998400A95Du}, {0x8365742A30129B40u, 0x1B221EFFE500D3B4u},
+    {0xD21F689A5E0BA108u, 0x10F5535FEF208450u}, {0x06A742C0F58E894Au, 0x1532A837EAE8A565u},
+    {0x4851137132F22B9Du, 0x1A7F5245E5A2CEBEu}, {0xED32AC26BFD75B42u, 0x108F936BAF85C136u},
+    {0xA87F57306FCD3212u, 0x14B378469B673184u}, {0xD29F2CFC8BC07E97u, 0x19E056584240FDE5u},
+    {0xA3A37C1DD7584F1Eu, 0x102C35F729689EAFu}, {0x8C8C5B254D2E62E6u, 0x14374374F3C2C65Bu},
+    {0x6FAF71EEA079FB9Fu, 0x1945145230B377F2u}, {0x0B9B4E6A48987A87u, 0x1F965966BCE055EFu},
+    {0x674111026D5F4C94u, 0x13BDF7E0360C35B5u}, {0xC111554308B71FBAu, 0x18AD75D8438F4322u},
+    {0x7155AA93CAE4E7A8u, 0x1ED8D34E547313EBu}, {0x26D58A9C5ECF10C9u, 0x13478410F4C7EC73u},
+    {0xF08AED437682D4FBu, 0x1819651531F9E78Fu}, {0xECADA89454238A3Au, 0x1E1FBE5A7E786173u},
+    {0x73EC895CB4963664u, 0x12D3D6F88F0B3CE8u}, {0x90E7ABB3E1BBC3FDu, 0x1788CCB6B2CE0C22u},
+    {0x352196A0DA2AB4FDu, 0x1D6AFFE45F818F2Bu}, {0x0134FE24885AB11Eu, 0x1262DFEEBBB0F97Bu},
+    {0xC1823DADAA715D65u, 0x16FB97EA6A9D37D9u}, {0x31E2CD19150DB4BFu, 0x1CBA7DE5054485D0u},
+    {0x1F2DC02FAD2890F7u, 0x11F48EAF234AD3A2u}, {0xA6F9303B9872B535u, 0x1671B25AEC1D888Au},
+    {0x50B77C4A7E8F6282u, 0x1C0E1EF1A724EAADu}, {0x5272ADAE8F199D91u, 0x1188D357087712ACu},
+    {0x670F591A32E004F6u, 0x15EB082CCA94D757u}, {0x40D32F60BF980633u, 0x1B65CA37FD3A0D2Du},
+    {0x4883FD9C77BF03E0u, 0x111F9E62FE44483Cu}, {0x5AA4FD0395AEC4D8u, 0x156785FBBDD55A4Bu},
+    {0x314E3C447B1A760Eu, 0x1AC1677AAD4AB0DEu}, {0xDED0E5AACCF089C9u, 0x10B8E0ACAC4EAE8Au},
+    {0x96851F15802CAC3Bu, 0x14E718D7D7625A2Du}, {0xFC2666DAE037D74Au, 0x1A20DF0DCD3AF0B8u},
+    {0x9D980048CC22E68Eu, 0x10548B68A044D673u}, {0x84FE005AFF2BA032u, 0x1469AE42C8560C10u},
+    {0xA63D8071BEF6883Eu, 0x198419D37A6B8F14u}, {0xCFCCE08E2EB42A4Eu, 0x1FE52048590672D9u},
+    {0x21E00C58DD309A70u, 0x13EF342D37A407C8u}, {0x2A580F6F147CC10Du, 0x18EB0138858D09BAu},
+    {0xB4EE134AD99BF150u, 0x1F25C186A6F04C28u}, {0x7114CC0EC80176D2u, 0x137798F428562F99u},
+    {0xCD59FF127A01D486u, 0x18557F31326BBB7Fu}, {0xC0B07ED7188249A8u, 0x1E6ADEFD7F06AA5Fu},
+    {0xD86E4F466F516E09u, 0x1302CB5E6F642A7Bu}, {0xCE89E3180B25C98Bu, 0x17C37E360B3D351Au},
+    {0x822C5BDE0DEF3BEEu, 0x1DB45DC38E0C8261u}, {0xF15BB96AC8B58575u, 0x1290BA9A38C7D17Cu},
+    {0x2DB2A7C57AE2E6D2u, 0x1734E940C6F9C5DCu}, {0x391F51B6D99BA086u, 0x1D022390F8B83753u},
+    {0x03B3931248014454u, 0x1221563A9B732294u}, {0x04A077D6DA019569u, 0x16A9ABC9424FEB39u},
+    {0x45C895CC9081FAC3u, 0x1C5416BB92E3E607u}, {0x8B9D5D9FDA513CBAu, 0x11B48E353BCE6FC4u},
+    {0xAE84B507D0E58BE8u, 0x1621B1C28AC20BB5u}, {0x1A25E249C51EEEE3u, 0x1BAA1E332D728EA3u},
+    {0xF057AD6E1B33554Du, 0x114A52DFFC679925u}, {0x6C6D98C9A2002AA1u, 0x159CE797FB817F6Fu},
+    {0x4788FEFC0A803549u, 0x1B04217DFA61DF4Bu}, {0x0CB59F5D8690214Eu, 0x10E294EEBC7D2B8Fu},
+    {0xCFE30734E83429A1u, 0x151B3A2A6B9C7672u}, {0x83DBC9022241340Au, 0x1A6208B50683940Fu},
+    {0xB2695DA15568C086u, 0x107D457124123C89u}, {0x1F03B509AAC2F0A7u, 0x149C96CD6D16CBACu},
+    {0x26C4A24C1573ACD1u, 0x19C3BC80C85C7E97u}, {0x783AE56F8D684C03u, 0x101A55D07D39CF1Eu},
+    {0x16499ECB70C25F03u, 0x1420EB449C8842E6u}, {0x9BDC067E4CF2F6C4u, 0x19292615C3AA539Fu},
+    {0x82D3081DE02FB476u, 0x1F736F9B3494E887u}, {0xB1C3E512AC1DD0C9u, 0x13A825C100DD1154u},
+    {0xDE34DE57572544FCu, 0x18922F31411455A9u}, {0x55C215ED2CEE963Bu, 0x1EB6BAFD91596B14u},
+    {0xB5994DB43C151DE5u, 0x133234DE7AD7E2ECu}, {0xE2FFA1214B1A655Eu, 0x17FEC216198DDBA7u},
+    {0xDBBF89699DE0FEB6u, 0x1DFE729B9FF15291u}, {0x2957B5E202AC9F31u, 0x12BF07A143F6D39Bu},
+    {0xF3ADA35A8357C6FEu, 0x176EC98994F48881u}, {0x70990C31242DB8BDu, 0x1D4A7BEBFA31AAA2u},
+    {0x865FA79EB69C9376u, 0x124E8D737C5F0AA5u}, {0xE7F791866443B854u, 0x16E230D05B76CD4Eu},
+    {0xA1F575E7FD54A669u, 0x1C9ABD04725480A2u}, {0xA53969B0FE54E801u, 0x11E0B622C774D065u},
+    {0x0E87C41D3DEA2202u, 0x1658E3AB7952047Fu}, {0xD229B5248D64AA82u, 0x1BEF1C9657A6859Eu},
+    {0x435A1136D85EEA91u, 0x117571DDF6C81383u}, {0x143095848E76A536u, 0x15D2CE55747A1864u},
+    {0x193CBAE5B2144E83u, 0x1B4781EAD1989E7Du}, {0x2FC5F4CF8F4CB112u, 0x110CB132C2FF630Eu},
+    {0xBBB77203731FDD56u, 0x154FDD7F73BF3BD1u}, {0x2AA54E844FE7D4ACu, 0x1AA3D4DF50AF0AC6u},
+    {0xDAA75112B1F0E4EBu, 0x10A6650B926D66BBu}, {0xD15125575E6D1E26u, 0x14CFFE4E7708C06Au},
+    {0x85A56EAD360865B0u, 0x1A03FDE214CAF085u}, {0x7387652C41C53F8Eu, 0x10427EAD4CFED653u},
+    {0x50693E7752368F71u, 0x14531E58A03E8BE8u}, {0x64838E1526C4334Eu, 0x1967E5EEC84E2EE2u},
+    {0xFDA4719A70754022u, 0x1FC1DF6A7A61BA9Au}, {0xDE86C70086494815u, 0x13D92BA28C7D14A0u},
+    {0x162878C0A7DB9A1Au, 0x18CF768B2F9C59C9u}, {0x5BB296F0D1D280A1u, 0x1F03542DFB83703Bu},
+    {0x194F9E5683239064u, 0x1362149CBD322625u}, {0x5FA385EC23EC747Eu, 0x183A99C3EC7EAFAEu},
+    {0xF78C67672CE7919Du, 0x1E494034E79E5B99u}, {0x3AB7C0A07C10BB02u, 0x12EDC82110C2F940u},
+    {0x4965B0C89B14E9C3u, 0x17A93A2954F3B790u}, {0x5BBF1CFAC1DA2433u, 0x1D9388B3AA30A574u},
+    {0xB957721CB92856A0u, 0x127C35704A5E6768u}, {0xE7AD4EA3E7726C48u, 0x171B42CC5CF60142u},
+    {0xA198A24CE14F075Au, 0x1CE2137F74338193u}, {0x44FF65700CD16498u, 0x120D4C2FA8A030FCu},
+    {0x563F3ECC1005BDBEu, 0x16909F3B92C83D3Bu}, {0x2BCF0E7F14072D2Eu, 0x1C34C70A777A4C8Au},
+    {0x5B61690F6C847C3Du, 0x11A0FC668AAC6FD6u}, {0xF239C35347A59B4Cu, 0x16093B802D578BCBu},
+    {0xEEC83428198F021Fu, 0x1B8B8A6038AD6EBEu}, {0x553D20990FF96153u, 0x1137367C236C6537u},
+    {0x2A8C68BF53F7B9A8u, 0x1585041B2C477E85u}, {0x752F82EF28F5A812u, 0x1AE64521F7595E26u},
+    {0x093DB1D57999890Bu, 0x10CFEB353A97DAD8u}, {0x0B8D1E4AD7FFEB4Eu, 0x1503E602893DD18Eu},
+    {0x8E7065DD8DFFE622u, 0x1A44DF832B8D45F1u}, {0xF9063FAA78BFEFD5u, 0x106B0BB1FB384BB6u},
+    {0xB747CF9516EFEBCAu, 0x1485CE9E7A065EA4u}, {0xE519C37A5CABE6BDu, 0x19A742461887F64Du},
+    {0xAF301A2C79EB7036u, 0x1008896BCF54F9F0u}, {0xDAFC20B798664C43u, 0x140AABC6C32A386Cu},
+    {0x11BB28E57E7FDF54u, 0x190D56B873F4C688u}, {0x1629F31EDE1FD72Au, 0x1F50AC6690F1F82Au},
+    {0x4DDA37F34AD3E67Au, 0x13926BC01A973B1Au}, {0xE150C5F01D88E019u, 0x187706B0213D09E0u},
+    {0x19A4F76C24EB181Fu, 0x1E94C85C298C4C59u}, {0xB0071AA39712EF13u, 0x131CFD3999F7AFB7u},
+    {0x9C08E14C7CD7AAD8u, 0x17E43C8800759BA5u}, {0x030B199F9C0D958Eu, 0x1DDD4BAA0093028Fu},
+    {0x61E6F003C1887D79u, 0x12AA4F4A405BE199u}, {0xBA60AC04B1EA9CD7u, 0x1754E31CD072D9FFu},
+    {0xA8F8D705DE65440Du, 0x1D2A1BE4048F907Fu}, {0xC99B8663AAFF4A88u, 0x123A516E82D9BA4Fu},
+    {0xBC0267FC95BF1D2Au, 0x16C8E5CA239028E3u}, {0xAB0301FBBB2EE474u, 0x1C7B1F3CAC74331Cu},
+    {0xEAE1E13D54FD4EC9u, 0x11CCF385EBC89FF1u}, {0x659A598CAA3CA27Bu, 0x1640306766BAC7EEu},
+    {0xFF00EFEFD4CBCB1Au, 0x1BD03C81406979E9u}, {0x3F6095F5E4FF5EF0u, 0x116225D0C841EC32u},
+    {0xCF38BB735E3F36ACu, 0x15BAAF44FA52673Eu}, {0x8306EA5035CF0457u, 0x1B295B1638E7010Eu},
+    {0x11E4527221A162B6u, 0x10F9D8EDE39060A9u}, {0x565D670EAA09BB64u, 0x15384F295C7478D3u},
+    {0x2BF4C0D2548C2A3Du, 0x1A8662F3B3919708u}, {0x1B78F88374D79A66u, 0x1093FDD8503AFE65u},
+    {0x625736A4520D8100u, 0x14B8FD4E6449BDFEu}, {0xFAED044D6690E140u, 0x19E73CA1FD5C2D7Du},
+    {0xBCD422B0601A8CC8u, 0x103085E53E599C6Eu}, {0x6C092B5C78212FFAu, 0x143CA75E8DF0038Au},
+    {0x070B763396297BF8u, 0x194BD136316C046Du}, {0x48CE53C07BB3DAF6u, 0x1F9EC583BDC70588u},
+    {0x2D80F4584D5068DAu, 0x13C33B72569C6375u}, {0x78E1316E60A48310u, 0x18B40A4EEC437C52u}
+};
+
+typedef struct string__decimal
+{
+    uint64_t mantissa;
+    int exponent;
+} string__decimal;
+
+static inline int string__pow5_bits(int e)       {return (int)(((uint32_t)e * 1217359) >> 19) + 1;}
+static inline unsigned int string__log10_pow2(int e) {return ((uint32_t)e * 78913) >> 18;}
+static inline unsigned int string__log10_pow5(int e) {return ((uint32_t)e * 732923) >> 20;}
+
+static inline bool string__multiple_of_pow5(uint64_t value, unsigned int p)
+{
+    unsigned int count = 0;
+
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        ++count;
+    }
+
+    return count >= p;
+}
+
+static inline bool string__multiple_of_pow2(uint64_t value, unsigned int p)
+{
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// (m * mul) >> j for a 128-bit <mul>, where 64 < j < 128
+static inline uint64_t string__mul_shift_64(uint64_t m, const uint64_t *mul, int j)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 b0 = (unsigned __int128)m * mul[0];
+    unsigned __int128 b2 = (unsigned __int128)m * mul[1];
+
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+#else
+    uint64_t a_lo = (uint32_t)m;
+    uint64_t a_hi = m >> 32;
+
+    // High half of m * mul[0]
+    uint64_t b_lo = (uint32_t)mul[0];
+    uint64_t b_hi = mul[0] >> 32;
+    uint64_t mid = a_hi * b_lo + ((a_lo * b_lo) >> 32);
+    uint64_t mid2 = a_lo * b_hi + (uint32_t)mid;
+    uint64_t high0 = a_hi * b_hi + (mid >> 32) + (mid2 >> 32);
+
+    // Full m * mul[1]
+    b_lo = (uint32_t)mul[1];
+    b_hi = mul[1] >> 32;
+    uint64_t b00 = a_lo * b_lo;
+    mid = a_hi * b_lo + (b00 >> 32);
+    mid2 = a_lo * b_hi + (uint32_t)mid;
+    uint64_t high1 = a_hi * b_hi + (mid >> 32) + (mid2 >> 32);
+    uint64_t low1 = (mid2 << 32) | (uint32_t)b00;
+
+    uint64_t sum = high0 + low1;
+    if (sum < high0) {++high1;}
+
+    int dist = j - 64;
+    return (high1 << (64 - dist)) | (sum >> dist);
+#endif
+}
+
+// Shortest decimal (mantissa * 10^exponent) that rounds back to the given finite, non-zero double
+static string__decimal string__d2d(uint64_t ieee_mantissa, unsigned int ieee_exponent)
+{
+    int e2;
+    uint64_t m2;
+
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (int)ieee_exponent - 1023 - 52 - 2;
+        m2 = (1ull << 52) | ieee_mantissa;
+    }
+
+    bool accept_bounds = (m2 & 1) == 0;
+
+    // The interval of decimals that round to this double is [mv - mm, mv + 2] / 4 * 2^e2
+    uint64_t mv = 4 * m2;
+    unsigned int mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int e10;
+    bool vm_is_trailing_zeros = false;
+    bool vr_is_trailing_zeros = false;
+
+    if (e2 >= 0)
+    {
+        unsigned int q = string__log10_pow2(e2) - (e2 > 3);
+        int k = 125 + string__pow5_bits((int)q) - 1;
+        int i = -e2 + (int)q + k;
+
+        e10 = (int)q;
+        vr = string__mul_shift_64(mv, string__pow5_inv_split[q], i);
+        vp = string__mul_shift_64(mv + 2, string__pow5_inv_split[q], i);
+        vm = string__mul_shift_64(mv - 1 - mm_shift, string__pow5_inv_split[q], i);
+
+        if (q <= 21)
+        {
+            if (mv % 5 == 0)       {vr_is_trailing_zeros = string__multiple_of_pow5(mv, q);}
+            else if (accept_bounds) {vm_is_trailing_zeros = string__multiple_of_pow5(mv - 1 - mm_shift, q);}
+            else                   {vp -= string__multiple_of_pow5(mv + 2, q);}
+        }
+    }
+    else
+    {
+        unsigned int q = string__log10_pow5(-e2) - (-e2 > 1);
+        int i = -e2 - (int)q;
+        int k = string__pow5_bits(i) - 125;
+        int j = (int)q - k;
+
+        e10 = (int)q + e2;
+        vr = string__mul_shift_64(mv, string__pow5_split[i], j);
+        vp = string__mul_shift_64(mv + 2, string__pow5_split[i], j);
+        vm = string__mul_shift_64(mv - 1 - mm_shift, string__pow5_split[i], j);
+
+        if (q <= 1)
+        {
+            vr_is_trailing_zeros = true;
+
+            if (accept_bounds) {vm_is_trailing_zeros = mm_shift == 1;}
+            else               {--vp;}
+        }
+        else if (q < 63)
+        {
+            vr_is_trailing_zeros = string__multiple_of_pow2(mv, q);
+        }
+    }
+
+    // Drop digits while the interval still holds a shorter decimal
+    int removed = 0;
+    unsigned int last_removed_digit = 0;
+    uint64_t output;
+
+    if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        while (vp / 10 > vm / 10)
+        {
+            vm_is_trailing_zeros &= vm % 10 == 0;
+            vr_is_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (unsigned int)(vr % 10);
+
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        if (vm_is_trailing_zeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vr_is_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (unsigned int)(vr % 10);
+
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+
+        // Exactly halfway rounds to even
+        if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {last_removed_digit = 4;}
+
+        output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else
+    {
+        bool round_up = false;
+
+        if (vp / 100 > vm / 100)
+        {
+            round_up = vr % 100 >= 50;
+
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+
+        while (vp / 10 > vm / 10)
+        {
+            round_up = vr % 10 >= 5;
+
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+
+        output = vr + (vr == vm || round_up);
+    }
+
+    string__decimal result;
+    result.mantissa = output;
+    result.exponent = e10 + removed;
+
+    return result;
+}
+
+// Shortest round-trip text of <value> into <buffer> (at least 32 bytes), returns the length
+static unsigned int string__write_double(char *buffer, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool sign = (bits >> 63) != 0;
+    uint64_t ieee_mantissa = bits & ((1ull << 52) - 1);
+    unsigned int ieee_exponent = (unsigned int)((bits >> 52) & 0x7FF);
+
+    char *ptr = buffer;
+
+    if (ieee_exponent == 0x7FF && ieee_mantissa != 0)
+    {
+        memcpy(buffer, "nan", 4);
+        return 3;
+    }
+
+    if (sign) {*ptr++ = '-';}
+
+    if (ieee_exponent == 0x7FF)
+    {
+        memcpy(ptr, "inf", 4);
+        return (unsigned int)(ptr - buffer) + 3;
+    }
+
+    if (ieee_exponent == 0 && ieee_mantissa == 0)
+    {
+        memcpy(ptr, "0", 2);
+        return (unsigned int)(ptr - buffer) + 1;
+    }
+
+    string__decimal decimal = string__d2d(ieee_mantissa, ieee_exponent);
+
+    char digits[24];
+    char *first = string__u64_digits(digits + sizeof(digits), decimal.mantissa);
+    int length_digits = (int)((digits + sizeof(digits)) - first);
+
+    // <value> is 0.<digits> * 10^point
+    int point = length_digits + decimal.exponent;
+
+    if (length_digits <= point && point <= 21)
+    {
+        memcpy(ptr, first, length_digits);
+        ptr += length_digits;
+
+        memset(ptr, '0', point - length_digits);
+        ptr += point - length_digits;
+    }
+    else if (0 < point && point <= 21)
+    {
+        memcpy(ptr, first, point);
+        ptr += point;
+
+        *ptr++ = '.';
+
+        memcpy(ptr, first + point, length_digits - point);
+        ptr += length_digits - point;
+    }
+    else if (-6 < point && point <= 0)
+    {
+        *ptr++ = '0';
+        *ptr++ = '.';
+
+        memset(ptr, '0', -point);
+        ptr += -point;
+
+        memcpy(ptr, first, length_digits);
+        ptr += length_digits;
+    }
+    else
+    {
+        *ptr++ = first[0];
+
+        if (length_digits > 1)
+        {
+            *ptr++ = '.';
+
+            memcpy(ptr, first + 1, length_digits - 1);
+            ptr += length_digits - 1;
+        }
+
+        int exponent = point - 1;
+
+        *ptr++ = 'e';
+        *ptr++ = exponent < 0 ? '-' : '+';
+
+        char exponent_digits[4];
+        char *exponent_first = string__u64_digits(exponent_digits + sizeof(exponent_digits), (uint64_t)(exponent < 0 ? -exponent : exponent));
+        size_t length_exponent = (exponent_digits + sizeof(exponent_digits)) - exponent_first;
+
+        memcpy(ptr, exponent_first, length_exponent);
+        ptr += length_exponent;
+    }
+
+    *ptr = '\0';
+    return (unsigned int)(ptr - buffer);
+}
+
+// Growable output buffer of the formatting engine
+typedef struct string__builder
+{
+    char *data;
+    size_t length;
+    size_t capacity;
+} string__builder;
+
+static STRING__THREAD_LOCAL string__builder string__format_buffer;
+
+static void string__builder_reserve(string__builder *builder, size_t extra)
+{
+    if (builder->length + extra + 1 <= builder->capacity) {return;}
+
+    size_t capacity = builder->capacity ? builder->capacity : 256;
+
+    while (capacity < builder->length + extra + 1)
+    {
+        capacity *= 2;
+    }
+
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    // The formatting buffer is kept between calls on purpose, so it stays off the books
+    if (builder == &string__format_buffer)
+    {
+        builder->data = (realloc)(builder->data, capacity);
+        builder->capacity = capacity;
+        return;
+    }
+#endif
+
+    builder->data = realloc(builder->data, capacity);
+    builder->capacity = capacity;
+}
+
+static inline void string__builder_append(string__builder *builder, const char *str, size_t length)
+{
+    string__builder_reserve(builder, length);
+
+    // <str> is NULL for an empty output of an earlier pipeline stage, which memcpy() may not be given
+    if (length == 0) {return;}
+
+    memcpy(builder->data + builder->length, str, length);
+    builder->length += length;
+}
+
+static inline void string__builder_fill(string__builder *builder, char c, size_t amount)
+{
+    string__builder_reserve(builder, amount);
+
+    memset(builder->data + builder->length, c, amount);
+    builder->length += amount;
+}
+
+// Parsed "%[flags][width][.precision]" of one conversion
+typedef struct string__spec
+{
+    bool left;
+    bool plus;
+    bool space;
+    bool alt;
+    bool zero;
+    size_t width;
+    int precision;  // -1 if not given
+} string__spec;
+
+static void string__emit_padded(string__builder *builder, const string__spec *spec, const char *prefix, size_t length_prefix, const char *digits, size_t length_digits, bool numeric)
+{
+    size_t zeros = 0;
+
+    if (numeric && spec->precision >= 0 && (size_t)spec->precision > length_digits)
+    {
+        zeros = spec->precision - length_digits;
+    }
+
+    size_t length_body = length_prefix + zeros + length_digits;
+    size_t pad = spec->width > length_body ? spec->width - length_body : 0;
+
+    if (numeric && spec->zero && !spec->left && spec->precision < 0)
+    {
+        zeros += pad;
+        pad = 0;
+    }
+
+    string__builder_reserve(builder, length_body + pad + zeros);
+
+    if (!spec->left) {string__builder_fill(builder, ' ', pad);}
+
+    string__builder_append(builder, prefix, length_prefix);
+    string__builder_fill(builder, '0', zeros);
+    string__builder_append(builder, digits, length_digits);
+
+    if (spec->left) {string__builder_fill(builder, ' ', pad);}
+}
+
+enum
+{
+    STRING__LENGTH_NONE, STRING__LENGTH_HH, STRING__LENGTH_H, STRING__LENGTH_L, STRING__LENGTH_LL,
+    STRING__LENGTH_J, STRING__LENGTH_Z, STRING__LENGTH_T, STRING__LENGTH_LONG_DOUBLE
+};
+
+/*
+    printf-compatible formatting in a single pass into <builder>.
+    Integers, characters and strings are converted here; floating point, pointers
+    and wide characters are handed one at a time to snprintf.
+*/
+static void string__vformat(string__builder *builder, const char *format, va_list args)
+{
+    const char *ptr = format;
+
+    while (*ptr)
+    {
+        // Copy the literal run up to the next conversion in one go
+        const char *percent = strchr(ptr, '%');
+        size_t length_literal = percent ? (size_t)(percent - ptr) : strlen(ptr);
+
+        string__builder_append(builder, ptr, length_literal);
+        ptr += length_literal;
+
+        if (!percent) {break;}
+
+        const char *start = ptr++;
+
+        string__spec spec = {false, false, false, false, false, 0, -1};
+
+        for (;; ++ptr)
+        {
+            if      (*ptr == '-') {spec.left = true;}
+            else if (*ptr == '+') {spec.plus = true;}
+            else if (*ptr == ' ') {spec.space = true;}
+            else if (*ptr == '#') {spec.alt = true;}
+            else if (*ptr == '0') {spec.zero = true;}
+            else {break;}
+        }
+
+        if (*ptr == '*')
+        {
+            int width = va_arg(args, int);
+
+            if (width < 0) {spec.left = true; width = -width;}
+
+            spec.width = (size_t)width;
+            ++ptr;
+        }
+        else
+        {
+            while (*ptr >= '0' && *ptr <= '9') {spec.width = spec.width * 10 + (*ptr++ - '0');}
+        }
+
+        if (*ptr == '.')
+        {
+            ++ptr;
+
+            if (*ptr == '*')
+            {
+                int precision = va_arg(args, int);
+
+                spec.precision = precision < 0 ? -1 : precision;
+                ++ptr;
+            }
+            else
+            {
+                spec.precision = 0;
+                while (*ptr >= '0' && *ptr <= '9') {spec.precision = spec.precision * 10 + (*ptr++ - '0');}
+            }
+        }
+
+        int length = STRING__LENGTH_NONE;
+
+        switch (*ptr)
+        {
+            case 'h': length = (ptr[1] == 'h') ? STRING__LENGTH_HH : STRING__LENGTH_H; ptr += (ptr[1] == 'h') ? 2 : 1; break;
+            case 'l': length = (ptr[1] == 'l') ? STRING__LENGTH_LL : STRING__LENGTH_L; ptr += (ptr[1] == 'l') ? 2 : 1; break;
+            case 'j': length = STRING__LENGTH_J; ++ptr; break;
+            case 'z': length = STRING__LENGTH_Z; ++ptr; break;
+            case 't': length = STRING__LENGTH_T; ++ptr; break;
+            case 'L': length = STRING__LENGTH_LONG_DOUBLE; ++ptr; break;
+            default: break;
+        }
+
+        char conversion = *ptr;
+
+        if (conversion == '\0')
+        {
+            string__builder_append(builder, start, ptr - start);
+            break;
+        }
+
+        ++ptr;
+
+        char digits[72];
+        char *end = digits + sizeof(digits);
+
+        switch (conversion)
+        {
+            case '%':
+            {
+                string__builder_append(builder, "%", 1);
+            } break;
+
+            case 'd':
+            case 'i':
+            {
+                long long value;
+
+                switch (length)
+                {
+                    case STRING__LENGTH_HH: value = (signed char)va_arg(args, int); break;
+                    case STRING__LENGTH_H:  value = (short)va_arg(args, int); break;
+                    case STRING__LENGTH_L:  value = va_arg(args, long); break;
+                    case STRING__LENGTH_LL: value = va_arg(args, long long); break;
+                    case STRING__LENGTH_J:  value = (long long)va_arg(args, intmax_t); break;
+                    case STRING__LENGTH_Z:
+                    case STRING__LENGTH_T:  value = (long long)va_arg(args, ptrdiff_t); break;
+                    default:                value = va_arg(args, int); break;
+                }
+
+                uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+                char *first = (magnitude == 0 && spec.precision == 0) ? end : string__u64_digits(end, magnitude);
+                const char *sign = value < 0 ? "-" : spec.plus ? "+" : spec.space ? " " : "";
+
+                string__emit_padded(builder, &spec, sign, strlen(sign), first, end - first, true);
+            } break;
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            {
+                uint64_t value;
+
+                switch (length)
+                {
+                    case STRING__LENGTH_HH: value = (unsigned char)va_arg(args, unsigned int); break;
+                    case STRING__LENGTH_H:  value = (unsigned short)va_arg(args, unsigned int); break;
+                    case STRING__LENGTH_L:  value = va_arg(args, unsigned long); break;
+                    case STRING__LENGTH_LL: value = va_arg(args, unsigned long long); break;
+                    case STRING__LENGTH_J:  value = (uint64_t)va_arg(args, uintmax_t); break;
+                    case STRING__LENGTH_Z:
+                    case STRING__LENGTH_T:  value = va_arg(args, size_t); break;
+                    default:                value = va_arg(args, unsigned int); break;
+                }
+
+                char *first = end;
+                const char *prefix = "";
+
+                if (!(value == 0 && spec.precision == 0))
+                {
+                    if (conversion == 'u')
+                    {
+                        first = string__u64_digits(end, value);
+                    }
+                    else if (conversion == 'o')
+                    {
+                        do {*--first = (char)('0' + (value & 7)); value >>= 3;} while (value);
+                    }
+                    else
+                    {
+                        const char *hex = (conversion == 'x') ? "0123456789abcdef" : "0123456789ABCDEF";
+
+                        if (spec.alt && value != 0) {prefix = (conversion == 'x') ? "0x" : "0X";}
+
+                        do {*--first = hex[value & 15]; value >>= 4;} while (value);
+                    }
+                }
+
+                // "#" on octal only guarantees a leading zero
+                if (conversion == 'o' && spec.alt && (first == end || first[0] != '0') && spec.precision <= (int)(end - first))
+                {
+                    prefix = "0";
+                }
+
+                string__emit_padded(builder, &spec, prefix, strlen(prefix), first, end - first, true);
+            } break;
+
+            case 'c':
+            {
+                if (length == STRING__LENGTH_L) {goto fallback;}
+
+                char c = (char)va_arg(args, int);
+
+                string__emit_padded(builder, &spec, "", 0, &c, 1, false);
+            } break;
+
+            case 's':
+            {
+                if (length == STRING__LENGTH_L) {goto fallback;}
+
+                const char *str = va_arg(args, const char *);
+                if (!str) {str = "(null)";}
+
+                size_t length_str;
+
+                if (spec.precision >= 0)
+                {
+                    const char *nul = memchr(str, '\0', spec.precision);
+                    length_str = nul ? (size_t)(nul - str) : (size_t)spec.precision;
+                }
+                else
+                {
+                    length_str = strlen(str);
+                }
+
+                string__emit_padded(builder, &spec, "", 0, str, length_str, false);
+            } break;
+
+            case 'n':
+            {
+                switch (length)
+                {
+                    case STRING__LENGTH_HH: *va_arg(args, signed char *) = (signed char)builder->length; break;
+                    case STRING__LENGTH_H:  *va_arg(args, short *) = (short)builder->length; break;
+                    case STRING__LENGTH_L:  *va_arg(args, long *) = (long)builder->length; break;
+                    case STRING__LENGTH_LL: *va_arg(args, long long *) = (long long)builder->length; break;
+                    case STRING__LENGTH_J:  *va_arg(args, intmax_t *) = (intmax_t)builder->length; break;
+                    case STRING__LENGTH_Z:  *va_arg(args, size_t *) = builder->length; break;
+                    case STRING__LENGTH_T:  *va_arg(args, ptrdiff_t *) = (ptrdiff_t)builder->length; break;
+                    default:                *va_arg(args, int *) = (int)builder->length; break;
+                }
+            } break;
+
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': case 'p':
+            fallback:
+            {
+                // Rebuild the conversion with '*' resolved, then let snprintf do just this one
+                char spec_str[64];
+                int length_spec = snprintf(spec_str, sizeof(spec_str), "%%%s%s%s%s%s%zu",
+                    spec.left ? "-" : "", spec.plus ? "+" : "", spec.space ? " " : "", spec.alt ? "#" : "", spec.zero ? "0" : "", spec.width);
+
+                if (spec.precision >= 0)
+                {
+                    length_spec += snprintf(spec_str + length_spec, sizeof(spec_str) - length_spec, ".%d", spec.precision);
+                }
+
+                if (length == STRING__LENGTH_L)           {spec_str[length_spec++] = 'l';}
+                if (length == STRING__LENGTH_LONG_DOUBLE) {spec_str[length_spec++] = 'L';}
+
+                spec_str[length_spec++] = conversion;
+                spec_str[length_spec] = '\0';
+
+                #define STRING__FORMAT_ONE(value)                                                                       \
+                    do {                                                                                                \
+                        string__builder_reserve(builder, 64);                                                           \
+                        int written = snprintf(builder->data + builder->length, builder->capacity - builder->length, spec_str, value); \
+                        if (written < 0) {break;}                                                                       \
+                        if ((size_t)written >= builder->capacity - builder->length)                                     \
+                        {                                                                                               \
+                            string__builder_reserve(builder, written);                                                  \
+                            snprintf(builder->data + builder->length, builder->capacity - builder->length, spec_str, value); \
+                        }                                                                                               \
+                        builder->length += written;                                                                     \
+                    } while (0)
+
+                if (conversion == 'p')
+                {
+                    void *value = va_arg(args, void *);
+                    STRING__FORMAT_ONE(value);
+                }
+                else if (conversion == 'c')
+                {
+                    wint_t value = va_arg(args, wint_t);
+                    STRING__FORMAT_ONE(value);
+                }
+                else if (conversion == 's')
+                {
+                    wchar_t *value = va_arg(args, wchar_t *);
+                    STRING__FORMAT_ONE(value);
+                }
+                else if (length == STRING__LENGTH_LONG_DOUBLE)
+                {
+                    long double value = va_arg(args, long double);
+                    STRING__FORMAT_ONE(value);
+                }
+                else
+                {
+                    double value = va_arg(args, double);
+                    STRING__FORMAT_ONE(value);
+                }
+
+                #undef STRING__FORMAT_ONE
+            } break;
+
+            default:
+            {
+                // Unknown conversion, keep it as written
+                string__builder_append(builder, start, ptr - start);
+            } break;
+        }
+    }
+
+    string__builder_reserve(builder, 0);
+    builder->data[builder->length] = '\0';
+}
+
+/*
+char *string_format(char *str, ...)
+
+returns:
+    > <str> formatted with extra arguments
+    > needs to be freed!
+    > NULL if invalid <str>
+
+example:
+    > string_format("Hello %s", "World") -> "Hello World"
+*/
+char *string_format(char *str, ...)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    va_list args;
+
+    va_start(args, str);
+    char *output = string_vformat(str, args);
+    va_end(args);
+
+    return output;
+}
+
+/*
+char *string_vformat(char *str, va_list args)
+
+returns:
+    > <str> formatted with <args>
+    > needs to be freed!
+    > NULL if invalid <str>
+
+example:
+    > string_vformat("Hello %s", args) -> "Hello World"
+*/
+char *string_vformat(char *str, va_list args)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    // Formats once into this thread's buffer, then copies out exactly what was written
+    string__builder *builder = &string__format_buffer;
+    builder->length = 0;
+
+    string__vformat(builder, str, args);
+
+    char *output = malloc(builder->length + 1);
+
+    memcpy(output, builder->data, builder->length + 1);
+
+    return output;
+}
+
+/*
+void string_format_release(void)
+
+frees:
+    > the formatting buffer of the calling thread (it is recreated on demand)
+*/
+void string_format_release(void)
+{
+    (free)(string__format_buffer.data);
+
+    string__format_buffer.data = NULL;
+    string__format_buffer.length = 0;
+    string__format_buffer.capacity = 0;
+}
+
+/*
+unsigned int string_write_int(char *buffer, long long value)
+
+returns:
+    > the length of <value> written in decimal to <buffer> (at least 21 bytes)
+    > 0 if invalid <buffer>
+
+example:
+    > string_write_int(buffer, -1024) -> 5 ("-1024")
+*/
+unsigned int string_write_int(char *buffer, long long value)
+{
+    if (!buffer) {return 0;}
+
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *first = string__u64_digits(end, value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value);
+
+    if (value < 0) {*--first = '-';}
+
+    size_t length_buf = end - first;
+
+    memcpy(buffer, first, length_buf);
+    buffer[length_buf] = '\0';
+
+    return (unsigned int)length_buf;
+}
+
+/*
+unsigned int string_write_uint(char *buffer, unsigned long long value)
+
+returns:
+    > the length of <value> written in decimal to <buffer> (at least 21 bytes)
+    > 0 if invalid <buffer>
+
+example:
+    > string_write_uint(buffer, 1024) -> 4 ("1024")
+*/
+unsigned int string_write_uint(char *buffer, unsigned long long value)
+{
+    if (!buffer) {return 0;}
+
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *first = string__u64_digits(end, value);
+
+    size_t length_buf = end - first;
+
+    memcpy(buffer, first, length_buf);
+    buffer[length_buf] = '\0';
+
+    return (unsigned int)length_buf;
+}
+
+/*
+unsigned int string_write_double(char *buffer, double value)
+
+returns:
+    > the length of the shortest text that reads back as exactly <value>,
+      written to <buffer> (at least 32 bytes)
+    > 0 if invalid <buffer>
+
+example:
+    > string_write_double(buffer, 0.1)    -> 3 ("0.1")
+    > string_write_double(buffer, 1e100)  -> 6 ("1e+100")
+*/
+unsigned int string_write_double(char *buffer, double value)
+{
+    if (!buffer) {return 0;}
+
+    return string__write_double(buffer, value);
+}
+
+/*
+char *string_from_int(long long value)
+
+returns:
+    > <value> in decimal
+    > needs to be freed!
+
+example:
+    > string_from_int(-1024) -> "-1024"
+*/
+char *string_from_int(long long value)
+{
+    STRING__TRACK_PUBLIC();
+
+    char buffer[24];
+    unsigned int length_buf = string_write_int(buffer, value);
+
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, buffer, length_buf + 1);
+
+    return output;
+}
+
+/*
+char *string_from_double(double value)
+
+returns:
+    > the shortest text that reads back as exactly <value>
+    > needs to be freed!
+
+example:
+    > string_from_double(0.1 + 0.2) -> "0.30000000000000004"
+*/
+char *string_from_double(double value)
+{
+    STRING__TRACK_PUBLIC();
+
+    char buffer[32];
+    unsigned int length_buf = string__write_double(buffer, value);
+
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, buffer, length_buf + 1);
+
+    return output;
+}
+
+//---------|
+// Slicing |
+//---------|
+
+/*
+char *string_slice(char *str, unsigned int start, unsigned int end)
+
+returns:
+    > <str> sliced from <start> to <end> (inclusive)
+    > needs to be freed!
+    > NULL if invalid <str>, or <end> is not inside <str>
+
+example:
+    > string_slice("Hello World", 0, 4) -> "Hello"
+                    ^---^
+*/
+char *string_slice(char *str, unsigned int start, unsigned int end)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (start > end || length_str == 0 || length_str <= end) {return NULL;}
+
+    size_t length_buf = (size_t)(end - start) + 1;
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str + start, length_buf);
+    
+    output[length_buf] = '\0';
+    return output;
+}
+
+//---------|
+// Cutting |
+//---------|
+
+/*
+char *string_cut_left(char *str, unsigned int amount)
+
+returns:
+    > <str> with <amount> sliced off from the left
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_cut_left("Hello World", 5) -> " World"
+                       ----^
+*/
+char *string_cut_left(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str < amount) {return NULL;}
+
+    size_t length_buf = length_str - amount;
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str + amount, length_buf);
+
+    output[length_buf] = '\0';
+
+    return output;
+}
+
+/*
+char *string_cut_right(char *str, unsigned int amount)
+
+returns:
+    > <str> with <amount> sliced off from the right
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_cut_right("Hello World", 5) -> "Hello "
+                              ^----
+*/
+char *string_cut_right(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str < amount) {return NULL;}
+
+    size_t length_buf = length_str - amount;
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str, length_buf);
+
+    output[length_buf] = '\0';
+
+    return output;
+}
+
+/*
+char **string_split(char *str, char *delimiter)
+
+returns:
+    > an array containing contents of <str> split at any of the characters in <delimiter>
+      (like strtok(), empty tokens are skipped; see string_split_substr() to split at a
+      whole substring), ending with NULL
+    > NULL if invalid <str> or <delimiter>, or if <str> has no tokens
+    > needs to be freed! (free(array[0]) for the strings, then free(array))
+
+example:
+    > string_split("Hello World", " ") -> {"Hello", "World"}
+*/
+
+char **string_split(char *str, char *delimiter)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !delimiter) {return NULL;}
+
+    // Leading delimiters are left out of the copy, so the first token is where it starts
+    str += strspn(str, delimiter);
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(delimiter);
+
+    if (length_str == 0 || length_sub == 0) {return NULL;}
+
+    unsigned int count = 0;
+
+    for (char *ptr = str; *ptr; ++count)
+    {
+        ptr += strcspn(ptr, delimiter);
+        ptr += strspn(ptr, delimiter);
+    }
+
+    char *copy = malloc(length_str + 1);
+    memcpy(copy, str, length_str + 1);
+
+    char **output = malloc(sizeof(char*) * (count + 1));
+
+    unsigned int i = 0;
+    char *token = strtok(copy, delimiter);
+
+    while (token != NULL)
+    {
+        output[i++] = token;
+        token = strtok(NULL, delimiter);
+    }
+
+    output[count] = NULL;
+
+    return output;
+}
+
+//----------|
+// Trimming |
+//----------|
+
+/*
+char *string_trim_left(char *str, char *substr)
+
+returns:
+    > <str> with <substr> trimmed from the left
+    > NULL if invalid <str>
+
+example:
+    > string_trim_left("Hello World", "Hello ") -> "World"
+                        ^-----
+*/
+char *string_trim_left(char *str, char *substr)
+{
+    if (!str)       {return NULL;}
+    if (!substr)    {return str;}
+
+    return strncmp(str, substr, strlen(substr)) == 0 ? str + strlen(substr) : str;
+
+}
+
+/* 
+char *string_trim_right(char *str, char *substr)
+
+returns:
+    > <str> with <substr> trimmed from the right
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_trim_right("Hello World", " World") -> "Hello"
+                              ^-----
+*/
+char *string_trim_right(char *str, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str)       {return NULL;}
+    if (!substr)    {return str;}
+    
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_sub <= length_str && strncmp(str + (length_str - length_sub), substr, length_sub) == 0)
+    {
+        size_t length_buf = length_str - length_sub;
+
+        char *output = malloc(length_buf + 1);
+
+        memcpy(output, str, length_buf);
+        output[length_buf] = '\0';
+
+        return output;
+    }
+    else
+    {
+        return str;
+    }
+}
+
+//----------|
+// Removing |
+//----------|
+
+/*
+char *string_remove(char *str, char *substr)
+
+returns:
+    > <str> with first occurence of <substr> removed
+    > NULL if invalid <str> or <substr>
+    > needs to be freed!
+
+example:
+    > string_remove("Hello There World", "There") -> "Hello  World"
+                           ^---^
+*/
+char *string_remove(char *str, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str)       {return NULL;}
+    if (!substr)    {return str;}
+
+    size_t length_str = strlen(str);
+
+    // Find position of substr  
+    int pos = -1;
+
+    if (length_str > 0)
+    {
+        const char *ptr = str;
+
+        ptr = strstr(ptr, substr);
+    
+        if (ptr != NULL)
+        {
+            pos = ptr - str;
+        }
+    }
+
+    if (pos == -1) {return str;}
+
+    // Remove substring
+    size_t length_sub = strlen(substr);
+    size_t length_buf = length_str - length_sub;
+
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str, pos);
+    memcpy(output + pos, str + pos + length_sub, length_buf - pos);
+
+    output[length_buf] = '\0';
+
+    return output;
+}
+
+char *string_remove_all(char *str, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str)       {return NULL;}
+    if (!substr)    {return str;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_sub == 0) {return str;}
+
+    size_t count = 0;
+    
+    {
+        size_t pos = 0;
+        size_t match;
+
+        while ((match = string__find(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+        {
+            pos += match + length_sub;
+            ++count;
+        }
+    }
+
+    if (count == 0) {return str;}
+
+    size_t length_buf = length_str - (length_sub * count);
+
+    size_t pos_str = 0;
+    size_t pos_out = 0;
+    char *output = malloc(length_buf + 1);
+
+    // One pass, copying what lies between the matches
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length_copy = string__find(str + pos_str, length_str - pos_str, substr, length_sub);
+        
+        memcpy(output + pos_out, str + pos_str, length_copy);
+        pos_out += length_copy;
+        pos_str += length_copy + length_sub;
+    }
+
+    memcpy(output + pos_out, str + pos_str, length_str - pos_str);
+
+    output[length_buf] = '\0';
+    return output;
+}
+
+//----------|
+// Shifting |
+//----------|
+
+/*
+char *string_shift_left(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of letters to the left
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_shift_left("abcdefg", 3) -> "defgabc"
+                         <<^
+*/
+char *string_shift_left(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str == 0) {return str;}
+
+    amount = amount % length_str;
+
+    if (amount == 0) {return str;}
+
+    char *output = malloc(length_str + 1);
+
+    memcpy(output, str + amount, length_str - amount);
+    memcpy(output + (length_str - amount), str, amount);
+
+    output[length_str] = '\0';
+
+    return output;
+}
+
+/*
+char *string_shift_right(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of letters to the right
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_shift_right("abcdefg", 3) -> "efgabcd"
+                              ^>>
+*/
+char *string_shift_right(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str == 0) {return str;}
+
+    amount = amount % length_str;
+
+    if (amount == 0) {return str;}
+
+    char *output = malloc(length_str + 1);
+
+    memcpy(output, str + (length_str - amount), amount);
+    memcpy(output + amount, str, length_str - amount);
+
+    output[length_str] = '\0';
+
+    return output;
+}
+
+/*
+char *string_shift_left_in_place(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of letters to the left, without allocating
+    > NULL if invalid <str>
+
+example:
+    > string_shift_left_in_place(buffer, 3) -> "defgabc" (buffer was "abcdefg")
+*/
+char *string_shift_left_in_place(char *str, unsigned int amount)
+{
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str == 0) {return str;}
+
+    size_t pos = amount % length_str;
+
+    if (pos == 0) {return str;}
+
+    // Rotation by triple reversal: (AB)' = B'A' and reversing each part back gives BA
+    string__reverse_bytes((unsigned char *)str, pos);
+    string__reverse_bytes((unsigned char *)str + pos, length_str - pos);
+    string__reverse_bytes((unsigned char *)str, length_str);
+
+    return str;
+}
+
+/*
+char *string_shift_right_in_place(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of letters to the right, without allocating
+    > NULL if invalid <str>
+
+example:
+    > string_shift_right_in_place(buffer, 3) -> "efgabcd" (buffer was "abcdefg")
+*/
+char *string_shift_right_in_place(char *str, unsigned int amount)
+{
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str == 0) {return str;}
+
+    size_t pos = amount % length_str;
+
+    if (pos == 0) {return str;}
+
+    string__reverse_bytes((unsigned char *)str, length_str - pos);
+    string__reverse_bytes((unsigned char *)str + (length_str - pos), pos);
+    string__reverse_bytes((unsigned char *)str, length_str);
+
+    return str;
+}
+
+//----------------|
+// Capitalization |
+//----------------|
+
+/*
+char *string_upper(char *str) 
+
+returns:
+    > <str> with upper case letters
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_upper("Hello World") -> "HELLO WORLD"
+*/
+char *string_upper(char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    char *output = malloc(length_str + 1);
+
+    for (size_t i = 0; i < length_str; ++i)
+    {
+        output[i] = (char)toupper((unsigned char)str[i]);
+    }
+
+    output[length_str] = '\0';
+
+    return output;
+}
+
+/*
+char *string_lower(char *str)
+
+returns:
+    > <str> with lower case letters
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_lower("HELLO WORLD") -> "hello world"
+*/
+char *string_lower(char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    char *output = malloc(length_str + 1);
+
+    for (size_t i = 0; i < length_str; ++i)
+    {
+        output[i] = (char)tolower((unsigned char)str[i]);
+    }
+
+    output[length_str] = '\0';
+
+    return output;
+}
+
+//-----------|
+// Replacing |
+//-----------|
+
+/*
+char *string_replace(char *str, char *substr, char *replacement)
+
+returns:
+    > <str> with first occurence of <substr> replaced with <replacement>
+    > NULL if invalid <str> or <substr>
+    > needs to be freed!
+
+example:
+    > string_replace("Hello Hello World", "Hello", "Bye") -> "Bye Hello World"
+                      ^---^
+*/
+char *string_replace(char *str, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !substr)    {return NULL;}
+    if (!replacement)       {return str;}
+
+    size_t length_buf;
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    char *ptr = strstr(str, substr);
+
+    if (ptr == NULL) 
+    {
+        return str;
+    }
+
+    size_t pos = (ptr - str);
+
+    if (length_sub < length_rep)
+    {
+        length_buf = length_str + (length_rep - length_sub);
+    }
+    else
+    {
+        length_buf = length_str - (length_sub - length_rep);
+    }
+
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str, pos);
+    memcpy(output + pos, replacement, length_rep);
+    memcpy(output + pos + length_rep, str + pos + length_sub, length_str - pos - length_sub);
+
+    output[length_buf] = '\0';
+
+    return output;
+}
+
+/*
+char *string_replace_all(char *str, char *substr, char *replacement)
+
+returns:
+    > <str> with every occurence of <substr> replaced with <replacement>
+    > NULL if invalid <str> or <substr>
+    > needs to be freed!
+
+example:
+    > string_replace_all("Hello Hello World", "Hello", "Bye") -> "Bye Bye World"
+                          ^---^ ^---^
+*/
+char *string_replace_all(char *str, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !substr)    {return NULL;}
+    if (!replacement)       {return str;}
+
+    size_t length_buf;
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    size_t count = 0;
+    
+    {
+        size_t pos = 0;
+        size_t match;
+
+        while ((match = string__find(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+        {
+            pos += match + length_sub;
+            ++count;
+        }
+    }
+
+    if (count == 0) {return str;}
+
+    if (length_sub < length_rep)
+    {
+        length_buf = length_str + ((length_rep - length_sub) * count);
+    }
+    else
+    {
+        length_buf = length_str - ((length_sub - length_rep) * count); // Change (Don't make buffer unnecessarily large)
+    }
+
+    size_t pos_str = 0;
+    size_t pos_out = 0;
+    char *output = malloc(length_buf + 1);
+
+    // One pass, copying what lies before each match and then the replacement
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length_copy = string__find(str + pos_str, length_str - pos_str, substr, length_sub);
+        
+        memcpy(output + pos_out, str + pos_str, length_copy);
+        pos_out += length_copy;
+        pos_str += length_copy;
+
+        memcpy(output + pos_out, replacement, length_rep);
+        pos_out += length_rep;
+        pos_str += length_sub;
+    }
+
+    memcpy(output + pos_out, str + pos_str, length_str - pos_str);
+
+    output[length_buf] = '\0';
+    return output;
+}
+
+//-----------|
+// Inserting |
+//-----------|
+
+/*
+char *string_insert(char *str, char *substr, unsigned int index)
+
+returns:
+    > <str> with <substr> inserted at <index>
+    > NULL if invalid <str>, or <index> is past the end of <str>
+    > needs to be freed!
+
+example:
+    > string_insert("Hello World", "There ", 6) -> "Hello There World"
+                           ^
+*/
+char *string_insert(char *str, char *substr, unsigned int index)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str)       {return NULL;}
+    if (!substr)    {return str;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t length_buf = length_str + length_sub;
+
+    if (index > length_str) {return NULL;}
+
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str, index);
+    memcpy(output + index, substr, length_sub);
+    memcpy(output + index + length_sub, str + index, length_str - index);
+
+    output[length_buf] = '\0';
+
+    return output;
+}
+
+//-----------|
+// Reversing |
+//-----------|
+
+/*
+char *string_reverse(char *str)
+
+returns:
+    > <str> reversed
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_reverse("Hello World") -> "dlroW olleH"
+*/
+char *string_reverse(char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    char *output = malloc(length_str + 1);
+
+    string__reverse_copy((unsigned char *)output, (const unsigned char *)str, length_str);
+
+    output[length_str] = '\0';
+
+    return output;
+}
+
+/*
+char *string_reverse_in_place(char *str)
+
+returns:
+    > <str> reversed, without allocating
+    > NULL if invalid <str>
+
+example:
+    > string_reverse_in_place(buffer) -> "dlroW olleH" (buffer was "Hello World")
+*/
+char *string_reverse_in_place(char *str)
+{
+    if (!str) {return NULL;}
+
+    string__reverse_bytes((unsigned char *)str, strlen(str));
+
+    return str;
+}
+
+//---------|
+// Getting |
+//---------|
+
+/*
+char *string_before(char *str, char *substr)
+
+returns:
+    > returns the string before <substr> in <str>
+    > NULL if invalid <str> or <substr>, or if <substr> wasn't found
+    > needs to be freed!
+
+example:
+    > string_before("Hello There World", "There") -> "Hello "
+*/
+char *string_before(char *str, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string_span_copy(string_span_before(str, substr));
+}
+
+/*
+char *string_after(char *str, char *substr)
+
+returns:
+    > returns the string after <substr> in <str>
+    > NULL if invalid <str> or <substr>, or if <substr> wasn't found
+    > needs to be freed!
+
+example:
+    > string_after("Hello There World", "There") -> " World"
+*/
+char *string_after(char *str, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string_span_copy(string_span_after(str, substr));
+}
+
+/*
+char *string_between(char *str, char *a, char *b)
+
+returns:
+    > returns the string between <a> and the first <b> after it in <str>
+    > NULL if invalid <str>, <a> or <b>, or if either wasn't found
+    > needs to be freed!
+
+example:
+    > string_between("Hello There World", "Hello", "World") -> " There "
+    > string_between("x=1; y=2;", "y=", ";")                -> "2"
+*/
+char *string_between(char *str, char *a, char *b)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string_span_copy(string_span_between(str, a, b));
+}
+
+//-------|
+// Spans |
+//-------|
+
+/*
+StringSpan string_span(char *str)
+
+returns:
+    > a span over all of <str>
+    > an empty span if invalid <str>
+
+example:
+    > string_span("Hello") -> {"Hello", 5}
+*/
+StringSpan string_span(char *str)
+{
+    StringSpan span = {str, str ? strlen(str) : 0};
+
+    return span;
+}
+
+/*
+StringSpan string_span_slice(char *str, unsigned int start, unsigned int end)
+
+returns:
+    > a span over <str> from <start> to <end> (inclusive), see string_slice()
+    > an empty span if invalid <str> or out of range
+
+example:
+    > string_span_slice("Hello World", 6, 10) -> {"World", 5}
+*/
+StringSpan string_span_slice(char *str, unsigned int start, unsigned int end)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str || start > end || end >= strlen(str)) {return span;}
+
+    span.data = str + start;
+    span.length = (size_t)(end - start) + 1;
+
+    return span;
+}
+
+/*
+StringSpan string_span_cut_left(char *str, unsigned int amount)
+
+returns:
+    > a span over <str> with <amount> cut off from the left, see string_cut_left()
+    > an empty span if invalid <str> or <amount> is larger than <str>
+
+example:
+    > string_span_cut_left("Hello World", 5) -> {" World", 6}
+*/
+StringSpan string_span_cut_left(char *str, unsigned int amount)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str) {return span;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str < amount) {return span;}
+
+    span.data = str + amount;
+    span.length = length_str - amount;
+
+    return span;
+}
+
+/*
+StringSpan string_span_cut_right(char *str, unsigned int amount)
+
+returns:
+    > a span over <str> with <amount> cut off from the right, see string_cut_right()
+    > an empty span if invalid <str> or <amount> is larger than <str>
+
+example:
+    > string_span_cut_right("Hello World", 5) -> {"Hello ", 6}
+*/
+StringSpan string_span_cut_right(char *str, unsigned int amount)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str) {return span;}
+
+    size_t length_str = strlen(str);
+
+    if (length_str < amount) {return span;}
+
+    span.data = str;
+    span.length = length_str - amount;
+
+    return span;
+}
+
+/*
+StringSpan string_span_trim_left(char *str, char *substr)
+
+returns:
+    > a span over <str> without <substr> at its start (if it starts with it)
+    > an empty span if invalid <str>
+
+example:
+    > string_span_trim_left("Hello World", "Hello ") -> {"World", 5}
+*/
+StringSpan string_span_trim_left(char *str, char *substr)
+{
+    StringSpan span = string_span(str);
+
+    if (!str || !substr) {return span;}
+
+    size_t length_sub = strlen(substr);
+
+    if (length_sub <= span.length && memcmp(str, substr, length_sub) == 0)
+    {
+        span.data += length_sub;
+        span.length -= length_sub;
+    }
+
+    return span;
+}
+
+/*
+StringSpan string_span_trim_right(char *str, char *substr)
+
+returns:
+    > a span over <str> without <substr> at its end (if it ends with it)
+    > an empty span if invalid <str>
+
+example:
+    > string_span_trim_right("Hello World", " World") -> {"Hello", 5}
+*/
+StringSpan string_span_trim_right(char *str, char *substr)
+{
+    StringSpan span = string_span(str);
+
+    if (!str || !substr) {return span;}
+
+    size_t length_sub = strlen(substr);
+
+    if (length_sub <= span.length && memcmp(str + span.length - length_sub, substr, length_sub) == 0)
+    {
+        span.length -= length_sub;
+    }
+
+    return span;
+}
+
+/*
+StringSpan string_span_before(char *str, char *substr)
+
+returns:
+    > a span over the part of <str> before the first <substr>
+    > an empty span if invalid <str> or <substr>, or if <substr> wasn't found
+
+example:
+    > string_span_before("Hello There World", "There") -> {"Hello ", 6}
+*/
+StringSpan string_span_before(char *str, char *substr)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str || !substr) {return span;}
+
+    size_t pos = string__find(str, strlen(str), substr, strlen(substr));
+
+    if (pos == (size_t)-1) {return span;}
+
+    span.data = str;
+    span.length = pos;
+
+    return span;
+}
+
+/*
+StringSpan string_span_after(char *str, char *substr)
+
+returns:
+    > a span over the part of <str> after the first <substr>
+    > an empty span if invalid <str> or <substr>, or if <substr> wasn't found
+
+example:
+    > string_span_after("Hello There World", "There") -> {" World", 6}
+*/
+StringSpan string_span_after(char *str, char *substr)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str || !substr) {return span;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t pos = string__find(str, length_str, substr, length_sub);
+
+    if (pos == (size_t)-1) {return span;}
+
+    span.data = str + pos + length_sub;
+    span.length = length_str - pos - length_sub;
+
+    return span;
+}
+
+/*
+StringSpan string_span_between(char *str, char *a, char *b)
+
+returns:
+    > a span over the part of <str> between the first <a> and the first <b> after it
+    > an empty span if invalid <str>, <a> or <b>, or if either wasn't found
+
+example:
+    > string_span_between("id=7;name=zed;", "name=", ";") -> {"zed", 3}
+*/
+StringSpan string_span_between(char *str, char *a, char *b)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!str || !a || !b) {return span;}
+
+    size_t length_str = strlen(str);
+    size_t length_a = strlen(a);
+    size_t pos_a = string__find(str, length_str, a, length_a);
+
+    if (pos_a == (size_t)-1) {return span;}
+
+    size_t start = pos_a + length_a;
+    size_t pos_b = string__find(str + start, length_str - start, b, strlen(b));
+
+    if (pos_b == (size_t)-1) {return span;}
+
+    span.data = str + start;
+    span.length = pos_b;
+
+    return span;
+}
+
+/*
+bool string_span_equals(StringSpan span, char *str)
+
+returns:
+    > true if <span> holds exactly <str>
+    > false if not or invalid <str>
+
+example:
+    > string_span_equals(string_span_after("key=value", "="), "value") -> true
+*/
+bool string_span_equals(StringSpan span, char *str)
+{
+    if (!str) {return false;}
+
+    return strlen(str) == span.length && (span.length == 0 || memcmp(span.data, str, span.length) == 0);
+}
+
+/*
+char *string_span_copy(StringSpan span)
+
+returns:
+    > <span> copied into a new NUL terminated string
+    > NULL if <span> is empty and has no data
+    > needs to be freed!
+
+example:
+    > string_span_copy(string_span_slice("Hello World", 0, 4)) -> "Hello"
+*/
+char *string_span_copy(StringSpan span)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!span.data) {return NULL;}
+
+    char *output = malloc(span.length + 1);
+
+    memcpy(output, span.data, span.length);
+    output[span.length] = '\0';
+
+    return output;
+}
+
+//-------|
+// UTF-8 |
+//-------|
+
+// Lead bytes are every byte outside 0x80..0xBF, i.e. signed greater than (char)0xBF
+#define STRING__UTF8_IS_LEAD(c) (((unsigned char)(c) & 0xC0) != 0x80)
+
+#ifndef ZSTRING_SSSE3
+static bool string__utf8_valid_scalar(const unsigned char *s, size_t length)
+{
+    size_t i = 0;
+
+    while (i < length)
+    {
+#ifdef ZSTRING_SSE2
+        // Skip whole blocks of ASCII
+        while (i + 16 <= length && _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i))) == 0)
+        {
+            i += 16;
+        }
+
+        if (i >= length) {break;}
+#endif
+        unsigned char c = s[i];
+
+        if (c < 0x80) {++i; continue;}
+
+        size_t n;
+        unsigned int cp;
+
+        if      (c >= 0xC2 && c <= 0xDF) {n = 1; cp = c & 0x1F;}
+        else if ((c & 0xF0) == 0xE0)     {n = 2; cp = c & 0x0F;}
+        else if (c >= 0xF0 && c <= 0xF4) {n = 3; cp = c & 0x07;}
+        else {return false;}
+
+        if (length - i <= n) {return false;}
+
+        for (size_t k = 1; k <= n; ++k)
+        {
+            if ((s[i + k] & 0xC0) != 0x80) {return false;}
+            cp = (cp << 6) | (s[i + k] & 0x3F);
+        }
+
+        if (n == 2 && (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))) {return false;}
+        if (n == 3 && (cp < 0x10000 || cp > 0x10FFFF))                {return false;}
+
+        i += n + 1;
+    }
+
+    return true;
+}
+#endif
+
+#ifdef ZSTRING_SSSE3
+/*
+    Flags every invalid pair of adjacent bytes with three nibble lookups, plus
+    a check that 3rd/4th bytes of long sequences are continuations.
+    See Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+*/
+static inline __m128i string__utf8_check_block(__m128i input, __m128i prev_input)
+{
+    enum
+    {
+        TOO_SHORT = 1 << 0, TOO_LONG = 1 << 1, OVERLONG_3 = 1 << 2, TOO_LARGE = 1 << 3,
+        SURROGATE = 1 << 4, OVERLONG_2 = 1 << 5, TOO_LARGE_1000 = 1 << 6, OVERLONG_4 = 1 << 6,
+        TWO_CONTS = 1 << 7, CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS
+    };
+
+    static const unsigned char table_1_high[16] = {
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+    };
+
+    static const unsigned char table_1_low[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000
+    };
+
+    static const unsigned char table_2_high[16] = {
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+    };
+
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+    __m128i byte_1_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)table_1_high), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte_1_low  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)table_1_low), _mm_and_si128(prev1, nibble));
+    __m128i byte_2_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)table_2_high), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+
+    __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    __m128i third  = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 1)));
+    __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 1)));
+    __m128i must23 = _mm_cmpgt_epi8(_mm_or_si128(third, fourth), _mm_setzero_si128());
+
+    return _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char)0x80)), special);
+}
+#endif
+
+static size_t string__utf8_count(const unsigned char *s, size_t length)
+{
+    size_t i = 0;
+    size_t count = 0;
+
+#ifdef ZSTRING_SSE2
+    const __m128i continuation = _mm_set1_epi8((char)0xBF);
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(s + i));
+        count += string__popcount((unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(block, continuation)));
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        count += STRING__UTF8_IS_LEAD(s[i]);
+    }
+
+    return count;
+}
+
+/*
+    Byte offset of codepoint number <index> in <s>.
+    <length> if <s> has exactly <index> codepoints, (size_t)-1 if it has fewer.
+*/
+static size_t string__utf8_offset(const unsigned char *s, size_t length, size_t index)
+{
+    size_t i = 0;
+    size_t seen = 0;
+
+#ifdef ZSTRING_SSE2
+    const __m128i continuation = _mm_set1_epi8((char)0xBF);
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(s + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(block, continuation));
+        unsigned int n = string__popcount(mask);
+
+        if (seen + n > index)
+        {
+            for (size_t k = index - seen; k > 0; --k) {mask &= mask - 1;}
+            return i + string__ctz(mask);
+        }
+
+        seen += n;
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        if (STRING__UTF8_IS_LEAD(s[i]))
+        {
+            if (seen == index) {return i;}
+            ++seen;
+        }
+    }
+
+    return (seen == index) ? length : (size_t)-1;
+}
+
+/*
+    Byte offset at which the last <amount> codepoints of <s> start,
+    (size_t)-1 if <s> has fewer than <amount> codepoints.
+*/
+static size_t string__utf8_offset_back(const unsigned char *s, size_t length, size_t amount)
+{
+    if (amount == 0) {return length;}
+
+    size_t i = length;
+    size_t seen = 0;
+
+#ifdef ZSTRING_SSE2
+    const __m128i continuation = _mm_set1_epi8((char)0xBF);
+
+    for (; i >= 16; i -= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(s + i - 16));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(block, continuation));
+        unsigned int n = string__popcount(mask);
+
+        if (seen + n >= amount)
+        {
+            for (size_t k = n - (amount - seen); k > 0; --k) {mask &= mask - 1;}
+            return (i - 16) + string__ctz(mask);
+        }
+
+        seen += n;
+    }
+#endif
+
+    while (i > 0)
+    {
+        --i;
+
+        if (STRING__UTF8_IS_LEAD(s[i]) && ++seen == amount) {return i;}
+    }
+
+    return (size_t)-1;
+}
+
+/*
+bool string_utf8_valid(char *str)
+
+returns:
+    > true if <str> is well-formed UTF-8
+      (no overlongs, surrogates, truncated sequences or codepoints above U+10FFFF)
+
+example:
+    > string_utf8_valid("Hej Verden")   -> true
+    > string_utf8_valid("Bl\xC3\xA5")   -> true
+    > string_utf8_valid("Bl\xC3")       -> false
+*/
+bool string_utf8_valid(char *str)
+{
+    if (!str) {return false;}
+
+    const unsigned char *s = (const unsigned char *)str;
+    size_t length_str = strlen(str);
+
+#ifdef ZSTRING_SSSE3
+    static const unsigned char max_value[16] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+
+    const __m128i max = _mm_loadu_si128((const __m128i *)max_value);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 16 <= length_str; i += 16)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i *)(s + i));
+
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = _mm_setzero_si128();
+        }
+        else
+        {
+            error = _mm_or_si128(error, string__utf8_check_block(input, prev));
+            prev_incomplete = _mm_subs_epu8(input, max);
+        }
+
+        prev = input;
+    }
+
+    // The zero padding acts as ASCII, so a truncated final sequence is caught here
+    unsigned char tail[16] = {0};
+    memcpy(tail, s + i, length_str - i);
+
+    __m128i input = _mm_loadu_si128((const __m128i *)tail);
+    error = _mm_or_si128(error, string__utf8_check_block(input, prev));
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+#else
+    return string__utf8_valid_scalar(s, length_str);
+#endif
+}
+
+/*
+unsigned int string_utf8_length(char *str)
+
+returns:
+    > the amount of codepoints in <str>
+    > 0 if invalid <str>
+
+example:
+    > string_utf8_length("Bl\xC3\xA5b\xC3\xA6r") -> 6 ("Blåbær")
+*/
+unsigned int string_utf8_length(char *str)
+{
+    if (!str) {return 0;}
+
+    return (unsigned int)string__utf8_count((const unsigned char *)str, strlen(str));
+}
+
+//---------------|
+// UTF-8 Slicing |
+//---------------|
+
+/*
+char *string_utf8_slice(char *str, unsigned int start, unsigned int end)
+
+returns:
+    > <str> sliced from codepoint <start> to codepoint <end> (inclusive)
+    > NULL if invalid <str>, <start> or <end>
+    > needs to be freed!
+
+example:
+    > string_utf8_slice("Bl\xC3\xA5b\xC3\xA6r", 2, 4) -> "åbæ"
+                            ^-------------^
+*/
+char *string_utf8_slice(char *str, unsigned int start, unsigned int end)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || start > end) {return NULL;}
+
+    const unsigned char *s = (const unsigned char *)str;
+    size_t length_str = strlen(str);
+
+    size_t begin = string__utf8_offset(s, length_str, start);
+    if (begin == (size_t)-1 || begin == length_str) {return NULL;}
+
+    // In size_t, as (end - start) + 1 wraps to 0 for an <end> of UINT_MAX
+    size_t stop = string__utf8_offset(s + begin, length_str - begin, (size_t)(end - start) + 1);
+    if (stop == (size_t)-1) {return NULL;}
+
+    size_t length_buf = stop;
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str + begin, length_buf);
+
+    output[length_buf] = '\0';
+    return output;
+}
+
+/*
+char *string_utf8_cut_left(char *str, unsigned int amount)
+
+returns:
+    > <str> with <amount> codepoints sliced off from the left
+    > NULL if invalid <str> or <str> has less than <amount> codepoints
+    > needs to be freed!
+
+example:
+    > string_utf8_cut_left("\xC3\x86bler", 2) -> "ler" ("Æbler")
+*/
+char *string_utf8_cut_left(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t pos = string__utf8_offset((const unsigned char *)str, length_str, amount);
+
+    if (pos == (size_t)-1) {return NULL;}
+
+    size_t length_buf = length_str - pos;
+    char *output = malloc(length_buf + 1);
+
+    memcpy(output, str + pos, length_buf);
+
+    output[length_buf] = '\0';
+    return output;
+}
+
+/*
+char *string_utf8_cut_right(char *str, unsigned int amount)
+
+returns:
+    > <str> with <amount> codepoints sliced off from the right
+    > NULL if invalid <str> or <str> has less than <amount> codepoints
+    > needs to be freed!
+
+example:
+    > string_utf8_cut_right("Bl\xC3\xA5b\xC3\xA6r", 3) -> "Blå"
+*/
+char *string_utf8_cut_right(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t pos = string__utf8_offset_back((const unsigned char *)str, length_str, amount);
+
+    if (pos == (size_t)-1) {return NULL;}
+
+    char *output = malloc(pos + 1);
+
+    memcpy(output, str, pos);
+
+    output[pos] = '\0';
+    return output;
+}
+
+/*
+char *string_utf8_shift_left(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of codepoints to the left
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_utf8_shift_left("\xC3\xA6\xC3\xB8\xC3\xA5abc", 2) -> "åabcæø"
+*/
+char *string_utf8_shift_left(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    const unsigned char *s = (const unsigned char *)str;
+    size_t length_str = strlen(str);
+    size_t count = string__utf8_count(s, length_str);
+
+    // No shift at all still gives a copy, so the result can always be freed
+    size_t shift = (count > 0) ? amount % count : 0;
+    size_t pos = (shift > 0) ? string__utf8_offset(s, length_str, shift) : 0;
+
+    char *output = malloc(length_str + 1);
+
+    memcpy(output, str + pos, length_str - pos);
+    memcpy(output + (length_str - pos), str, pos);
+
+    output[length_str] = '\0';
+    return output;
+}
+
+/*
+char *string_utf8_shift_right(char *str, unsigned int amount)
+
+returns:
+    > <str> shifted <amount> of codepoints to the right
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_utf8_shift_right("abc\xC3\xA6\xC3\xB8\xC3\xA5", 2) -> "øåabcæ"
+*/
+char *string_utf8_shift_right(char *str, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    const unsigned char *s = (const unsigned char *)str;
+    size_t length_str = strlen(str);
+    size_t count = string__utf8_count(s, length_str);
+
+    // No shift at all still gives a copy, so the result can always be freed
+    size_t shift = (count > 0) ? amount % count : 0;
+    size_t pos = (shift > 0) ? string__utf8_offset_back(s, length_str, shift) : 0;
+
+    char *output = malloc(length_str + 1);
+
+    memcpy(output, str + pos, length_str - pos);
+    memcpy(output + (length_str - pos), str, pos);
+
+    output[length_str] = '\0';
+    return output;
+}
+
+/*
+char *string_utf8_reverse(char *str)
+
+returns:
+    > <str> with its codepoints in reverse order
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_utf8_reverse("Bl\xC3\xA5b\xC3\xA6r") -> "ræbålB"
+*/
+char *string_utf8_reverse(char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    unsigned char *output = malloc(length_str + 1);
+
+    string__reverse_copy(output, (const unsigned char *)str, length_str);
+
+    // Multibyte sequences now read "continuations..., lead", so flip each one back
+    size_t i = 0;
+
+    while (i < length_str)
+    {
+#ifdef ZSTRING_SSE2
+        while (i + 16 <= length_str && _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(output + i))) == 0)
+        {
+            i += 16;
+        }
+
+        if (i >= length_str) {break;}
+#endif
+        if (output[i] < 0x80) {++i; continue;}
+
+        size_t j = i;
+        while (j < length_str && !STRING__UTF8_IS_LEAD(output[j])) {++j;}
+
+        if (j < length_str && output[j] >= 0xC0)
+        {
+            for (size_t a = i, b = j; a < b; ++a, --b)
+            {
+                unsigned char tmp = output[a];
+                output[a] = output[b];
+                output[b] = tmp;
+            }
+
+            ++j;
+        }
+
+        i = j;
+    }
+
+    output[length_str] = '\0';
+    return (char *)output;
+}
+
+//---------|
+// Columns |
+//---------|
+
+// The two allocations every column operation makes
+static StringColumn string__column_alloc(size_t count, size_t length_buf)
+{
+    StringColumn column;
+
+    column.data = malloc(length_buf + 1);
+    column.offsets = malloc(sizeof(size_t) * (count + 1));
+    column.count = count;
+
+    column.offsets[0] = 0;
+
+    return column;
+}
+
+// Copies string <i> of <column> minus <skip_left> and <skip_right> bytes, returns bytes written
+static inline size_t string__column_copy_range(StringColumn column, size_t i, size_t skip_left, size_t skip_right, char *out)
+{
+    size_t length = (column.offsets[i + 1] - column.offsets[i]) - skip_left - skip_right;
+
+    memcpy(out, column.data + column.offsets[i] + skip_left, length);
+
+    return length;
+}
+
+/*
+StringColumn string_column_from_array(char **strings, size_t count)
+
+returns:
+    > a column holding copies of the <count> strings in <strings>
+    > an empty column if invalid <strings>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_from_array((char *[]){"Foo", "Bar"}, 2) -> data "FooBar", offsets {0, 3, 6}
+*/
+StringColumn string_column_from_array(char **strings, size_t count)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringColumn output = {0};
+
+    if (!strings) {return output;}
+
+    size_t length_buf = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        length_buf += strings[i] ? strlen(strings[i]) : 0;
+    }
+
+    output = string__column_alloc(count, length_buf);
+
+    size_t pos_out = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length_str = strings[i] ? strlen(strings[i]) : 0;
+
+        if (length_str > 0)
+        {
+            memcpy(output.data + pos_out, strings[i], length_str);
+            pos_out += length_str;
+        }
+
+        output.offsets[i + 1] = pos_out;
+    }
+
+    output.data[pos_out] = '\0';
+    return output;
+}
+
+static StringColumn string__column_case(StringColumn column, bool upper)
+{
+    StringColumn output = {0};
+
+    if (!column.data || !column.offsets) {return output;}
+
+    size_t base = column.offsets[0];
+    size_t length_buf = column.offsets[column.count] - base;
+
+    output = string__column_alloc(column.count, length_buf);
+
+    // Every string keeps its length, so the whole buffer is mapped in one pass
+    string__ascii_case((unsigned char *)output.data, (const unsigned char *)column.data + base, length_buf, upper);
+
+    for (size_t i = 0; i <= column.count; ++i)
+    {
+        output.offsets[i] = column.offsets[i] - base;
+    }
+
+    output.data[length_buf] = '\0';
+    return output;
+}
+
+/*
+StringColumn string_column_upper(StringColumn column)
+
+returns:
+    > every string of <column> with upper case (ASCII) letters
+    > an empty column if invalid <column>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_upper({"Foo", "bar"}) -> {"FOO", "BAR"}
+*/
+StringColumn string_column_upper(StringColumn column)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__column_case(column, true);
+}
+
+/*
+StringColumn string_column_lower(StringColumn column)
+
+returns:
+    > every string of <column> with lower case (ASCII) letters
+    > an empty column if invalid <column>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_lower({"Foo", "BAR"}) -> {"foo", "bar"}
+*/
+StringColumn string_column_lower(StringColumn column)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__column_case(column, false);
+}
+
+/*
+StringColumn string_column_trim_left(StringColumn column, char *substr)
+
+returns:
+    > every string of <column> with <substr> trimmed from the left
+    > an empty column if invalid <column> or <substr>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_trim_left({"Mr. Foo", "Bar"}, "Mr. ") -> {"Foo", "Bar"}
+*/
+StringColumn string_column_trim_left(StringColumn column, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringColumn output = {0};
+
+    if (!column.data || !column.offsets || !substr) {return output;}
+
+    size_t length_sub = strlen(substr);
+
+    output = string__column_alloc(column.count, column.offsets[column.count] - column.offsets[0]);
+
+    size_t pos_out = 0;
+
+    for (size_t i = 0; i < column.count; ++i)
+    {
+        size_t length_str = column.offsets[i + 1] - column.offsets[i];
+        bool match = length_str >= length_sub && memcmp(column.data + column.offsets[i], substr, length_sub) == 0;
+
+        pos_out += string__column_copy_range(column, i, match ? length_sub : 0, 0, output.data + pos_out);
+        output.offsets[i + 1] = pos_out;
+    }
+
+    output.data[pos_out] = '\0';
+    return output;
+}
+
+/*
+StringColumn string_column_trim_right(StringColumn column, char *substr)
+
+returns:
+    > every string of <column> with <substr> trimmed from the right
+    > an empty column if invalid <column> or <substr>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_trim_right({"Foo\r", "Bar"}, "\r") -> {"Foo", "Bar"}
+*/
+StringColumn string_column_trim_right(StringColumn column, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringColumn output = {0};
+
+    if (!column.data || !column.offsets || !substr) {return output;}
+
+    size_t length_sub = strlen(substr);
+
+    output = string__column_alloc(column.count, column.offsets[column.count] - column.offsets[0]);
+
+    size_t pos_out = 0;
+
+    for (size_t i = 0; i < column.count; ++i)
+    {
+        size_t length_str = column.offsets[i + 1] - column.offsets[i];
+        bool match = length_str >= length_sub && memcmp(column.data + column.offsets[i + 1] - length_sub, substr, length_sub) == 0;
+
+        pos_out += string__column_copy_range(column, i, 0, match ? length_sub : 0, output.data + pos_out);
+        output.offsets[i + 1] = pos_out;
+    }
+
+    output.data[pos_out] = '\0';
+    return output;
+}
+
+/*
+StringColumn string_column_replace_all(StringColumn column, char *substr, char *replacement)
+
+returns:
+    > every string of <column> with every occurence of <substr> replaced with <replacement>
+    > an empty column if invalid <column>, <substr> or <replacement>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_replace_all({"a-b", "c-d-e"}, "-", "+") -> {"a+b", "c+d+e"}
+*/
+StringColumn string_column_replace_all(StringColumn column, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringColumn output = {0};
+
+    if (!column.data || !column.offsets || !substr || !replacement) {return output;}
+
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+    size_t length_buf = column.offsets[column.count] - column.offsets[0];
+
+    // Nothing to replace, trimming "" hands back a plain copy
+    if (length_sub == 0) {return string_column_trim_left(column, "");}
+
+    // Only a growing replacement needs a counting pass to size the buffer
+    if (length_rep > length_sub)
+    {
+        size_t count = 0;
+
+        for (size_t i = 0; i < column.count; ++i)
+        {
+            const char *str = column.data + column.offsets[i];
+            size_t length_str = column.offsets[i + 1] - column.offsets[i];
+            size_t pos = 0;
+            size_t match;
+
+            while ((match = string__find(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+            {
+                pos += match + length_sub;
+                ++count;
+            }
+        }
+
+        length_buf += count * (length_rep - length_sub);
+    }
+
+    output = string__column_alloc(column.count, length_buf);
+
+    size_t pos_out = 0;
+
+    for (size_t i = 0; i < column.count; ++i)
+    {
+        const char *str = column.data + column.offsets[i];
+        size_t length_str = column.offsets[i + 1] - column.offsets[i];
+        size_t pos = 0;
+        size_t match;
+
+        while ((match = string__find(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+        {
+            memcpy(output.data + pos_out, str + pos, match);
+            pos_out += match;
+
+            memcpy(output.data + pos_out, replacement, length_rep);
+            pos_out += length_rep;
+
+            pos += match + length_sub;
+        }
+
+        memcpy(output.data + pos_out, str + pos, length_str - pos);
+        pos_out += length_str - pos;
+
+        output.offsets[i + 1] = pos_out;
+    }
+
+    output.data[pos_out] = '\0';
+    return output;
+}
+
+/*
+StringColumn string_column_remove_all(StringColumn column, char *substr)
+
+returns:
+    > every string of <column> with every occurence of <substr> removed
+    > an empty column if invalid <column> or <substr>
+    > needs to be freed with string_column_free()!
+
+example:
+    > string_column_remove_all({"a-b", "c-d-e"}, "-") -> {"ab", "cde"}
+*/
+StringColumn string_column_remove_all(StringColumn column, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string_column_replace_all(column, substr, "");
+}
+
+/*
+void string_column_free(StringColumn *column)
+
+frees:
+    > the data and offsets of <column> and leaves it empty
+*/
+void string_column_free(StringColumn *column)
+{
+    if (!column) {return;}
+
+    free(column->data);
+    free(column->offsets);
+
+    column->data = NULL;
+    column->offsets = NULL;
+    column->count = 0;
+}
+
+//------------------|
+// Case-Insensitive |
+//------------------|
+
+/*
+int string_find_ci(char *str, char *substr)
+
+returns:
+    > position of the first occurence of <substr> in <str>, ignoring (ASCII) case
+    > -1 if <substr> wasn't found
+
+example:
+    > string_find_ci("Content-Type: text/html", "content-type") -> 0
+*/
+int string_find_ci(char *str, char *substr)
+{
+    if (!str || !substr) {return -1;}
+
+    size_t pos = string__find_ci(str, strlen(str), substr, strlen(substr));
+
+    return (pos == (size_t)-1) ? -1 : (int)pos;
+}
+
+/*
+unsigned int string_count_ci(char *str, char *substr)
+
+returns:
+    > the amount of times <substr> occurs in <str>, ignoring (ASCII) case
+
+example:
+    > string_count_ci("Foo fOO FOO", "foo") -> 3
+*/
+unsigned int string_count_ci(char *str, char *substr)
+{
+    if (!str || !substr) {return 0;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+
+    size_t pos = 0;
+    size_t match;
+    unsigned int count = 0;
+
+    while ((match = string__find_ci(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+    {
+        pos += match + length_sub;
+        ++count;
+    }
+
+    return count;
+}
+
+/*
+bool string_contains_ci(char *str, char *substr)
+
+returns:
+    > true if <str> contains <substr>, ignoring (ASCII) case
+
+example:
+    > string_contains_ci("Accept-Encoding: GZIP", "gzip") -> true
+*/
+bool string_contains_ci(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    return string__find_ci(str, strlen(str), substr, strlen(substr)) != (size_t)-1;
+}
+
+/*
+bool string_starts_with_ci(char *str, char *substr)
+
+returns:
+    > true if <str> starts with <substr>, ignoring (ASCII) case
+
+example:
+    > string_starts_with_ci("HTTP/1.1 200 OK", "http/") -> true
+*/
+bool string_starts_with_ci(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    return length_str >= length_sub && string__equal_ci(str, substr, length_sub);
+}
+
+/*
+bool string_ends_with_ci(char *str, char *substr)
+
+returns:
+    > true if <str> ends with <substr>, ignoring (ASCII) case
+
+example:
+    > string_ends_with_ci("index.HTML", ".html") -> true
+*/
+bool string_ends_with_ci(char *str, char *substr)
+{
+    if (!str || !substr) {return false;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    return length_str >= length_sub && string__equal_ci(str + (length_str - length_sub), substr, length_sub);
+}
+
+/*
+char *string_replace_all_ci(char *str, char *substr, char *replacement)
+
+returns:
+    > <str> with every occurence of <substr> replaced with <replacement>, ignoring (ASCII) case
+    > NULL if invalid <str>, <substr> or <replacement>
+    > needs to be freed!
+
+example:
+    > string_replace_all_ci("Hello HELLO World", "hello", "Bye") -> "Bye Bye World"
+*/
+char *string_replace_all_ci(char *str, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !substr || !replacement) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+
+    if (length_sub == 0)
+    {
+        char *output = malloc(length_str + 1);
+        memcpy(output, str, length_str + 1);
+        return output;
+    }
+
+    size_t count = 0;
+    size_t pos = 0;
+    size_t match;
+
+    while ((match = string__find_ci(str + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+    {
+        pos += match + length_sub;
+        ++count;
+    }
+
+    size_t length_buf = length_str - (length_sub * count) + (length_rep * count);
+    char *output = malloc(length_buf + 1);
+
+    size_t pos_out = 0;
+    pos = 0;
+
+    while (count-- > 0)
+    {
+        match = string__find_ci(str + pos, length_str - pos, substr, length_sub);
+
+        memcpy(output + pos_out, str + pos, match);
+        pos_out += match;
+
+        memcpy(output + pos_out, replacement, length_rep);
+        pos_out += length_rep;
+
+        pos += match + length_sub;
+    }
+
+    memcpy(output + pos_out, str + pos, length_str - pos);
+
+    output[length_buf] = '\0';
+    return output;
+}
+
+/*
+char **string_split_substr_ci(char *str, char *delimiter)
+
+returns:
+    > an array containing contents of <str> split at every occurence of the whole of <delimiter>,
+      ignoring (ASCII) case (the case-insensitive string_split_substr(), not string_split():
+      empty fields are kept and the array ends with NULL)
+    > NULL if invalid <str> or <delimiter>
+    > needs to be freed! (array and strings are one allocation)
+
+example:
+    > string_split_substr_ci("a AND b and c", " and ") -> {"a", "b", "c", NULL}
+*/
+char **string_split_substr_ci(char *str, char *delimiter)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !delimiter) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(delimiter);
+
+    if (length_sub == 0) {return NULL;}
+
+    size_t count = 0;
+    size_t pos = 0;
+    size_t match;
+
+    while ((match = string__find_ci(str + pos, length_str - pos, delimiter, length_sub)) != (size_t)-1)
+    {
+        pos += match + length_sub;
+        ++count;
+    }
+
+    // Pointer array followed by the fields, each NUL terminated
+    size_t length_array = sizeof(char *) * (count + 2);
+    size_t length_fields = length_str - (length_sub * count) + (count + 1);
+
+    char **output = malloc(length_array + length_fields);
+    char *fields = (char *)output + length_array;
+
+    pos = 0;
+
+    for (size_t i = 0; i <= count; ++i)
+    {
+        match = (i < count) ? string__find_ci(str + pos, length_str - pos, delimiter, length_sub) : length_str - pos;
+
+        output[i] = fields;
+
+        memcpy(fields, str + pos, match);
+        fields[match] = '\0';
+
+        fields += match + 1;
+        pos += match + length_sub;
+    }
+
+    output[count + 1] = NULL;
+    return output;
+}
+
+//----------|
+// Patterns |
+//----------|
+
+#ifndef ZSTRING_PATTERN_MAX_STATES
+    #define ZSTRING_PATTERN_MAX_STATES 4096
+#endif
+
+#define STRING__PATTERN_CACHE_SIZE 16
+
+typedef struct string__byteset
+{
+    uint32_t bits[8];
+} string__byteset;
+
+static inline bool string__byteset_has(const string__byteset *set, unsigned char c)
+{
+    return (set->bits[c >> 5] >> (c & 31)) & 1;
+}
+
+static inline void string__byteset_add_range(string__byteset *set, unsigned char lo, unsigned char hi)
+{
+    for (unsigned int c = lo; c <= hi; ++c)
+    {
+        set->bits[c >> 5] |= 1u << (c & 31);
+    }
+}
+
+enum
+{
+    STRING__NODE_SET, STRING__NODE_EMPTY, STRING__NODE_CONCAT, STRING__NODE_ALT,
+    STRING__NODE_STAR, STRING__NODE_PLUS, STRING__NODE_QUEST
+};
+
+typedef struct string__pattern_node
+{
+    int type;
+    int a;      // set index for STRING__NODE_SET, first child otherwise
+    int b;      // second child of CONCAT and ALT
+} string__pattern_node;
+
+typedef struct string__pattern_parser
+{
+    const char *ptr;
+    const char *end;
+    bool error;
+
+    string__pattern_node *nodes;
+    int count_nodes;
+    int capacity_nodes;
+
+    string__byteset *sets;
+    int count_sets;
+    int capacity_sets;
+} string__pattern_parser;
+
+// One NFA state: consumes a byte of <set> and moves to <out>, or is an epsilon split to <out>/<out1>
+typedef struct string__nfa_state
+{
+    int set;    // -1 epsilon, -2 match
+    int out;
+    int out1;
+} string__nfa_state;
+
+typedef struct string__nfa
+{
+    string__nfa_state *states;
+    int count;
+    int capacity;
+} string__nfa;
+
+typedef struct string__dfa
+{
+    int *next;          // count * classes transitions, state 0 is dead
+    bool *accept;
+    uint64_t *leaves;   // count * words bits: the sets each state can consume a byte of next
+    int count;
+    int start;
+} string__dfa;
+
+struct StringPattern
+{
+    unsigned char classes[256];     // byte -> equivalence class
+    int count_classes;
+
+    size_t words;                   // uint64_t per bitset of sets, one bit per set of the pattern
+    uint64_t *class_leaves;         // count_classes * words bits: the sets holding each class
+
+    string__dfa forward;            // R, anchored
+    string__dfa reverse;            // reversed R, unanchored unless the pattern ends in '$'
+
+    bool anchor_start;
+    bool anchor_end;
+};
+
+static int string__pattern_add_node(string__pattern_parser *parser, int type, int a, int b)
+{
+    if (parser->count_nodes == parser->capacity_nodes)
+    {
+        parser->capacity_nodes = parser->capacity_nodes ? parser->capacity_nodes * 2 : 64;
+        parser->nodes = realloc(parser->nodes, sizeof(string__pattern_node) * parser->capacity_nodes);
+    }
+
+    string__pattern_node *node = &parser->nodes[parser->count_nodes];
+    node->type = type;
+    node->a = a;
+    node->b = b;
+
+    return parser->count_nodes++;
+}
+
+static int string__pattern_add_set(string__pattern_parser *parser, const string__byteset *set)
+{
+    if (parser->count_sets == parser->capacity_sets)
+    {
+        parser->capacity_sets = parser->capacity_sets ? parser->capacity_sets * 2 : 32;
+        parser->sets = realloc(parser->sets, sizeof(string__byteset) * parser->capacity_sets);
+    }
+
+    parser->sets[parser->count_sets] = *set;
+
+    return string__pattern_add_node(parser, STRING__NODE_SET, parser->count_sets++, 0);
+}
+// Byte written as "\<c>" (\n \r \t or <c> itself)
+// Byte written as "\\<c>" outside of a named class
+static inline unsigned char string__pattern_literal(char c)
+{
+    switch (c)
+    {
+        case 'n': return '\n';
+        case 'r': return '\r';
+        case 't': return '\t';
+        default:  return (unsigned char)c;
+    }
+}
+
+// Adds the class named by the escape <c> (\d \w \s and their negations) or the literal <c>
+static void string__pattern_escape(string__byteset *set, char c)
+{
+    string__byteset named = {{0}};
+    bool negate = (c == 'D' || c == 'W' || c == 'S');
+
+    switch (c)
+    {
+        case 'd': case 'D':
+            string__byteset_add_range(&named, '0', '9');
+            break;
+
+        case 'w': case 'W':
+            string__byteset_add_range(&named, '0', '9');
+            string__byteset_add_range(&named, 'A', 'Z');
+            string__byteset_add_range(&named, 'a', 'z');
+            string__byteset_add_range(&named, '_', '_');
+            break;
+
+        case 's': case 'S':
+            string__byteset_add_range(&named, '\t', '\r');
+            string__byteset_add_range(&named, ' ', ' ');
+            break;
+
+        default:
+            string__byteset_add_range(&named, string__pattern_literal(c), string__pattern_literal(c));
+            break;
+    }
+
+    for (int i = 0; i < 8; ++i)
+    {
+        set->bits[i] |= negate ? ~named.bits[i] : named.bits[i];
+    }
+}
+
+// "[...]" with the opening bracket already consumed
+static int string__pattern_parse_class(string__pattern_parser *parser, bool glob)
+{
+    string__byteset set = {{0}};
+    bool negate = false;
+
+    if (parser->ptr < parser->end && (*parser->ptr == '^' || (glob && *parser->ptr == '!')))
+    {
+        negate = true;
+        ++parser->ptr;
+    }
+
+    bool first = true;
+
+    while (parser->ptr < parser->end && (*parser->ptr != ']' || first))
+    {
+        unsigned char lo = (unsigned char)*parser->ptr++;
+        first = false;
+
+        if (lo == '\\' && parser->ptr < parser->end)
+        {
+            char c = *parser->ptr++;
+
+            if (!glob && (c == 'd' || c == 'D' || c == 'w' || c == 'W' || c == 's' || c == 'S'))
+            {
+                string__pattern_escape(&set, c);
+                continue;
+            }
+
+            lo = glob ? (unsigned char)c : string__pattern_literal(c);
+        }
+
+        unsigned char hi = lo;
+
+        if (parser->ptr + 1 < parser->end && parser->ptr[0] == '-' && parser->ptr[1] != ']')
+        {
+            hi = (unsigned char)parser->ptr[1];
+            parser->ptr += 2;
+
+            // An escaped endpoint ("[*-\]]") is the escaped byte, a named class can't end a range
+            if (hi == '\\' && parser->ptr < parser->end)
+            {
+                char c = *parser->ptr++;
+
+                if (!glob && (c == 'd' || c == 'D' || c == 'w' || c == 'W' || c == 's' || c == 'S')) {parser->error = true; return -1;}
+
+                hi = glob ? (unsigned char)c : string__pattern_literal(c);
+            }
+
+            if (hi < lo) {parser->error = true; return -1;}
+        }
+
+        string__byteset_add_range(&set, lo, hi);
+    }
+
+    if (parser->ptr >= parser->end) {parser->error = true; return -1;}
+
+    ++parser->ptr;
+
+    if (negate)
+    {
+        for (int i = 0; i < 8; ++i) {set.bits[i] = ~set.bits[i];}
+    }
+
+    return string__pattern_add_set(parser, &set);
+}
+
+static int string__pattern_parse_alt(string__pattern_parser *parser, int depth);
+
+static int string__pattern_parse_atom(string__pattern_parser *parser, int depth)
+{
+    char c = *parser->ptr++;
+    string__byteset set = {{0}};
+
+    switch (c)
+    {
+        case '(':
+        {
+            int node = string__pattern_parse_alt(parser, depth + 1);
+
+            if (parser->ptr >= parser->end || *parser->ptr != ')') {parser->error = true; return -1;}
+
+            ++parser->ptr;
+            return node;
+        }
+
+        case '[':
+            return string__pattern_parse_class(parser, false);
+
+        case '.':
+            string__byteset_add_range(&set, 0, 255);
+            return string__pattern_add_set(parser, &set);
+
+        case '\\':
+            if (parser->ptr >= parser->end) {parser->error = true; return -1;}
+
+            string__pattern_escape(&set, *parser->ptr++);
+            return string__pattern_add_set(parser, &set);
+
+        case ')': case '*': case '+': case '?': case '^': case '$':
+            parser->error = true;
+            return -1;
+
+        default:
+            string__byteset_add_range(&set, (unsigned char)c, (unsigned char)c);
+            return string__pattern_add_set(parser, &set);
+    }
+}
+
+static int string__pattern_parse_concat(string__pattern_parser *parser, int depth)
+{
+    int node = string__pattern_add_node(parser, STRING__NODE_EMPTY, 0, 0);
+
+    while (!parser->error && parser->ptr < parser->end && *parser->ptr != '|' && *parser->ptr != ')')
+    {
+        int atom = string__pattern_parse_atom(parser, depth);
+
+        while (!parser->error && parser->ptr < parser->end && (*parser->ptr == '*' || *parser->ptr == '+' || *parser->ptr == '?'))
+        {
+            char c = *parser->ptr++;
+            atom = string__pattern_add_node(parser, (c == '*') ? STRING__NODE_STAR : (c == '+') ? STRING__NODE_PLUS : STRING__NODE_QUEST, atom, 0);
+        }
+
+        node = string__pattern_add_node(parser, STRING__NODE_CONCAT, node, atom);
+    }
+
+    return node;
+}
+
+static int string__pattern_parse_alt(string__pattern_parser *parser, int depth)
+{
+    if (depth > 64) {parser->error = true; return -1;}
+
+    int node = string__pattern_parse_concat(parser, depth);
+
+    while (!parser->error && parser->ptr < parser->end && *parser->ptr == '|')
+    {
+        ++parser->ptr;
+        node = string__pattern_add_node(parser, STRING__NODE_ALT, node, string__pattern_parse_concat(parser, depth));
+    }
+
+    return node;
+}
+
+static int string__pattern_parse_glob(string__pattern_parser *parser)
+{
+    int node = string__pattern_add_node(parser, STRING__NODE_EMPTY, 0, 0);
+
+    while (!parser->error && parser->ptr < parser->end)
+    {
+        char c = *parser->ptr++;
+        string__byteset set = {{0}};
+        int atom;
+
+        if (c == '*' || c == '?')
+        {
+            string__byteset_add_range(&set, 0, 255);
+            atom = string__pattern_add_set(parser, &set);
+
+            if (c == '*') {atom = string__pattern_add_node(parser, STRING__NODE_STAR, atom, 0);}
+        }
+        else if (c == '[')
+        {
+            atom = string__pattern_parse_class(parser, true);
+        }
+        else
+        {
+            if (c == '\\' && parser->ptr < parser->end) {c = *parser->ptr++;}
+
+            string__byteset_add_range(&set, (unsigned char)c, (unsigned char)c);
+            atom = string__pattern_add_set(parser, &set);
+        }
+
+        node = string__pattern_add_node(parser, STRING__NODE_CONCAT, node, atom);
+    }
+
+    return node;
+}
+
+static int string__nfa_add_state(string__nfa *nfa, int set, int out, int out1)
+{
+    if (nfa->count == nfa->capacity)
+    {
+        nfa->capacity = nfa->capacity ? nfa->capacity * 2 : 64;
+        nfa->states = realloc(nfa->states, sizeof(string__nfa_state) * nfa->capacity);
+    }
+
+    nfa->states[nfa->count].set = set;
+    nfa->states[nfa->count].out = out;
+    nfa->states[nfa->count].out1 = out1;
+
+    return nfa->count++;
+}
+
+/*
+    Thompson construction of <node>, optionally for the reversed language.
+    Writes the entry state to <start> and returns the dangling epsilon state at the end.
+*/
+static int string__nfa_build(string__nfa *nfa, const string__pattern_parser *parser, int node, bool reverse, int *start)
+{
+    const string__pattern_node n = parser->nodes[node];
+    int end;
+
+    switch (n.type)
+    {
+        case STRING__NODE_SET:
+        {
+            end = string__nfa_add_state(nfa, -1, -1, -1);
+            *start = string__nfa_add_state(nfa, n.a, end, -1);
+        } break;
+
+        case STRING__NODE_CONCAT:
+        {
+            int first = reverse ? n.b : n.a;
+            int second = reverse ? n.a : n.b;
+            int start_second;
+
+            int end_first = string__nfa_build(nfa, parser, first, reverse, start);
+            end = string__nfa_build(nfa, parser, second, reverse, &start_second);
+
+            nfa->states[end_first].out = start_second;
+        } break;
+
+        case STRING__NODE_ALT:
+        {
+            int start_a, start_b;
+            int end_a = string__nfa_build(nfa, parser, n.a, reverse, &start_a);
+            int end_b = string__nfa_build(nfa, parser, n.b, reverse, &start_b);
+
+            end = string__nfa_add_state(nfa, -1, -1, -1);
+            *start = string__nfa_add_state(nfa, -1, start_a, start_b);
+
+            nfa->states[end_a].out = end;
+            nfa->states[end_b].out = end;
+        } break;
+
+        case STRING__NODE_STAR:
+        case STRING__NODE_PLUS:
+        case STRING__NODE_QUEST:
+        {
+            int start_a;
+            int end_a = string__nfa_build(nfa, parser, n.a, reverse, &start_a);
+
+            end = string__nfa_add_state(nfa, -1, -1, -1);
+            int split = string__nfa_add_state(nfa, -1, start_a, end);
+
+            nfa->states[end_a].out = (n.type == STRING__NODE_QUEST) ? end : split;
+            *start = (n.type == STRING__NODE_PLUS) ? start_a : split;
+        } break;
+
+        default:
+        {
+            end = string__nfa_add_state(nfa, -1, -1, -1);
+            *start = end;
+        } break;
+    }
+
+    return end;
+}
+
+// Adds <state> and everything reachable from it by epsilon moves to the bitset <set>
+static void string__nfa_closure(const string__nfa *nfa, uint64_t *set, int state, int *stack)
+{
+    int top = 0;
+    stack[top++] = state;
+
+    while (top > 0)
+    {
+        int s = stack[--top];
+
+        if (s < 0 || ((set[s >> 6] >> (s & 63)) & 1)) {continue;}
+
+        set[s >> 6] |= 1ull << (s & 63);
+
+        if (nfa->states[s].set == -1)
+        {
+            stack[top++] = nfa->states[s].out;
+            stack[top++] = nfa->states[s].out1;
+        }
+    }
+}
+
+typedef struct string__dfa_builder
+{
+    string__dfa *dfa;
+    const string__nfa *nfa;
+    int classes;
+    size_t words;
+    size_t words_leaves;
+
+    uint64_t *sets;     // NFA state set of every DFA state
+    int capacity;
+
+    int *table;         // open addressing: NFA state set -> DFA state
+    size_t capacity_table;
+} string__dfa_builder;
+
+static inline uint64_t string__dfa_hash(const uint64_t *set, size_t words)
+{
+    uint64_t hash = 1469598103934665603ull;
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        hash = (hash ^ set[w]) * 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+
+    return hash;
+}
+
+// DFA state for the NFA state set <set>, created if new, -1 past ZSTRING_PATTERN_MAX_STATES
+static int string__dfa_intern(string__dfa_builder *builder, const uint64_t *set)
+{
+    size_t words = builder->words;
+    size_t mask = builder->capacity_table - 1;
+    size_t slot = string__dfa_hash(set, words) & mask;
+
+    while (builder->table[slot] != -1)
+    {
+        int state = builder->table[slot];
+
+        if (memcmp(builder->sets + (size_t)state * words, set, sizeof(uint64_t) * words) == 0) {return state;}
+
+        slot = (slot + 1) & mask;
+    }
+
+    string__dfa *dfa = builder->dfa;
+
+    if (dfa->count >= ZSTRING_PATTERN_MAX_STATES) {return -1;}
+
+    if (dfa->count == builder->capacity)
+    {
+        builder->capacity *= 2;
+        builder->sets = realloc(builder->sets, sizeof(uint64_t) * words * builder->capacity);
+        dfa->next = realloc(dfa->next, sizeof(int) * builder->classes * builder->capacity);
+        dfa->accept = realloc(dfa->accept, sizeof(bool) * builder->capacity);
+        dfa->leaves = realloc(dfa->leaves, sizeof(uint64_t) * builder->words_leaves * builder->capacity);
+    }
+
+    int state = dfa->count++;
+    uint64_t *leaves = dfa->leaves + (size_t)state * builder->words_leaves;
+
+    memcpy(builder->sets + (size_t)state * words, set, sizeof(uint64_t) * words);
+    memset(leaves, 0, sizeof(uint64_t) * builder->words_leaves);
+    dfa->accept[state] = false;
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        for (uint64_t bits = set[w]; bits; bits &= bits - 1)
+        {
+            int leaf = builder->nfa->states[w * 64 + string__ctz64(bits)].set;
+
+            if (leaf == -2) {dfa->accept[state] = true;}
+            if (leaf >= 0)  {leaves[leaf >> 6] |= 1ull << (leaf & 63);}
+        }
+    }
+
+    builder->table[slot] = state;
+
+    // Keep the table at most half full
+    if ((size_t)dfa->count * 2 > builder->capacity_table)
+    {
+        builder->capacity_table *= 2;
+        builder->table = realloc(builder->table, sizeof(int) * builder->capacity_table);
+        mask = builder->capacity_table - 1;
+
+        for (size_t i = 0; i < builder->capacity_table; ++i) {builder->table[i] = -1;}
+
+        for (int i = 0; i < dfa->count; ++i)
+        {
+            slot = string__dfa_hash(builder->sets + (size_t)i * words, words) & mask;
+            while (builder->table[slot] != -1) {slot = (slot + 1) & mask;}
+            builder->table[slot] = i;
+        }
+    }
+
+    return state;
+}
+
+/*
+    Subset construction over the byte classes of <pattern>, state 0 is the empty set.
+    <unanchored> adds the NFA start to every state, which makes the DFA run Σ*R.
+    Returns false if the DFA outgrows ZSTRING_PATTERN_MAX_STATES.
+*/
+static bool string__dfa_build(string__dfa *dfa, const string__nfa *nfa, int start, const string__byteset *sets, const StringPattern *pattern, bool unanchored)
+{
+    string__dfa_builder builder;
+    builder.dfa = dfa;
+    builder.nfa = nfa;
+    builder.classes = pattern->count_classes;
+    builder.words = ((size_t)nfa->count + 63) / 64;
+    builder.words_leaves = pattern->words;
+    builder.capacity = 16;
+    builder.capacity_table = 64;
+
+    size_t words = builder.words;
+
+    builder.sets = malloc(sizeof(uint64_t) * words * builder.capacity);
+    builder.table = malloc(sizeof(int) * builder.capacity_table);
+    for (size_t i = 0; i < builder.capacity_table; ++i) {builder.table[i] = -1;}
+
+    dfa->next = malloc(sizeof(int) * builder.classes * builder.capacity);
+    dfa->accept = malloc(sizeof(bool) * builder.capacity);
+    dfa->leaves = malloc(sizeof(uint64_t) * builder.words_leaves * builder.capacity);
+    dfa->count = 0;
+
+    unsigned char representative[256];
+
+    for (int c = 255; c >= 0; --c)
+    {
+        representative[pattern->classes[c]] = (unsigned char)c;
+    }
+
+    int *stack = malloc(sizeof(int) * (2 * (size_t)nfa->count + 2));
+    uint64_t *start_set = calloc(words, sizeof(uint64_t));
+    uint64_t *current = malloc(sizeof(uint64_t) * words);
+    uint64_t *next = malloc(sizeof(uint64_t) * words);
+
+    string__nfa_closure(nfa, start_set, start, stack);
+
+    memset(next, 0, sizeof(uint64_t) * words);
+    string__dfa_intern(&builder, next);
+    dfa->start = string__dfa_intern(&builder, start_set);
+
+    bool ok = true;
+
+    for (int state = 0; state < dfa->count && ok; ++state)
+    {
+        memcpy(current, builder.sets + (size_t)state * words, sizeof(uint64_t) * words);
+
+        for (int c = 0; c < builder.classes; ++c)
+        {
+            if (unanchored) {memcpy(next, start_set, sizeof(uint64_t) * words);}
+            else            {memset(next, 0, sizeof(uint64_t) * words);}
+
+            for (size_t w = 0; w < words; ++w)
+            {
+                for (uint64_t bits = current[w]; bits; bits &= bits - 1)
+                {
+                    const string__nfa_state *s = &nfa->states[w * 64 + string__ctz64(bits)];
+
+                    if (s->set >= 0 && string__byteset_has(&sets[s->set], representative[c]))
+                    {
+                        string__nfa_closure(nfa, next, s->out, stack);
+                    }
+                }
+            }
+
+            int target = string__dfa_intern(&builder, next);
+
+            if (target < 0) {ok = false; break;}
+
+            dfa->next[(size_t)state * builder.classes + c] = target;
+        }
+    }
+
+    free(stack);
+    free(start_set);
+    free(current);
+    free(next);
+    free(builder.sets);
+    free(builder.table);
+
+    return ok;
+}
+
+static inline int string__dfa_step(const StringPattern *pattern, const string__dfa *dfa, int state, unsigned char c)
+{
+    return dfa->next[(size_t)state * pattern->count_classes + pattern->classes[c]];
+}
+
+#if ZSTRING_PATTERN_MAX_STATES <= 65536
+    typedef uint16_t string__pattern_state;
+#else
+    typedef int string__pattern_state;
+#endif
+
+/*
+    Reverse DFA state at every position of <str>, found by running it backwards once: state i has read
+    str[i..length) and holds the sets whose byte can be followed by a match of the rest of the pattern.
+*/
+static string__pattern_state *string__pattern_suffixes(const StringPattern *pattern, const char *str, size_t length)
+{
+    string__pattern_state *suffixes = calloc(length + 1, sizeof(string__pattern_state));
+
+    const string__dfa *dfa = &pattern->reverse;
+    int state = dfa->start;
+
+    suffixes[length] = (string__pattern_state)state;
+
+    for (size_t i = length; i-- > 0;)
+    {
+        state = string__dfa_step(pattern, dfa, state, (unsigned char)str[i]);
+
+        // Only reachable when anchored at the end: nothing further left can match
+        if (state == 0) {break;}
+
+        suffixes[i] = (string__pattern_state)state;
+    }
+
+    return suffixes;
+}
+
+// Whether the forward DFA in <state> at <pos> still accepts somewhere past <pos>
+static inline bool string__pattern_continues(const StringPattern *pattern, int state, const char *str, size_t length, const string__pattern_state *suffixes, size_t pos)
+{
+    if (pos >= length) {return false;}
+
+    size_t words = pattern->words;
+    const uint64_t *ahead = pattern->forward.leaves + (size_t)state * words;
+    const uint64_t *behind = pattern->reverse.leaves + (size_t)suffixes[pos + 1] * words;
+    const uint64_t *byte = pattern->class_leaves + (size_t)pattern->classes[(unsigned char)str[pos]] * words;
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        if (ahead[w] & behind[w] & byte[w]) {return true;}
+    }
+
+    return false;
+}
+
+/*
+    Leftmost-longest non-empty match at or after <*pos>, written to <*pos> and <*end>.
+    The suffix states tell whether a set the forward DFA can consume next is one the rest of <str>
+    completes a match after, so the scan stops right at the end of the match: each byte is read once.
+*/
+static bool string__pattern_next(const StringPattern *pattern, const char *str, size_t length, const string__pattern_state *suffixes, size_t *pos, size_t *end)
+{
+    const string__dfa *dfa = &pattern->forward;
+    size_t last = pattern->anchor_start ? 1 : length;
+
+    for (size_t i = *pos; i < last; ++i)
+    {
+        if (!pattern->reverse.accept[suffixes[i]] || !string__pattern_continues(pattern, dfa->start, str, length, suffixes, i)) {continue;}
+
+        *pos = i;
+        *end = length;
+
+        if (pattern->anchor_end) {return true;}
+
+        int state = dfa->start;
+        size_t j = i;
+
+        do
+        {
+            state = string__dfa_step(pattern, dfa, state, (unsigned char)str[j++]);
+        } while (!dfa->accept[state] || string__pattern_continues(pattern, state, str, length, suffixes, j));
+
+        *end = j;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+bool string_pattern_match(StringPattern *pattern, char *str)
+
+returns:
+    > true if all of <str> matches <pattern>
+    > false if not or invalid <pattern> or <str>
+
+example:
+    > string_pattern_match(string_pattern_cached("*.c", STRING_PATTERN_GLOB), "main.c") -> true
+    > string_pattern_match(string_pattern_cached("\\d+", STRING_PATTERN_REGEX), "12a")  -> false
+*/
+bool string_pattern_match(StringPattern *pattern, char *str)
+{
+    if (!pattern || !str) {return false;}
+
+    const string__dfa *dfa = &pattern->forward;
+    int state = dfa->start;
+
+    for (const unsigned char *ptr = (const unsigned char *)str; *ptr && state != 0; ++ptr)
+    {
+        state = string__dfa_step(pattern, dfa, state, *ptr);
+    }
+
+    return dfa->accept[state];
+}
+
+/*
+int string_pattern_find(StringPattern *pattern, char *str, unsigned int *length)
+
+returns:
+    > position of the leftmost (longest, non-empty) match of <pattern> in <str>,
+      with its length written to <length> if not NULL
+    > -1 if there was no match or invalid <pattern> or <str>
+
+example:
+    > string_pattern_find(string_pattern_cached("[0-9]+", STRING_PATTERN_REGEX), "abc 2024 x", &length) -> 4 (length = 4)
+*/
+int string_pattern_find(StringPattern *pattern, char *str, unsigned int *length)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (length) {*length = 0;}
+
+    if (!pattern || !str) {return -1;}
+
+    size_t length_str = strlen(str);
+    string__pattern_state *suffixes = string__pattern_suffixes(pattern, str, length_str);
+
+    size_t pos = 0;
+    size_t end;
+    bool found = string__pattern_next(pattern, str, length_str, suffixes, &pos, &end);
+
+    free(suffixes);
+
+    if (!found) {return -1;}
+
+    if (length) {*length = (unsigned int)(end - pos);}
+
+    return (int)pos;
+}
+
+/*
+unsigned int string_pattern_count(StringPattern *pattern, char *str)
+
+returns:
+    > the amount of non-overlapping matches of <pattern> in <str>
+
+example:
+    > string_pattern_count(string_pattern_cached("a+", STRING_PATTERN_REGEX), "aa b aaa a") -> 3
+*/
+unsigned int string_pattern_count(StringPattern *pattern, char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!pattern || !str) {return 0;}
+
+    size_t length_str = strlen(str);
+    string__pattern_state *suffixes = string__pattern_suffixes(pattern, str, length_str);
+
+    size_t pos = 0;
+    size_t end;
+    unsigned int count = 0;
+
+    while (string__pattern_next(pattern, str, length_str, suffixes, &pos, &end))
+    {
+        pos = end;
+        ++count;
+    }
+
+    free(suffixes);
+
+    return count;
+}
+
+typedef struct string__pattern_cache_entry
+{
+    char *source;
+    StringPatternSyntax syntax;
+    StringPattern *pattern;
+    unsigned long long used;
+} string__pattern_cache_entry;
+
+static STRING__THREAD_LOCAL string__pattern_cache_entry string__pattern_cache[STRING__PATTERN_CACHE_SIZE];
+static STRING__THREAD_LOCAL unsigned long long string__pattern_cache_clock;
+
+#if defined(ZSTRING_THREADS)
+static pthread_key_t string__pattern_cache_key;
+static pthread_once_t string__pattern_cache_once = PTHREAD_ONCE_INIT;
+
+// Destructor of the key, run by every thread that cached a pattern as it exits
+static void string__pattern_cache_exit(void *cache)
+{
+    (void)cache;
+    string_pattern_cache_clear();
+}
+
+static void string__pattern_cache_key_create(void)
+{
+    pthread_key_create(&string__pattern_cache_key, string__pattern_cache_exit);
+}
+#endif
+
+/*
+StringPattern *string_pattern_cached(char *pattern, StringPatternSyntax syntax)
+
+returns:
+    > <pattern> compiled with string_pattern_compile(), kept in a small per-thread cache
+      so repeated calls with the same pattern don't recompile it
+    > NULL if invalid <pattern>
+    > owned by the cache, don't free it; only valid until the next string_pattern_cached()
+      on the same thread, which may evict it, so pass it straight on as below and use
+      string_pattern_compile() for a pattern to keep
+    > freed with string_pattern_cache_clear(), or when the thread exits with ZSTRING_THREADS
+
+example:
+    > string_pattern_count(string_pattern_cached("*.h", STRING_PATTERN_GLOB), name)
+*/
+StringPattern *string_pattern_cached(char *pattern, StringPatternSyntax syntax)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!pattern) {return NULL;}
+
+    string__pattern_cache_entry *oldest = &string__pattern_cache[0];
+
+    for (int i = 0; i < STRING__PATTERN_CACHE_SIZE; ++i)
+    {
+        string__pattern_cache_entry *entry = &string__pattern_cache[i];
+
+        if (entry->source && entry->syntax == syntax && strcmp(entry->source, pattern) == 0)
+        {
+            entry->used = ++string__pattern_cache_clock;
+            return entry->pattern;
+        }
+
+        if (entry->used < oldest->used) {oldest = entry;}
+    }
+
+    StringPattern *compiled = string_pattern_compile(pattern, syntax);
+
+    if (!compiled) {return NULL;}
+
+    size_t length = strlen(pattern);
+
+    free(oldest->source);
+    string_pattern_free(oldest->pattern);
+
+    oldest->source = malloc(length + 1);
+    memcpy(oldest->source, pattern, length + 1);
+    oldest->syntax = syntax;
+    oldest->pattern = compiled;
+    oldest->used = ++string__pattern_cache_clock;
+
+#if defined(ZSTRING_THREADS)
+    pthread_once(&string__pattern_cache_once, string__pattern_cache_key_create);
+    pthread_setspecific(string__pattern_cache_key, string__pattern_cache);
+#endif
+
+    return compiled;
+}
+
+/*
+void string_pattern_cache_clear(void)
+
+frees:
+    > every pattern cached by string_pattern_cached() on the calling thread (threads
+      other than the main one do this as they exit with ZSTRING_THREADS)
+*/
+void string_pattern_cache_clear(void)
+{
+    for (int i = 0; i < STRING__PATTERN_CACHE_SIZE; ++i)
+    {
+        free(string__pattern_cache[i].source);
+        string_pattern_free(string__pattern_cache[i].pattern);
+
+        string__pattern_cache[i].source = NULL;
+        string__pattern_cache[i].pattern = NULL;
+        string__pattern_cache[i].used = 0;
+    }
+}
+
+/*
+StringPattern *string_pattern_compile(char *pattern, StringPatternSyntax syntax)
+
+returns:
+    > <pattern> compiled to a DFA (one table lookup per byte when matching, find/count/replace_all
+      also run it backwards once to know where each match ends)
+    > NULL if invalid <pattern>, or if it needs more than ZSTRING_PATTERN_MAX_STATES states
+    > needs to be freed with string_pattern_free()!
+
+example:
+    > string_pattern_compile("*.[ch]", STRING_PATTERN_GLOB)
+    > string_pattern_compile("^(GET|POST) /\\w*", STRING_PATTERN_REGEX)
+*/
+StringPattern *string_pattern_compile(char *pattern, StringPatternSyntax syntax)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!pattern) {return NULL;}
+
+    size_t length = strlen(pattern);
+
+    string__pattern_parser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.ptr = pattern;
+    parser.end = pattern + length;
+
+    bool anchor_start = false;
+    bool anchor_end = false;
+
+    if (syntax == STRING_PATTERN_REGEX)
+    {
+        if (parser.ptr < parser.end && *parser.ptr == '^')
+        {
+            anchor_start = true;
+            ++parser.ptr;
+        }
+
+        if (parser.ptr < parser.end && parser.end[-1] == '$')
+        {
+            // "\$" is a literal dollar, "\\$" an escaped backslash followed by the anchor
+            size_t slashes = 0;
+            while (slashes < (size_t)(parser.end - 1 - parser.ptr) && parser.end[-2 - (ptrdiff_t)slashes] == '\\') {++slashes;}
+
+            if (slashes % 2 == 0)
+            {
+                anchor_end = true;
+                --parser.end;
+            }
+        }
+    }
+
+    int root = (syntax == STRING_PATTERN_GLOB) ? string__pattern_parse_glob(&parser) : string__pattern_parse_alt(&parser, 0);
+
+    if (parser.ptr != parser.end) {parser.error = true;}
+
+    StringPattern *result = NULL;
+
+    if (!parser.error)
+    {
+        result = calloc(1, sizeof(StringPattern));
+        result->anchor_start = anchor_start;
+        result->anchor_end = anchor_end;
+
+        // Split the bytes into classes no set tells apart
+        result->count_classes = 1;
+
+        for (int i = 0; i < parser.count_sets; ++i)
+        {
+            int split[512];
+            int count = 0;
+
+            for (int j = 0; j < result->count_classes * 2; ++j) {split[j] = -1;}
+
+            for (int c = 0; c < 256; ++c)
+            {
+                int key = result->classes[c] * 2 + string__byteset_has(&parser.sets[i], (unsigned char)c);
+
+                if (split[key] == -1) {split[key] = count++;}
+
+                result->classes[c] = (unsigned char)split[key];
+            }
+
+            result->count_classes = count;
+        }
+
+        result->words = ((size_t)parser.count_sets + 63) / 64;
+        result->class_leaves = calloc((size_t)result->count_classes * result->words + 1, sizeof(uint64_t));
+
+        for (int c = 0; c < 256; ++c)
+        {
+            uint64_t *leaves = result->class_leaves + (size_t)result->classes[c] * result->words;
+
+            for (int i = 0; i < parser.count_sets; ++i)
+            {
+                if (string__byteset_has(&parser.sets[i], (unsigned char)c)) {leaves[i >> 6] |= 1ull << (i & 63);}
+            }
+        }
+
+        string__nfa nfa;
+        memset(&nfa, 0, sizeof(nfa));
+
+        int start;
+        int end = string__nfa_build(&nfa, &parser, root, false, &start);
+        nfa.states[end].set = -2;
+
+        bool ok = string__dfa_build(&result->forward, &nfa, start, parser.sets, result, false);
+
+        if (ok)
+        {
+            nfa.count = 0;
+            end = string__nfa_build(&nfa, &parser, root, true, &start);
+            nfa.states[end].set = -2;
+
+            ok = string__dfa_build(&result->reverse, &nfa, start, parser.sets, result, !anchor_end);
+        }
+
+        free(nfa.states);
+
+        if (!ok)
+        {
+            string_pattern_free(result);
+            result = NULL;
+        }
+    }
+
+    free(parser.nodes);
+    free(parser.sets);
+
+    return result;
+}
+
+/*
+char *string_pattern_replace_all(StringPattern *pattern, char *str, char *replacement)
+
+returns:
+    > <str> with every (leftmost-longest, non-overlapping) match of <pattern> replaced with <replacement>
+    > NULL if invalid <pattern>, <str> or <replacement>
+    > needs to be freed!
+
+example:
+    > string_pattern_replace_all(string_pattern_cached("\\s+", STRING_PATTERN_REGEX), "a  b\t\tc", " ") -> "a b c"
+*/
+char *string_pattern_replace_all(StringPattern *pattern, char *str, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!pattern || !str || !replacement) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t length_rep = strlen(replacement);
+    string__pattern_state *suffixes = string__pattern_suffixes(pattern, str, length_str);
+
+    string__builder builder = {NULL, 0, 0};
+    string__builder_reserve(&builder, length_str);
+
+    size_t copied = 0;
+    size_t pos = 0;
+    size_t end;
+
+    while (string__pattern_next(pattern, str, length_str, suffixes, &pos, &end))
+    {
+        string__builder_append(&builder, str + copied, pos - copied);
+        string__builder_append(&builder, replacement, length_rep);
+
+        copied = pos = end;
+    }
+
+    string__builder_append(&builder, str + copied, length_str - copied);
+    builder.data[builder.length] = '\0';
+
+    free(suffixes);
+
+    return builder.data;
+}
+
+/*
+void string_pattern_free(StringPattern *pattern)
+
+frees:
+    > <pattern> and its DFAs
+*/
+void string_pattern_free(StringPattern *pattern)
+{
+    if (!pattern) {return;}
+
+    free(pattern->class_leaves);
+    free(pattern->forward.next);
+    free(pattern->forward.accept);
+    free(pattern->forward.leaves);
+    free(pattern->reverse.next);
+    free(pattern->reverse.accept);
+    free(pattern->reverse.leaves);
+    free(pattern);
+}
+
+//-----|
+// CSV |
+//-----|
+
+// Bit i is set where block[i] == c, for a 64-byte block
+static inline uint64_t string__csv_mask(const unsigned char *block, unsigned char c)
+{
+#if defined(ZSTRING_AVX2)
+    __m256i needle = _mm256_set1_epi8((char)c);
+
+    uint64_t lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)block), needle));
+    uint64_t hi = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(block + 32)), needle));
+
+    return lo | (hi << 32);
+#elif defined(ZSTRING_SSE2)
+    __m128i needle = _mm_set1_epi8((char)c);
+    uint64_t mask = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t bits = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(block + 16 * i)), needle));
+        mask |= bits << (16 * i);
+    }
+
+    return mask;
+#else
+    uint64_t mask = 0;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        mask |= (uint64_t)(block[i] == c) << i;
+    }
+
+    return mask;
+#endif
+}
+
+// Bit i is the XOR of bits 0..i, i.e. set from an opening quote up to (excluding) its closing quote
+static inline uint64_t string__prefix_xor(uint64_t x)
+{
+#if defined(ZSTRING_PCLMUL)
+    // Carry-less multiply by all ones XORs every shifted copy of <x> in one instruction
+    __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), _mm_set1_epi8((char)0xFF), 0);
+
+    return (uint64_t)_mm_cvtsi128_si64(product);
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+
+    return x;
+#endif
+}
+
+static void string__csv_reserve(StringCsv *csv, size_t extra)
+{
+    if (csv->count + extra <= csv->capacity) {return;}
+
+    size_t capacity = csv->capacity ? csv->capacity : 256;
+
+    while (capacity < csv->count + extra)
+    {
+        capacity *= 2;
+    }
+
+    csv->ends = realloc(csv->ends, sizeof(size_t) * capacity);
+    csv->capacity = capacity;
+}
+
+// Appends the separators of one 64-byte block that starts at stream offset <base>
+static inline void string__csv_block(StringCsv *csv, const unsigned char *block, size_t base)
+{
+    uint64_t quotes = string__csv_mask(block, '"');
+    uint64_t inside = string__prefix_xor(quotes) ^ csv->in_quotes;
+
+    // Carry the quote state of the last byte into the next block
+    csv->in_quotes = 0 - (inside >> 63);
+
+    uint64_t separators = (string__csv_mask(block, (unsigned char)csv->delimiter) | string__csv_mask(block, '\n')) & ~inside;
+
+    size_t *ends = csv->ends + csv->count;
+    csv->count += (size_t)string__popcount((unsigned int)separators) + string__popcount((unsigned int)(separators >> 32));
+
+    while (separators)
+    {
+        *ends++ = base + string__ctz64(separators);
+        separators &= separators - 1;
+    }
+}
+
+/*
+StringCsv string_csv_init(char delimiter)
+
+returns:
+    > an empty CSV tokenizer splitting fields on <delimiter> (',' for CSV, '\t' for TSV) and rows on '\n',
+      fed with string_csv_feed()
+    > needs to be freed with string_csv_free()!
+
+example:
+    > StringCsv csv = string_csv_init(',');
+*/
+StringCsv string_csv_init(char delimiter)
+{
+    StringCsv csv;
+    memset(&csv, 0, sizeof(csv));
+
+    csv.delimiter = delimiter ? delimiter : ',';
+
+    return csv;
+}
+
+/*
+void string_csv_feed(StringCsv *csv, char *chunk, size_t length)
+
+appends:
+    > the end of every field in <chunk> to <csv>, as offsets into the whole stream
+      (quoted fields may contain delimiters, newlines and "" and may span chunks)
+
+example:
+    > while ((length = fread(chunk, 1, sizeof(chunk), file))) {string_csv_feed(&csv, chunk, length); ...}
+*/
+void string_csv_feed(StringCsv *csv, char *chunk, size_t length)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!csv || !chunk || length == 0) {return;}
+
+    const unsigned char *ptr = (const unsigned char *)chunk;
+    size_t i = 0;
+
+    string__csv_reserve(csv, length + 64);
+
+    for (; i + 64 <= length; i += 64)
+    {
+        string__csv_block(csv, ptr + i, csv->consumed + i);
+    }
+
+    if (i < length)
+    {
+        // NUL padding holds no quotes or separators, so the quote state stays that of the last byte
+        unsigned char block[64] = {0};
+        memcpy(block, ptr + i, length - i);
+
+        string__csv_block(csv, block, csv->consumed + i);
+    }
+
+    csv->consumed += length;
+    csv->open = (chunk[length - 1] != '\n' || csv->in_quotes);
+}
+
+/*
+bool string_csv_finish(StringCsv *csv)
+
+returns:
+    > true after ending the last field of <csv> if the stream didn't end with a newline
+    > false if the stream ended inside quotes (or invalid <csv>)
+*/
+bool string_csv_finish(StringCsv *csv)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!csv) {return false;}
+
+    if (csv->open)
+    {
+        string__csv_reserve(csv, 1);
+
+        csv->ends[csv->count++] = csv->consumed;
+        csv->open = false;
+    }
+
+    return csv->in_quotes == 0;
+}
+
+/*
+void string_csv_clear(StringCsv *csv)
+
+clears:
+    > the fields of <csv> while keeping its stream position, so the
+      tokenizer can be fed again without the field list growing
+*/
+void string_csv_clear(StringCsv *csv)
+{
+    if (!csv || csv->count == 0) {return;}
+
+    csv->start = csv->ends[csv->count - 1] + 1;
+    csv->count = 0;
+}
+
+/*
+StringSpan string_csv_field(StringCsv *csv, char *stream, size_t index)
+
+returns:
+    > a span over field <index> of <csv> in <stream> (the buffer its offsets refer to),
+      without surrounding quotes or a trailing '\r' (quoted fields still contain "")
+    > an empty span if invalid <csv>, <stream> or <index>
+
+example:
+    > string_csv_field(&csv, "a,\"b,c\"\n", 1) -> {"b,c", 3}
+*/
+StringSpan string_csv_field(StringCsv *csv, char *stream, size_t index)
+{
+    StringSpan span = {NULL, 0};
+
+    if (!csv || !stream || index >= csv->count) {return span;}
+
+    size_t start = index ? csv->ends[index - 1] + 1 : csv->start;
+    size_t end = csv->ends[index];
+
+    if (end > start && stream[end - 1] == '\r' && string_csv_row_end(csv, stream, index)) {--end;}
+
+    if (end - start >= 2 && stream[start] == '"' && stream[end - 1] == '"')
+    {
+        ++start;
+        --end;
+    }
+
+    span.data = stream + start;
+    span.length = end - start;
+
+    return span;
+}
+
+/*
+bool string_csv_row_end(StringCsv *csv, char *stream, size_t index)
+
+returns:
+    > true if field <index> of <csv> is the last field of its row
+    > false if not or invalid <csv>, <stream> or <index>
+*/
+bool string_csv_row_end(StringCsv *csv, char *stream, size_t index)
+{
+    if (!csv || !stream || index >= csv->count) {return false;}
+
+    size_t end = csv->ends[index];
+
+    return end >= csv->consumed || stream[end] == '\n';
+}
+
+/*
+StringCsv string_csv_parse(char *buffer, size_t length, char delimiter)
+
+returns:
+    > every field of the CSV/TSV in <buffer> (see string_csv_init()), csv.in_quotes is set if a quote was left open
+    > needs to be freed with string_csv_free()!
+
+example:
+    > StringCsv csv = string_csv_parse(data, size, ',');
+    > for (size_t i = 0; i < csv.count; ++i) {StringSpan field = string_csv_field(&csv, data, i); ...}
+*/
+StringCsv string_csv_parse(char *buffer, size_t length, char delimiter)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringCsv csv = string_csv_init(delimiter);
+
+    if (!buffer) {return csv;}
+
+    string_csv_feed(&csv, buffer, length);
+    string_csv_finish(&csv);
+
+    return csv;
+}
+
+/*
+char *string_csv_unquote(StringSpan field)
+
+returns:
+    > <field> with every "" turned into "
+    > NULL if invalid <field>
+    > needs to be freed!
+
+example:
+    > string_csv_unquote(string_csv_field(&csv, "\"say \"\"hi\"\"\"", 0)) -> "say \"hi\""
+*/
+char *string_csv_unquote(StringSpan field)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!field.data) {return NULL;}
+
+    char *output = malloc(field.length + 1);
+    size_t length = 0;
+
+    for (size_t i = 0; i < field.length; ++i)
+    {
+        output[length++] = field.data[i];
+
+        if (field.data[i] == '"' && i + 1 < field.length && field.data[i + 1] == '"') {++i;}
+    }
+
+    output[length] = '\0';
+    return output;
+}
+
+/*
+char **string_csv_split(char *str, char delimiter)
+
+returns:
+    > an array containing the unquoted fields of the CSV/TSV record <str>, ending with NULL
+      (unlike string_split(), delimiters inside quotes don't split)
+    > NULL if invalid <str>
+    > needs to be freed! (array and strings are one allocation)
+
+example:
+    > string_csv_split("1,\"Doe, John\",", ',') -> {"1", "Doe, John", "", NULL}
+*/
+char **string_csv_split(char *str, char delimiter)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    StringCsv csv = string_csv_parse(str, length_str, delimiter);
+
+    // An empty record is one empty field
+    size_t count = csv.count ? csv.count : 1;
+
+    // Pointer array followed by the fields, each NUL terminated
+    size_t length_array = sizeof(char *) * (count + 1);
+
+    char **output = malloc(length_array + length_str + count);
+    char *fields = (char *)output + length_array;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        StringSpan field = string_csv_field(&csv, str, i);
+        size_t length = 0;
+
+        for (size_t j = 0; j < field.length; ++j)
+        {
+            fields[length++] = field.data[j];
+
+            if (field.data[j] == '"' && j + 1 < field.length && field.data[j + 1] == '"') {++j;}
+        }
+
+        fields[length] = '\0';
+
+        output[i] = fields;
+        fields += length + 1;
+    }
+
+    output[count] = NULL;
+
+    string_csv_free(&csv);
+    return output;
+}
+
+/*
+void string_csv_free(StringCsv *csv)
+
+frees:
+    > the fields of <csv> and resets it
+*/
+void string_csv_free(StringCsv *csv)
+{
+    if (!csv) {return;}
+
+    free(csv->ends);
+
+    *csv = string_csv_init(csv->delimiter);
+}
+
+//-------|
+// Lines |
+//-------|
+
+// Position of the first '\n' in <ptr>, <length> if there is none
+static size_t string__find_newline(const char *ptr, size_t length)
+{
+    size_t i = 0;
+
+#if defined(ZSTRING_AVX2)
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    // Two 32-byte compares OR'd together, so one movemask tests 64 bytes
+    for (; i + 64 <= length; i += 64)
+    {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(ptr + i)), newline);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(ptr + i + 32)), newline);
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b)))
+        {
+            uint64_t mask = (uint32_t)_mm256_movemask_epi8(a) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(b) << 32);
+            return i + string__ctz64(mask);
+        }
+    }
+#elif defined(ZSTRING_SSE2)
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    for (; i + 32 <= length; i += 32)
+    {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(ptr + i)), newline);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(ptr + i + 16)), newline);
+
+        if (_mm_movemask_epi8(_mm_or_si128(a, b)))
+        {
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(a) | ((unsigned int)_mm_movemask_epi8(b) << 16);
+            return i + string__ctz(mask);
+        }
+    }
+#endif
+
+    const char *found = memchr(ptr + i, '\n', length - i);
+
+    return found ? (size_t)(found - ptr) : length;
+}
+
+/*
+StringLines string_lines(char *buffer, size_t length)
+
+returns:
+    > an iterator over the lines of the first <length> bytes of <buffer> (doesn't need a NUL),
+      stepped with string_lines_next()
+
+example:
+    > StringLines lines = string_lines(log, size);
+*/
+StringLines string_lines(char *buffer, size_t length)
+{
+    StringLines lines = {buffer, buffer ? length : 0, 0};
+
+    return lines;
+}
+
+/*
+bool string_lines_next(StringLines *lines, StringSpan *line)
+
+returns:
+    > true with the next line of <lines> written to <line>, without its "\n" or "\r\n"
+    > false once all lines were returned (a final newline doesn't start another line)
+
+example:
+    > StringSpan line;
+    > while (string_lines_next(&lines, &line)) {...}
+*/
+bool string_lines_next(StringLines *lines, StringSpan *line)
+{
+    if (!lines || !line || lines->pos >= lines->length) {return false;}
+
+    char *start = lines->data + lines->pos;
+    size_t rest = lines->length - lines->pos;
+    size_t end = string__find_newline(start, rest);
+
+    lines->pos += (end < rest) ? end + 1 : end;
+
+    if (end < rest && end > 0 && start[end - 1] == '\r') {--end;}
+
+    line->data = start;
+    line->length = end;
+
+    return true;
+}
+
+/*
+size_t string_count_lines(char *buffer, size_t length)
+
+returns:
+    > the amount of lines string_lines_next() returns for <buffer>,
+      i.e. the amount of '\n' plus one if the last line isn't terminated
+
+example:
+    > string_count_lines("a\nb\r\nc", 6)   -> 3
+    > string_count_lines("a\nb\n", 4)      -> 2
+*/
+size_t string_count_lines(char *buffer, size_t length)
+{
+    if (!buffer || length == 0) {return 0;}
+
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(ZSTRING_AVX2)
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    // Matches are -1, so subtracting them counts per byte lane, summed with SAD before a lane can overflow
+    while (i + 32 <= length)
+    {
+        __m256i counts = _mm256_setzero_si256();
+        size_t blocks = (length - i) / 32;
+        if (blocks > 255) {blocks = 255;}
+
+        for (size_t b = 0; b < blocks; ++b, i += 32)
+        {
+            counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(buffer + i)), newline));
+        }
+
+        __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+
+        count += (size_t)_mm256_extract_epi64(sums, 0) + (size_t)_mm256_extract_epi64(sums, 1)
+               + (size_t)_mm256_extract_epi64(sums, 2) + (size_t)_mm256_extract_epi64(sums, 3);
+    }
+#elif defined(ZSTRING_SSE2)
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    while (i + 16 <= length)
+    {
+        __m128i counts = _mm_setzero_si128();
+        size_t blocks = (length - i) / 16;
+        if (blocks > 255) {blocks = 255;}
+
+        for (size_t b = 0; b < blocks; ++b, i += 16)
+        {
+            counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(buffer + i)), newline));
+        }
+
+        __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        count += (buffer[i] == '\n');
+    }
+
+    return count + (buffer[length - 1] != '\n');
+}
+
+//-------------------------|
+// Set/Substring Splitting |
+//-------------------------|
+
+// Nibble tables of a byte set: bit (hi & 7) of low[lo] / high[lo] is set if byte (hi << 4 | lo) is in the set
+typedef struct string__byteclass
+{
+    string__byteset set;
+    unsigned char low[16];     // bytes 0x00..0x7F
+    unsigned char high[16];    // bytes 0x80..0xFF
+} string__byteclass;
+
+static void string__byteclass_init(string__byteclass *byteclass, const char *bytes)
+{
+    memset(byteclass, 0, sizeof(*byteclass));
+
+    for (const unsigned char *ptr = (const unsigned char *)bytes; *ptr; ++ptr)
+    {
+        string__byteset_add_range(&byteclass->set, *ptr, *ptr);
+
+        if (*ptr < 0x80) {byteclass->low[*ptr & 15] |= (unsigned char)(1u << (*ptr >> 4));}
+        else             {byteclass->high[*ptr & 15] |= (unsigned char)(1u << ((*ptr >> 4) & 7));}
+    }
+}
+
+// Position of the first byte of <ptr> in <byteclass>, <length> if there is none
+static size_t string__find_any(const char *ptr, size_t length, const string__byteclass *byteclass)
+{
+    size_t i = 0;
+
+#if defined(ZSTRING_AVX2)
+    const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byteclass->low));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byteclass->high));
+    const __m256i bit = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                         1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i top = _mm256_set1_epi8((char)0x80);
+
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(ptr + i));
+
+        // pshufb zeroes lanes whose index has the top bit set, so each table only answers for its half
+        __m256i row = _mm256_or_si256(_mm256_shuffle_epi8(low, block), _mm256_shuffle_epi8(high, _mm256_xor_si256(block, top)));
+        __m256i column = _mm256_shuffle_epi8(bit, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+        __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(row, column), column);
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(hit);
+
+        if (mask) {return i + string__ctz(mask);}
+    }
+#elif defined(ZSTRING_SSSE3)
+    const __m128i low = _mm_loadu_si128((const __m128i *)byteclass->low);
+    const __m128i high = _mm_loadu_si128((const __m128i *)byteclass->high);
+    const __m128i bit = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i top = _mm_set1_epi8((char)0x80);
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(ptr + i));
+
+        __m128i row = _mm_or_si128(_mm_shuffle_epi8(low, block), _mm_shuffle_epi8(high, _mm_xor_si128(block, top)));
+        __m128i column = _mm_shuffle_epi8(bit, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+        __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(row, column), column);
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hit);
+
+        if (mask) {return i + string__ctz(mask);}
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        if (string__byteset_has(&byteclass->set, (unsigned char)ptr[i])) {return i;}
+    }
+
+    return length;
+}
+
+/*
+char **string_split_any(char *str, char *delimiters, bool skip_empty)
+
+returns:
+    > an array containing contents of <str> split at every byte found in <delimiters>,
+      without empty fields if <skip_empty>, ending with NULL
+    > NULL if invalid <str> or <delimiters>
+    > needs to be freed! (array and strings are one allocation)
+
+example:
+    > string_split_any("a, b;;c", ",; ", true)  -> {"a", "b", "c", NULL}
+    > string_split_any("a,,b", ",", false)      -> {"a", "", "b", NULL}
+*/
+char **string_split_any(char *str, char *delimiters, bool skip_empty)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !delimiters) {return NULL;}
+
+    string__byteclass byteclass;
+    string__byteclass_init(&byteclass, delimiters);
+
+    size_t length_str = strlen(str);
+    size_t count = 0;
+
+    for (size_t pos = 0; pos <= length_str;)
+    {
+        size_t length = string__find_any(str + pos, length_str - pos, &byteclass);
+
+        count += (length > 0 || !skip_empty);
+        pos += length + 1;
+    }
+
+    // Pointer array followed by a copy of <str> with every delimiter replaced by NUL
+    size_t length_array = sizeof(char *) * (count + 1);
+
+    char **output = malloc(length_array + length_str + 1);
+    char *fields = (char *)output + length_array;
+
+    memcpy(fields, str, length_str + 1);
+
+    size_t i = 0;
+
+    for (size_t pos = 0; pos <= length_str;)
+    {
+        size_t length = string__find_any(fields + pos, length_str - pos, &byteclass);
+
+        if (length > 0 || !skip_empty) {output[i++] = fields + pos;}
+
+        fields[pos + length] = '\0';
+        pos += length + 1;
+    }
+
+    output[count] = NULL;
+    return output;
+}
+
+/*
+char **string_split_substr(char *str, char *delimiter)
+
+returns:
+    > an array containing contents of <str> split at every occurence of the whole of <delimiter>
+      (unlike strtok(), "ab" splits only at "ab" and not at every 'a' or 'b'),
+      empty fields are kept and the array ends with NULL
+    > NULL if invalid <str> or <delimiter>
+    > needs to be freed! (array and strings are one allocation)
+
+example:
+    > string_split_substr("a::b:c::", "::") -> {"a", "b:c", "", NULL}
+*/
+char **string_split_substr(char *str, char *delimiter)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str || !delimiter) {return NULL;}
+
+    size_t length_str = strlen(str);
+    size_t length_sub = strlen(delimiter);
+
+    if (length_sub == 0) {return NULL;}
+
+    size_t count = 0;
+    size_t pos = 0;
+    size_t match;
+
+    while ((match = string__find(str + pos, length_str - pos, delimiter, length_sub)) != (size_t)-1)
+    {
+        pos += match + length_sub;
+        ++count;
+    }
+
+    // Pointer array followed by a copy of <str> with the first byte of every delimiter replaced by NUL
+    size_t length_array = sizeof(char *) * (count + 2);
+
+    char **output = malloc(length_array + length_str + 1);
+    char *fields = (char *)output + length_array;
+
+    memcpy(fields, str, length_str + 1);
+
+    pos = 0;
+
+    for (size_t i = 0; i <= count; ++i)
+    {
+        match = (i < count) ? string__find(fields + pos, length_str - pos, delimiter, length_sub) : length_str - pos;
+
+        output[i] = fields + pos;
+        fields[pos + match] = '\0';
+
+        pos += match + length_sub;
+    }
+
+    output[count + 1] = NULL;
+    return output;
+}
+
+//-------|
+// Index |
+//-------|
+
+// Text of one SA-IS level: bytes at the top level, names of LMS substrings below it
+typedef struct string__sais_text
+{
+    const unsigned char *bytes;
+    const int32_t *names;
+} string__sais_text;
+
+#define STRING__SAIS_CHR(text, i)   ((text).names ? (text).names[i] : (int32_t)(text).bytes[i])
+#define STRING__SAIS_IS_S(types, i) (((types)[(i) >> 3] >> ((i) & 7)) & 1)
+#define STRING__SAIS_IS_LMS(types, i) ((i) > 0 && STRING__SAIS_IS_S(types, i) && !STRING__SAIS_IS_S(types, (i) - 1))
+
+// Start (or end, if <end>) of every character's bucket in the suffix array
+static void string__sais_buckets(string__sais_text text, int32_t *buckets, int32_t n, int32_t k, bool end)
+{
+    int32_t sum = 0;
+
+    memset(buckets, 0, sizeof(int32_t) * (k + 1));
+
+    for (int32_t i = 0; i < n; ++i) {++buckets[STRING__SAIS_CHR(text, i)];}
+
+    for (int32_t i = 0; i <= k; ++i)
+    {
+        sum += buckets[i];
+        buckets[i] = end ? sum : sum - buckets[i];
+    }
+}
+
+// Places L-type suffixes left to right, then S-type suffixes right to left, from the seeded LMS suffixes
+static void string__sais_induce(string__sais_text text, const unsigned char *types, int32_t *sa, int32_t *buckets, int32_t n, int32_t k)
+{
+    string__sais_buckets(text, buckets, n, k, false);
+
+    for (int32_t i = 0; i < n; ++i)
+    {
+        int32_t j = sa[i] - 1;
+
+        if (sa[i] > 0 && !STRING__SAIS_IS_S(types, j)) {sa[buckets[STRING__SAIS_CHR(text, j)]++] = j;}
+    }
+
+    string__sais_buckets(text, buckets, n, k, true);
+
+    for (int32_t i = n - 1; i >= 0; --i)
+    {
+        int32_t j = sa[i] - 1;
+
+        if (sa[i] > 0 && STRING__SAIS_IS_S(types, j)) {sa[--buckets[STRING__SAIS_CHR(text, j)]] = j;}
+    }
+}
+
+/*
+    SA-IS (Nong, Zhang & Chan): sorts the suffixes of <text> (length <n>, alphabet 0..<k>) into <sa>
+    in linear time. The last character must be a unique smallest sentinel.
+*/
+static void string__sais(string__sais_text text, int32_t *sa, int32_t n, int32_t k)
+{
+    unsigned char *types = calloc((size_t)n / 8 + 1, 1);
+    int32_t *buckets = malloc(sizeof(int32_t) * (k + 1));
+
+    // S-type (1) if smaller than the suffix after it, L-type (0) if larger
+    types[(n - 1) >> 3] |= (unsigned char)(1u << ((n - 1) & 7));
+
+    for (int32_t i = n - 2; i >= 0; --i)
+    {
+        int32_t a = STRING__SAIS_CHR(text, i);
+        int32_t b = STRING__SAIS_CHR(text, i + 1);
+
+        if (a < b || (a == b && STRING__SAIS_IS_S(types, i + 1))) {types[i >> 3] |= (unsigned char)(1u << (i & 7));}
+    }
+
+    // Sort the LMS substrings by seeding the LMS positions at their bucket ends and inducing
+    string__sais_buckets(text, buckets, n, k, true);
+
+    for (int32_t i = 0; i < n; ++i) {sa[i] = -1;}
+
+    for (int32_t i = 1; i < n; ++i)
+    {
+        if (STRING__SAIS_IS_LMS(types, i)) {sa[--buckets[STRING__SAIS_CHR(text, i)]] = i;}
+    }
+
+    string__sais_induce(text, types, sa, buckets, n, k);
+
+    // Compact the sorted LMS substrings and name them, equal substrings get equal names
+    int32_t count_lms = 0;
+
+    for (int32_t i = 0; i < n; ++i)
+    {
+        if (STRING__SAIS_IS_LMS(types, sa[i])) {sa[count_lms++] = sa[i];}
+    }
+
+    for (int32_t i = count_lms; i < n; ++i) {sa[i] = -1;}
+
+    int32_t name = 0;
+    int32_t previous = -1;
+
+    for (int32_t i = 0; i < count_lms; ++i)
+    {
+        int32_t pos = sa[i];
+        bool different = false;
+
+        for (int32_t d = 0; d < n; ++d)
+        {
+            if (previous == -1 || STRING__SAIS_CHR(text, pos + d) != STRING__SAIS_CHR(text, previous + d) ||
+                STRING__SAIS_IS_S(types, pos + d) != STRING__SAIS_IS_S(types, previous + d))
+            {
+                different = true;
+                break;
+            }
+
+            if (d > 0 && (STRING__SAIS_IS_LMS(types, pos + d) || STRING__SAIS_IS_LMS(types, previous + d))) {break;}
+        }
+
+        if (different)
+        {
+            ++name;
+            previous = pos;
+        }
+
+        // LMS positions are at least two apart, so pos / 2 is a unique slot
+        sa[count_lms + pos / 2] = name - 1;
+    }
+
+    for (int32_t i = n - 1, j = n - 1; i >= count_lms; --i)
+    {
+        if (sa[i] >= 0) {sa[j--] = sa[i];}
+    }
+
+    // Sort the LMS suffixes: recurse on the names unless they are already unique
+    int32_t *sa_reduced = sa;
+    int32_t *text_reduced = sa + n - count_lms;
+
+    if (name < count_lms)
+    {
+        string__sais_text reduced = {NULL, text_reduced};
+        string__sais(reduced, sa_reduced, count_lms, name - 1);
+    }
+    else
+    {
+        for (int32_t i = 0; i < count_lms; ++i) {sa_reduced[text_reduced[i]] = i;}
+    }
+
+    // Seed the sorted LMS suffixes and induce the full suffix array from them
+    for (int32_t i = 1, j = 0; i < n; ++i)
+    {
+        if (STRING__SAIS_IS_LMS(types, i)) {text_reduced[j++] = i;}
+    }
+
+    for (int32_t i = 0; i < count_lms; ++i) {sa_reduced[i] = text_reduced[sa_reduced[i]];}
+
+    for (int32_t i = count_lms; i < n; ++i) {sa[i] = -1;}
+
+    string__sais_buckets(text, buckets, n, k, true);
+
+    for (int32_t i = count_lms - 1; i >= 0; --i)
+    {
+        int32_t j = sa[i];
+        sa[i] = -1;
+        sa[--buckets[STRING__SAIS_CHR(text, j)]] = j;
+    }
+
+    string__sais_induce(text, types, sa, buckets, n, k);
+
+    free(buckets);
+    free(types);
+}
+
+// Compares the suffix at <pos> against <substr>, looking at no more than strlen(<substr>) bytes
+static inline int string__index_compare(const StringIndex *index, int32_t pos, const char *substr, size_t length_sub)
+{
+    size_t length_suffix = index->length - (size_t)pos;
+    int result = memcmp(index->text + pos, substr, (length_suffix < length_sub) ? length_suffix : length_sub);
+
+    if (result == 0 && length_suffix < length_sub) {return -1;}
+
+    return result;
+}
+
+// Range [*first, *last) of the suffixes starting with <substr>, by binary search
+static void string__index_range(const StringIndex *index, const char *substr, size_t *first, size_t *last)
+{
+    size_t length_sub = strlen(substr);
+    size_t lo = 0;
+    size_t hi = index->length;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (string__index_compare(index, index->suffixes[mid], substr, length_sub) < 0) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+
+    *first = lo;
+    hi = index->length;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (string__index_compare(index, index->suffixes[mid], substr, length_sub) <= 0) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+
+    *last = lo;
+}
+
+/*
+StringIndex string_index_build(char *buffer, size_t length)
+
+returns:
+    > a suffix array over a copy of the first <length> bytes of <buffer>, built once in O(n)
+      with SA-IS so every later query starts with a binary search (up to 2 GiB of text)
+    > an empty index if invalid <buffer> or <length> is too large
+    > needs to be freed with string_index_free()!
+
+example:
+    > StringIndex index = string_index_build(corpus, size);
+*/
+StringIndex string_index_build(char *buffer, size_t length)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringIndex index = {NULL, 0, NULL, NULL, 0, 0};
+
+    if (!buffer || length >= (size_t)INT32_MAX - 1) {return index;}
+
+    int32_t n = (int32_t)length + 1;
+    int32_t *sa = malloc(sizeof(int32_t) * n);
+
+    index.text = malloc(length + 1);
+    memcpy(index.text, buffer, length);
+    index.text[length] = '\0';
+    index.length = length;
+
+    if (length == 0)
+    {
+        sa[0] = 0;
+    }
+    else if (!memchr(buffer, '\0', length))
+    {
+        // The terminating NUL already is the unique smallest sentinel
+        string__sais_text text = {(const unsigned char *)index.text, NULL};
+        string__sais(text, sa, n, 255);
+    }
+    else
+    {
+        // Shift every byte up by one to make room for a sentinel below NUL
+        int32_t *shifted = malloc(sizeof(int32_t) * n);
+
+        for (size_t i = 0; i < length; ++i) {shifted[i] = (int32_t)(unsigned char)buffer[i] + 1;}
+        shifted[length] = 0;
+
+        string__sais_text text = {NULL, shifted};
+        string__sais(text, sa, n, 256);
+
+        free(shifted);
+    }
+
+    // sa[0] is the empty suffix at the sentinel
+    memmove(sa, sa + 1, sizeof(int32_t) * length);
+    index.suffixes = sa;
+
+    return index;
+}
+
+/*
+unsigned int string_index_count(StringIndex *index, char *substr)
+
+returns:
+    > the amount of times <substr> occurs in the indexed text, overlapping ones included
+      (like string_count_overlap()), in O(m log n)
+
+example:
+    > string_index_count(&index, "aa") -> 2 (for "aaa")
+*/
+unsigned int string_index_count(StringIndex *index, char *substr)
+{
+    if (!index || !index->suffixes || !substr || substr[0] == '\0') {return 0;}
+
+    size_t first, last;
+    string__index_range(index, substr, &first, &last);
+
+    return (unsigned int)(last - first);
+}
+
+/*
+int string_index_find(StringIndex *index, char *substr)
+
+returns:
+    > position of the first occurence of <substr> in the indexed text, in O(m log n + k)
+      for k occurences, or O(m log n) once string_index_find_nth() sorted them
+    > -1 if <substr> wasn't found or invalid <index> or <substr>
+
+example:
+    > string_index_find(&index, "Bar") -> 4 (for "Foo Bar Foo Bar")
+*/
+int string_index_find(StringIndex *index, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string_index_find_nth(index, substr, 1);
+}
+
+static int string__index_compare_positions(const void *a, const void *b)
+{
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+int string_index_find_nth(StringIndex *index, char *substr, unsigned int nth)
+
+returns:
+    > position of the <nth> (starting at 1) occurence of <substr> in the indexed text, like string_find_nth()
+    > -1 if there are fewer than <nth> occurences or invalid <index>, <substr> or <nth>
+    > the matching suffixes are in text order, so the first query for <substr> sorts their positions
+      in O(k log k) for k occurences (the first occurence alone is a O(k) scan) and keeps them in <index>:
+      later queries for the same <substr> are O(m log n), but an index is not to be queried from several
+      threads at once
+
+example:
+    > string_index_find_nth(&index, "Foo", 2) -> 8 (for "Foo Bar Foo Bar")
+*/
+int string_index_find_nth(StringIndex *index, char *substr, unsigned int nth)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!index || !index->suffixes || !substr || substr[0] == '\0' || nth == 0) {return -1;}
+
+    size_t first, last;
+    string__index_range(index, substr, &first, &last);
+
+    size_t count = last - first;
+
+    if (count < nth) {return -1;}
+
+    // Any substring with the same range of suffixes has the same occurences
+    bool cached = index->sorted && index->sorted_first == first && index->sorted_count == count;
+
+    if (!cached)
+    {
+        const int32_t *range = index->suffixes + first;
+
+        if (nth == 1)
+        {
+            int32_t pos = range[0];
+            for (size_t i = 1; i < count; ++i) {if (range[i] < pos) {pos = range[i];}}
+
+            return (int)pos;
+        }
+
+        index->sorted = realloc(index->sorted, sizeof(int32_t) * count);
+        memcpy(index->sorted, range, sizeof(int32_t) * count);
+        qsort(index->sorted, count, sizeof(int32_t), string__index_compare_positions);
+
+        index->sorted_first = first;
+        index->sorted_count = count;
+    }
+
+    return (int)index->sorted[nth - 1];
+}
+
+/*
+void string_index_free(StringIndex *index)
+
+frees:
+    > the text, suffix array and sorted positions of <index> and leaves it empty
+*/
+void string_index_free(StringIndex *index)
+{
+    if (!index) {return;}
+
+    free(index->text);
+    free(index->suffixes);
+    free(index->sorted);
+
+    index->text = NULL;
+    index->length = 0;
+    index->suffixes = NULL;
+    index->sorted = NULL;
+    index->sorted_first = 0;
+    index->sorted_count = 0;
+}
+
+//-----------|
+// Pipelines |
+//-----------|
+
+#ifndef ZSTRING_PIPELINE_CHUNK
+    #define ZSTRING_PIPELINE_CHUNK 16384
+#endif
+
+enum
+{
+    STRING__STAGE_TRIM_LEFT, STRING__STAGE_TRIM_RIGHT, STRING__STAGE_CASE, STRING__STAGE_REPLACE
+};
+
+typedef struct string__pipeline_stage
+{
+    int type;
+    bool upper;
+
+    char *substr;
+    size_t length_sub;
+    char *replacement;
+    size_t length_rep;
+} string__pipeline_stage;
+
+struct StringPipeline
+{
+    string__pipeline_stage *stages;
+    size_t count;
+    size_t capacity;
+};
+
+// Per-run state of a stage: bytes held back until the next chunk shows how they continue
+typedef struct string__pipeline_state
+{
+    string__builder pending;
+    bool done;
+} string__pipeline_state;
+
+static StringPipeline *string__pipeline_add(StringPipeline *pipeline, int type, char *substr, char *replacement)
+{
+    if (!pipeline) {return NULL;}
+
+    // Consecutive case mappings collapse into the last one
+    if (type == STRING__STAGE_CASE && pipeline->count > 0 && pipeline->stages[pipeline->count - 1].type == STRING__STAGE_CASE)
+    {
+        --pipeline->count;
+    }
+
+    if (pipeline->count == pipeline->capacity)
+    {
+        pipeline->capacity = pipeline->capacity ? pipeline->capacity * 2 : 8;
+        pipeline->stages = realloc(pipeline->stages, sizeof(string__pipeline_stage) * pipeline->capacity);
+    }
+
+    string__pipeline_stage *stage = &pipeline->stages[pipeline->count++];
+    memset(stage, 0, sizeof(*stage));
+    stage->type = type;
+
+    if (substr)
+    {
+        stage->length_sub = strlen(substr);
+        stage->substr = malloc(stage->length_sub + 1);
+        memcpy(stage->substr, substr, stage->length_sub + 1);
+    }
+
+    if (replacement)
+    {
+        stage->length_rep = strlen(replacement);
+        stage->replacement = malloc(stage->length_rep + 1);
+        memcpy(stage->replacement, replacement, stage->length_rep + 1);
+    }
+
+    return pipeline;
+}
+
+// Runs <stage> over the next <length> bytes of its input, appending what it can already decide to <out>
+static void string__pipeline_step(const string__pipeline_stage *stage, string__pipeline_state *state, const char *data, size_t length, bool final, string__builder *out)
+{
+    size_t length_sub = stage->length_sub;
+
+    if (stage->type == STRING__STAGE_CASE)
+    {
+        string__builder_reserve(out, length);
+        string__ascii_case((unsigned char *)out->data + out->length, (const unsigned char *)data, length, stage->upper);
+        out->length += length;
+        return;
+    }
+
+    if (length_sub == 0 || (stage->type == STRING__STAGE_TRIM_LEFT && state->done))
+    {
+        string__builder_append(out, data, length);
+        return;
+    }
+
+    // Continue from the bytes held back by the previous chunk
+    bool from_pending = (state->pending.length > 0);
+
+    if (from_pending)
+    {
+        string__builder_append(&state->pending, data, length);
+
+        data = state->pending.data;
+        length = state->pending.length;
+    }
+
+    size_t keep = 0;
+
+    switch (stage->type)
+    {
+        case STRING__STAGE_TRIM_LEFT:
+        {
+            if (length < length_sub && !final)
+            {
+                keep = length;
+                break;
+            }
+
+            if (length >= length_sub && memcmp(data, stage->substr, length_sub) == 0)
+            {
+                data += length_sub;
+                length -= length_sub;
+            }
+
+            string__builder_append(out, data, length);
+            state->done = true;
+        } break;
+
+        case STRING__STAGE_TRIM_RIGHT:
+        {
+            if (!final)
+            {
+                keep = (length < length_sub) ? length : length_sub;
+                string__builder_append(out, data, length - keep);
+                break;
+            }
+
+            if (length >= length_sub && memcmp(data + length - length_sub, stage->substr, length_sub) == 0)
+            {
+                length -= length_sub;
+            }
+
+            string__builder_append(out, data, length);
+        } break;
+
+        case STRING__STAGE_REPLACE:
+        {
+            size_t pos = 0;
+            size_t match;
+
+            while ((match = string__find(data + pos, length - pos, stage->substr, length_sub)) != (size_t)-1)
+            {
+                string__builder_append(out, data + pos, match);
+                string__builder_append(out, stage->replacement, stage->length_rep);
+
+                pos += match + length_sub;
+            }
+
+            // A match may still start in the last length_sub - 1 bytes
+            size_t tail = length - pos;
+            keep = final ? 0 : ((tail < length_sub - 1) ? tail : length_sub - 1);
+
+            string__builder_append(out, data + pos, tail - keep);
+        } break;
+    }
+
+    if (from_pending)
+    {
+        memmove(state->pending.data, data + length - keep, keep);
+        state->pending.length = keep;
+    }
+    else if (keep > 0)
+    {
+        string__builder_append(&state->pending, data + length - keep, keep);
+    }
+}
+
+// One pass of a pipeline over a stream, which may arrive in any number of pieces
+typedef struct string__pipeline_run
+{
+    const StringPipeline *pipeline;
+    string__pipeline_state *states;
+    string__builder buffers[2];
+} string__pipeline_run;
+
+static void string__pipeline_run_init(string__pipeline_run *run, const StringPipeline *pipeline)
+{
+    memset(run, 0, sizeof(*run));
+
+    run->pipeline = pipeline;
+    run->states = calloc(pipeline->count ? pipeline->count : 1, sizeof(string__pipeline_state));
+}
+
+static void string__pipeline_run_free(string__pipeline_run *run)
+{
+    for (size_t i = 0; i < run->pipeline->count; ++i) {free(run->states[i].pending.data);}
+
+    free(run->states);
+    free(run->buffers[0].data);
+    free(run->buffers[1].data);
+}
+
+// Pushes the next <length> bytes of the stream through every stage, appending the result to <output>
+static void string__pipeline_feed(string__pipeline_run *run, const char *str, size_t length_str, bool last, string__builder *output)
+{
+    size_t count = run->pipeline->count;
+    size_t pos = 0;
+    bool final;
+
+    do
+    {
+        size_t length = length_str - pos;
+        if (length > ZSTRING_PIPELINE_CHUNK) {length = ZSTRING_PIPELINE_CHUNK;}
+
+        final = (pos + length == length_str);
+
+        const char *data = str + pos;
+        pos += length;
+
+        // Each stage reads the previous stage's (cache-resident) chunk, the last one writes the output
+        for (size_t i = 0; i < count; ++i)
+        {
+            string__builder *out = (i == count - 1) ? output : &run->buffers[i & 1];
+
+            if (out != output) {out->length = 0;}
+
+            string__pipeline_step(&run->pipeline->stages[i], &run->states[i], data, length, final && last, out);
+
+            data = out->data;
+            length = out->length;
+        }
+
+        if (count == 0) {string__builder_append(output, data, length);}
+    }
+    while (!final);
+}
+
+/*
+StringPipeline *string_pipeline_create(void)
+
+returns:
+    > an empty pipeline, stages are added with string_pipeline_trim_left(), _lower(), _replace_all(), ...
+      and all of them run together in one pass by string_pipeline_run()
+    > needs to be freed with string_pipeline_free()!
+
+example:
+    > StringPipeline *normalize = string_pipeline_create();
+    > string_pipeline_remove_all(string_pipeline_replace_all(string_pipeline_lower(string_pipeline_trim_left(normalize, " ")), "\t", " "), "\r");
+*/
+StringPipeline *string_pipeline_create(void)
+{
+    STRING__TRACK_PUBLIC();
+
+    return calloc(1, sizeof(StringPipeline));
+}
+
+/*
+StringPipeline *string_pipeline_trim_left(StringPipeline *pipeline, char *substr)
+
+returns:
+    > <pipeline> with a stage like string_trim_left() added
+    > NULL if invalid <pipeline>
+*/
+StringPipeline *string_pipeline_trim_left(StringPipeline *pipeline, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__pipeline_add(pipeline, STRING__STAGE_TRIM_LEFT, substr ? substr : "", NULL);
+}
+
+/*
+StringPipeline *string_pipeline_trim_right(StringPipeline *pipeline, char *substr)
+
+returns:
+    > <pipeline> with a stage like string_trim_right() added
+    > NULL if invalid <pipeline>
+*/
+StringPipeline *string_pipeline_trim_right(StringPipeline *pipeline, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__pipeline_add(pipeline, STRING__STAGE_TRIM_RIGHT, substr ? substr : "", NULL);
+}
+
+/*
+StringPipeline *string_pipeline_upper(StringPipeline *pipeline)
+
+returns:
+    > <pipeline> with a stage like string_upper() added
+    > NULL if invalid <pipeline>
+*/
+StringPipeline *string_pipeline_upper(StringPipeline *pipeline)
+{
+    STRING__TRACK_PUBLIC();
+
+    StringPipeline *result = string__pipeline_add(pipeline, STRING__STAGE_CASE, NULL, NULL);
+
+    if (result) {result->stages[result->count - 1].upper = true;}
+
+    return result;
+}
+
+/*
+StringPipeline *string_pipeline_lower(StringPipeline *pipeline)
+
+returns:
+    > <pipeline> with a stage like string_lower() added
+    > NULL if invalid <pipeline>
+*/
+StringPipeline *string_pipeline_lower(StringPipeline *pipeline)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__pipeline_add(pipeline, STRING__STAGE_CASE, NULL, NULL);
+}
+
+/*
+StringPipeline *string_pipeline_replace_all(StringPipeline *pipeline, char *substr, char *replacement)
+
+returns:
+    > <pipeline> with a stage like string_replace_all() added
+    > NULL if invalid <pipeline>, <substr> or <replacement>
+*/
+StringPipeline *string_pipeline_replace_all(StringPipeline *pipeline, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!substr || !replacement) {return NULL;}
+
+    return string__pipeline_add(pipeline, STRING__STAGE_REPLACE, substr, replacement);
+}
+
+/*
+StringPipeline *string_pipeline_remove_all(StringPipeline *pipeline, char *substr)
+
+returns:
+    > <pipeline> with a stage like string_remove_all() added
+    > NULL if invalid <pipeline> or <substr>
+*/
+StringPipeline *string_pipeline_remove_all(StringPipeline *pipeline, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!substr) {return NULL;}
+
+    return string__pipeline_add(pipeline, STRING__STAGE_REPLACE, substr, "");
+}
+
+/*
+char *string_pipeline_run(StringPipeline *pipeline, char *str)
+
+returns:
+    > <str> passed through every stage of <pipeline> in order, as if each stage's function
+      was called on the result of the previous one. <str> is read once, in chunks that go
+      through all stages while they are still in cache, and the output is written once
+    > NULL if invalid <pipeline> or <str>
+    > needs to be freed!
+
+example:
+    > string_pipeline_run(normalize, " Hello\tWORLD\r") -> "hello world"
+*/
+char *string_pipeline_run(StringPipeline *pipeline, char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!pipeline || !str) {return NULL;}
+
+    size_t length_str = strlen(str);
+
+    string__pipeline_run run;
+    string__pipeline_run_init(&run, pipeline);
+
+    string__builder output = {NULL, 0, 0};
+    string__builder_reserve(&output, length_str);
+
+    string__pipeline_feed(&run, str, length_str, true, &output);
+    string__pipeline_run_free(&run);
+
+    output.data[output.length] = '\0';
+    return output.data;
+}
+
+/*
+void string_pipeline_free(StringPipeline *pipeline)
+
+frees:
+    > <pipeline> and its stages
+*/
+void string_pipeline_free(StringPipeline *pipeline)
+{
+    if (!pipeline) {return;}
+
+    for (size_t i = 0; i < pipeline->count; ++i)
+    {
+        free(pipeline->stages[i].substr);
+        free(pipeline->stages[i].replacement);
+    }
+
+    free(pipeline->stages);
+    free(pipeline);
+}
+
+//--------------------|
+// Refcounted Strings |
+//--------------------|
+
+// Lives right before the characters, so a ref is an ordinary NUL terminated char *
+typedef struct string__ref_header
+{
+    size_t refs;
+    size_t length;
+} string__ref_header;
+
+#define STRING__REF_HEADER(ref) ((string__ref_header *)(void *)(ref) - 1)
+
+// Uninitialised ref of <length> characters with one reference
+static char *string__ref_alloc(size_t length)
+{
+    string__ref_header *header = malloc(sizeof(string__ref_header) + length + 1);
+
+    header->refs = 1;
+    header->length = length;
+
+    char *ref = (char *)(header + 1);
+    ref[length] = '\0';
+
+    return ref;
+}
+
+static char *string__ref_from(const char *data, size_t length)
+{
+    char *ref = string__ref_alloc(length);
+
+    if (length > 0) {memcpy(ref, data, length);}
+
+    return ref;
+}
+
+// New ref of <ref> with every <substr> (or only the first, unless <all>) replaced with <replacement>
+static char *string__ref_replace(char *ref, char *substr, char *replacement, bool all)
+{
+    if (!ref || !substr || !replacement) {return NULL;}
+
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+
+    size_t first = (length_sub > 0) ? string__find(ref, length_str, substr, length_sub) : (size_t)-1;
+
+    // Nothing to replace: share the same buffer
+    if (first == (size_t)-1) {return string_ref_retain(ref);}
+
+    size_t count = 1;
+
+    if (all)
+    {
+        size_t pos = first + length_sub;
+        size_t match;
+
+        while ((match = string__find(ref + pos, length_str - pos, substr, length_sub)) != (size_t)-1)
+        {
+            pos += match + length_sub;
+            ++count;
+        }
+    }
+
+    char *output = string__ref_alloc(length_str - count * length_sub + count * length_rep);
+    char *write = output;
+    size_t pos = 0;
+    size_t match = first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0) {match = string__find(ref + pos, length_str - pos, substr, length_sub);}
+
+        memcpy(write, ref + pos, match);
+        memcpy(write + match, replacement, length_rep);
+
+        write += match + length_rep;
+        pos += match + length_sub;
+    }
+
+    memcpy(write, ref + pos, length_str - pos);
+
+    return output;
+}
+
+// New ref of <ref> rotated left by <amount>
+static char *string__ref_rotate(char *ref, size_t amount)
+{
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+
+    if (length_str == 0 || amount % length_str == 0) {return string_ref_retain(ref);}
+
+    amount %= length_str;
+
+    char *output = string__ref_alloc(length_str);
+
+    memcpy(output, ref + amount, length_str - amount);
+    memcpy(output + (length_str - amount), ref, amount);
+
+    return output;
+}
+
+static char *string__ref_case(char *ref, bool upper)
+{
+    if (!ref) {return NULL;}
+
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+    unsigned char from = upper ? 'a' : 'A';
+    size_t i = 0;
+
+    while (i < length_str && (unsigned char)(ref[i] - from) >= 26) {++i;}
+
+    if (i == length_str) {return string_ref_retain(ref);}
+
+    char *output = string__ref_alloc(length_str);
+
+    // The unchanged prefix is copied as is, the rest goes through the SIMD case kernel
+    memcpy(output, ref, i);
+    string__ascii_case((unsigned char *)output + i, (const unsigned char *)ref + i, length_str - i, upper);
+
+    return output;
+}
+
+/*
+char *string_ref_new(char *str)
+
+returns:
+    > a reference counted copy of <str> (a normal C string, with its length and count stored before it)
+    > NULL if invalid <str>
+    > needs to be released with string_ref_release()!
+
+example:
+    > char *name = string_ref_new("World");
+*/
+char *string_ref_new(char *str)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    return string__ref_from(str, strlen(str));
+}
+
+/*
+char *string_ref_format(char *str, ...)
+
+returns:
+    > a reference counted string of <str> formatted with the arguments, see string_format()
+    > NULL if invalid <str>
+    > needs to be released with string_ref_release()!
+
+example:
+    > string_ref_format("%s=%d", "id", 7) -> "id=7"
+*/
+char *string_ref_format(char *str, ...)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    string__builder *builder = &string__format_buffer;
+    builder->length = 0;
+
+    va_list args;
+    va_start(args, str);
+    string__vformat(builder, str, args);
+    va_end(args);
+
+    return string__ref_from(builder->data, builder->length);
+}
+
+/*
+char *string_ref_retain(char *ref)
+
+returns:
+    > <ref> with one more reference, for sharing it without copying
+    > NULL if invalid <ref>
+*/
+char *string_ref_retain(char *ref)
+{
+    if (!ref) {return NULL;}
+
+    STRING__ATOMIC_ADD(&STRING__REF_HEADER(ref)->refs, 1);
+
+    return ref;
+}
+
+/*
+void string_ref_release(char *ref)
+
+frees:
+    > <ref> once its last reference is released
+*/
+void string_ref_release(char *ref)
+{
+    if (!ref) {return;}
+
+    if (STRING__ATOMIC_ADD(&STRING__REF_HEADER(ref)->refs, (size_t)-1) == 0)
+    {
+        free(STRING__REF_HEADER(ref));
+    }
+}
+
+/*
+char *string_ref_mutable(char *ref)
+
+returns:
+    > <ref> itself if it is the only reference, otherwise a private copy of it
+      (the reference to <ref> is handed over either way, copy-on-write)
+    > NULL if invalid <ref>
+
+example:
+    > ref = string_ref_mutable(ref); ref[0] = 'h';
+*/
+char *string_ref_mutable(char *ref)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!ref) {return NULL;}
+
+    if (STRING__ATOMIC_ADD(&STRING__REF_HEADER(ref)->refs, 0) == 1) {return ref;}
+
+    char *copy = string__ref_from(ref, STRING__REF_HEADER(ref)->length);
+    string_ref_release(ref);
+
+    return copy;
+}
+
+/*
+size_t string_ref_length(char *ref)
+
+returns:
+    > the length of <ref> without scanning it
+    > 0 if invalid <ref>
+*/
+size_t string_ref_length(char *ref)
+{
+    return ref ? STRING__REF_HEADER(ref)->length : 0;
+}
+
+/*
+size_t string_ref_count(char *ref)
+
+returns:
+    > the amount of references to <ref>
+    > 0 if invalid <ref>
+*/
+size_t string_ref_count(char *ref)
+{
+    return ref ? STRING__ATOMIC_ADD(&STRING__REF_HEADER(ref)->refs, 0) : 0;
+}
+
+/*
+char *string_ref_trim_left(char *ref, char *substr)
+
+returns:
+    > <ref> with <substr> trimmed from the left, <ref> itself (retained) if it doesn't start with it
+    > NULL if invalid <ref>
+    > needs to be released with string_ref_release()! (as do all string_ref_ results)
+
+example:
+    > string_ref_trim_left(ref, "Hello ") -> "World"
+*/
+char *string_ref_trim_left(char *ref, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!ref) {return NULL;}
+
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+    size_t length_sub = substr ? strlen(substr) : 0;
+
+    if (length_sub == 0 || length_sub > length_str || memcmp(ref, substr, length_sub) != 0) {return string_ref_retain(ref);}
+
+    return string__ref_from(ref + length_sub, length_str - length_sub);
+}
+
+/*
+char *string_ref_trim_right(char *ref, char *substr)
+
+returns:
+    > <ref> with <substr> trimmed from the right, <ref> itself (retained) if it doesn't end with it
+    > NULL if invalid <ref>
+*/
+char *string_ref_trim_right(char *ref, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!ref) {return NULL;}
+
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+    size_t length_sub = substr ? strlen(substr) : 0;
+
+    if (length_sub == 0 || length_sub > length_str || memcmp(ref + length_str - length_sub, substr, length_sub) != 0) {return string_ref_retain(ref);}
+
+    return string__ref_from(ref, length_str - length_sub);
+}
+
+/*
+char *string_ref_remove(char *ref, char *substr)
+
+returns:
+    > <ref> without the first <substr>, <ref> itself (retained) if there is none
+    > NULL if invalid <ref> or <substr>
+*/
+char *string_ref_remove(char *ref, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_replace(ref, substr, "", false);
+}
+
+/*
+char *string_ref_remove_all(char *ref, char *substr)
+
+returns:
+    > <ref> without any <substr>, <ref> itself (retained) if there is none
+    > NULL if invalid <ref> or <substr>
+*/
+char *string_ref_remove_all(char *ref, char *substr)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_replace(ref, substr, "", true);
+}
+
+/*
+char *string_ref_replace(char *ref, char *substr, char *replacement)
+
+returns:
+    > <ref> with the first <substr> replaced with <replacement>, <ref> itself (retained) if there is none
+    > NULL if invalid <ref>, <substr> or <replacement>
+*/
+char *string_ref_replace(char *ref, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_replace(ref, substr, replacement, false);
+}
+
+/*
+char *string_ref_replace_all(char *ref, char *substr, char *replacement)
+
+returns:
+    > <ref> with every <substr> replaced with <replacement>, <ref> itself (retained) if there is none
+    > NULL if invalid <ref>, <substr> or <replacement>
+
+example:
+    > char *clean = string_ref_replace_all(line, "\r\n", "\n");   // no copy if <line> has no "\r\n"
+*/
+char *string_ref_replace_all(char *ref, char *substr, char *replacement)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_replace(ref, substr, replacement, true);
+}
+
+/*
+char *string_ref_shift_left(char *ref, unsigned int amount)
+
+returns:
+    > <ref> rotated <amount> characters to the left (see string_shift_left()),
+      <ref> itself (retained) if that changes nothing
+    > NULL if invalid <ref>
+*/
+char *string_ref_shift_left(char *ref, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!ref) {return NULL;}
+
+    return string__ref_rotate(ref, amount);
+}
+
+/*
+char *string_ref_shift_right(char *ref, unsigned int amount)
+
+returns:
+    > <ref> rotated <amount> characters to the right (see string_shift_right()),
+      <ref> itself (retained) if that changes nothing
+    > NULL if invalid <ref>
+*/
+char *string_ref_shift_right(char *ref, unsigned int amount)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!ref) {return NULL;}
+
+    size_t length_str = STRING__REF_HEADER(ref)->length;
+
+    return string__ref_rotate(ref, length_str ? length_str - amount % length_str : 0);
+}
+
+/*
+char *string_ref_upper(char *ref)
+
+returns:
+    > <ref> in uppercase, <ref> itself (retained) if it has no lowercase letters
+    > NULL if invalid <ref>
+*/
+char *string_ref_upper(char *ref)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_case(ref, true);
+}
+
+/*
+char *string_ref_lower(char *ref)
+
+returns:
+    > <ref> in lowercase, <ref> itself (retained) if it has no uppercase letters
+    > NULL if invalid <ref>
+*/
+char *string_ref_lower(char *ref)
+{
+    STRING__TRACK_PUBLIC();
+
+    return string__ref_case(ref, false);
+}
+
+//----------------------|
+// Approximate Matching |
+//----------------------|
+
+/*
+    Myers' bit-vector Levenshtein automaton: bit i of pv / mv says whether the score
+    of pattern row i + 1 went up / down by one from row i in the current text column.
+    Patterns longer than 64 bytes are split into 64-bit blocks chained by their
+    horizontal delta (Hyyrö's blocked variant).
+*/
+typedef struct string__myers
+{
+    uint64_t *peq;          // 256 * words, bit i of peq[c] is set if pattern[i] == c
+    uint64_t *pv;
+    uint64_t *mv;
+    size_t words;
+    size_t length;
+    uint64_t high;          // bit of the last pattern row in the last block
+
+    uint64_t storage[256 + 2];
+} string__myers;
+
+static void string__myers_init(string__myers *myers, const unsigned char *pattern, size_t length, bool reverse)
+{
+    size_t words = (length + 63) / 64;
+    if (words == 0) {words = 1;}
+
+    myers->words = words;
+    myers->length = length;
+    myers->high = 1ull << ((length - 1) & 63);
+    myers->peq = (words == 1) ? myers->storage : malloc(sizeof(uint64_t) * (256 + 2) * words);
+    myers->pv = myers->peq + 256 * words;
+    myers->mv = myers->pv + words;
+
+    memset(myers->peq, 0, sizeof(uint64_t) * 256 * words);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = pattern[reverse ? length - 1 - i : i];
+        myers->peq[(size_t)c * words + i / 64] |= 1ull << (i & 63);
+    }
+
+    for (size_t b = 0; b < words; ++b)
+    {
+        myers->pv[b] = ~0ull;
+        myers->mv[b] = 0;
+    }
+}
+
+static void string__myers_free(string__myers *myers)
+{
+    if (myers->peq != myers->storage) {free(myers->peq);}
+}
+
+/*
+    Advances every block by the text byte <c>. <hin> is the score change of row 0: +1 when
+    the text is matched from its start (edit distance), 0 when a match may start anywhere.
+    Returns the score change of the last row.
+*/
+static inline int string__myers_step(string__myers *myers, unsigned char c, int hin)
+{
+    const uint64_t *eq_row = myers->peq + (size_t)c * myers->words;
+    size_t last = myers->words - 1;
+
+    for (size_t b = 0; ; ++b)
+    {
+        uint64_t pv = myers->pv[b];
+        uint64_t mv = myers->mv[b];
+        uint64_t eq = eq_row[b];
+        uint64_t high = (b == last) ? myers->high : (1ull << 63);
+
+        uint64_t xv = eq | mv;
+
+        if (hin < 0) {eq |= 1;}
+
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        int hout = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+
+        ph <<= 1;
+        mh <<= 1;
+
+        if (hin < 0)        {mh |= 1;}
+        else if (hin > 0)   {ph |= 1;}
+
+        myers->pv[b] = mh | ~(xv | ph);
+        myers->mv[b] = ph & xv;
+
+        if (b == last) {return hout;}
+
+        hin = hout;
+    }
+}
+
+/*
+unsigned int string_edit_distance(char *a, char *b)
+
+returns:
+    > the Levenshtein distance between <a> and <b> (insertions, deletions and substitutions),
+      computed 64 characters of the shorter string at a time
+    > 0 if invalid <a> or <b>
+
+example:
+    > string_edit_distance("kitten", "sitting") -> 3
+*/
+unsigned int string_edit_distance(char *a, char *b)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!a || !b) {return 0;}
+
+    size_t length_a = strlen(a);
+    size_t length_b = strlen(b);
+
+    // The shorter one is the pattern, so it takes the fewest blocks
+    if (length_a > length_b)
+    {
+        char *swap = a; a = b; b = swap;
+        size_t swap_length = length_a; length_a = length_b; length_b = swap_length;
+    }
+
+    if (length_a == 0) {return (unsigned int)length_b;}
+
+    string__myers myers;
+    string__myers_init(&myers, (const unsigned char *)a, length_a, false);
+
+    long long score = (long long)length_a;
+
+    for (size_t i = 0; i < length_b; ++i)
+    {
+        score += string__myers_step(&myers, (unsigned char)b[i], 1);
+    }
+
+    string__myers_free(&myers);
+
+    return (unsigned int)score;
+}
+
+/*
+void string_edit_distance_batch(char *query, char **candidates, size_t count, unsigned int *distances)
+
+writes:
+    > string_edit_distance(<query>, candidates[i]) to distances[i] for each of the <count> candidates,
+      checking four candidates at once in AVX2 lanes when <query> is at most 64 bytes
+
+example:
+    > string_edit_distance_batch("recieve", words, 3, distances) -> {2, 0, 3} (for "receive", "recieve", "receiver")
+*/
+void string_edit_distance_batch(char *query, char **candidates, size_t count, unsigned int *distances)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!query || !candidates || !distances) {return;}
+
+    size_t i = 0;
+
+#if defined(ZSTRING_AVX2)
+    size_t length_query = strlen(query);
+
+    if (length_query > 0 && length_query <= 64)
+    {
+        string__myers myers;
+        string__myers_init(&myers, (const unsigned char *)query, length_query, false);
+
+        const __m256i high = _mm256_set1_epi64x((long long)myers.high);
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        const __m256i one = _mm256_set1_epi64x(1);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const unsigned char *text[4];
+            long long length[4];
+            long long longest = 0;
+            bool valid = true;
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                valid = valid && candidates[i + lane];
+                if (!valid) {break;}
+
+                text[lane] = (const unsigned char *)candidates[i + lane];
+                length[lane] = (long long)strlen(candidates[i + lane]);
+                if (length[lane] > longest) {longest = length[lane];}
+            }
+
+            if (!valid) {break;}
+
+            const __m256i lengths = _mm256_setr_epi64x(length[0], length[1], length[2], length[3]);
+
+            __m256i pv = ones;
+            __m256i mv = _mm256_setzero_si256();
+            __m256i score = _mm256_set1_epi64x((long long)length_query);
+
+            for (long long j = 0; j < longest; ++j)
+            {
+                // Lanes past the end of their candidate keep running on Eq = 0, but stop scoring
+                __m256i eq = _mm256_setr_epi64x(
+                    (long long)((j < length[0]) ? myers.peq[text[0][j]] : 0),
+                    (long long)((j < length[1]) ? myers.peq[text[1][j]] : 0),
+                    (long long)((j < length[2]) ? myers.peq[text[2][j]] : 0),
+                    (long long)((j < length[3]) ? myers.peq[text[3][j]] : 0));
+
+                __m256i active = _mm256_cmpgt_epi64(lengths, _mm256_set1_epi64x(j));
+
+                __m256i xv = _mm256_or_si256(eq, mv);
+                __m256i xh = _mm256_or_si256(_mm256_xor_si256(_mm256_add_epi64(_mm256_and_si256(eq, pv), pv), pv), eq);
+                __m256i ph = _mm256_or_si256(mv, _mm256_xor_si256(_mm256_or_si256(xh, pv), ones));
+                __m256i mh = _mm256_and_si256(pv, xh);
+
+                // All ones where the last row went up / down, i.e. -1, so subtracting / adding them scores it
+                __m256i up = _mm256_cmpeq_epi64(_mm256_and_si256(ph, high), high);
+                __m256i down = _mm256_cmpeq_epi64(_mm256_and_si256(mh, high), high);
+
+                score = _mm256_sub_epi64(score, _mm256_and_si256(_mm256_sub_epi64(up, down), active));
+
+                ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), one);
+                mh = _mm256_slli_epi64(mh, 1);
+
+                pv = _mm256_or_si256(mh, _mm256_xor_si256(_mm256_or_si256(xv, ph), ones));
+                mv = _mm256_and_si256(ph, xv);
+            }
+
+            long long scores[4];
+            _mm256_storeu_si256((__m256i *)scores, score);
+
+            for (int lane = 0; lane < 4; ++lane) {distances[i + lane] = (unsigned int)scores[lane];}
+        }
+
+        string__myers_free(&myers);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        distances[i] = string_edit_distance(query, candidates[i]);
+    }
+}
+
+/*
+int string_find_k(char *str, char *pattern, unsigned int k, unsigned int *length)
+
+returns:
+    > position of the first approximate occurence of <pattern> in <str>, i.e. the first place
+      a substring ends that is at most <k> edits away from <pattern>, with its length written
+      to <length> if not NULL (the closest start for that end, then the shortest)
+    > -1 if there is none or invalid <str> or <pattern>
+
+example:
+    > string_find_k("the quick brwn fox", "brown", 1, &length) -> 10 (length = 4, "brwn")
+*/
+int string_find_k(char *str, char *pattern, unsigned int k, unsigned int *length)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (length) {*length = 0;}
+
+    if (!str || !pattern) {return -1;}
+
+    size_t length_str = strlen(str);
+    size_t length_pat = strlen(pattern);
+
+    if (length_pat <= k) {return 0;}
+
+    // Forward search: a match may start anywhere, so row 0 stays at zero
+    string__myers myers;
+    string__myers_init(&myers, (const unsigned char *)pattern, length_pat, false);
+
+    long long score = (long long)length_pat;
+    size_t end = 0;
+    bool found = false;
+
+    for (size_t i = 0; i < length_str; ++i)
+    {
+        score += string__myers_step(&myers, (unsigned char)str[i], 0);
+
+        if (score <= (long long)k)
+        {
+            end = i + 1;
+            found = true;
+            break;
+        }
+    }
+
+    string__myers_free(&myers);
+
+    if (!found) {return -1;}
+
+    // Backward from <end> with the reversed pattern anchored there finds the best start
+    string__myers_init(&myers, (const unsigned char *)pattern, length_pat, true);
+
+    size_t reach = length_pat + k;
+    if (reach > end) {reach = end;}
+
+    long long best = (long long)length_pat;
+    size_t best_length = 0;
+    score = (long long)length_pat;
+
+    for (size_t t = 1; t <= reach; ++t)
+    {
+        score += string__myers_step(&myers, (unsigned char)str[end - t], 1);
+
+        if (score < best)
+        {
+            best = score;
+            best_length = t;
+        }
+    }
+
+    string__myers_free(&myers);
+
+    if (length) {*length = (unsigned int)best_length;}
+
+    return (int)(end - best_length);
+}
+
+//---------|
+// Sorting |
+//---------|
+
+/*
+    Multikey quicksort over a contiguous array of (8-byte prefix, string) entries:
+    ranges are partitioned on the cached big-endian prefix alone, and only a range
+    whose prefixes tie goes back to its strings to load the next 8 bytes.
+*/
+typedef struct string__sort_entry
+{
+    uint64_t key;
+    char *str;
+    size_t length;
+} string__sort_entry;
+
+#define STRING__SORT_INSERTION 16
+
+// Bytes [depth, depth + 8) of <str> as a big-endian integer, zero padded past the end
+static inline uint64_t string__sort_key(const char *str, size_t length, size_t depth)
+{
+    uint64_t key = 0;
+
+    if (depth < length)
+    {
+        size_t n = length - depth;
+        if (n > 8) {n = 8;}
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            key |= (uint64_t)(unsigned char)str[depth + i] << (56 - 8 * i);
+        }
+    }
+
+    return key;
+}
+
+// A NUL in the low byte means every string sharing this key ends inside it
+#define STRING__SORT_ENDED(key) (((key) & 0xFF) == 0)
+
+static inline int string__sort_compare(const string__sort_entry *a, const string__sort_entry *b, size_t depth)
+{
+    if (a->key != b->key) {return (a->key < b->key) ? -1 : 1;}
+    if (STRING__SORT_ENDED(a->key)) {return 0;}
+
+    return strcmp(a->str + depth + 8, b->str + depth + 8);
+}
+
+static void string__sort_range(string__sort_entry *entries, size_t count, size_t depth)
+{
+    while (count > 1)
+    {
+        if (count < STRING__SORT_INSERTION)
+        {
+            for (size_t i = 1; i < count; ++i)
+            {
+                string__sort_entry entry = entries[i];
+                size_t j = i;
+
+                while (j > 0 && string__sort_compare(&entry, &entries[j - 1], depth) < 0)
+                {
+                    entries[j] = entries[j - 1];
+                    --j;
+                }
+
+                entries[j] = entry;
+            }
+
+            return;
+        }
+
+        // Median of three prefixes
+        uint64_t a = entries[0].key;
+        uint64_t b = entries[count / 2].key;
+        uint64_t c = entries[count - 1].key;
+        uint64_t pivot = (a < b) ? ((b < c) ? b : (a < c) ? c : a) : ((a < c) ? a : (b < c) ? c : b);
+
+        // [0, lt) < pivot, [lt, i) == pivot, (gt, count) > pivot
+        size_t lt = 0;
+        size_t i = 0;
+        size_t gt = count;
+
+        while (i < gt)
+        {
+            uint64_t key = entries[i].key;
+
+            if (key < pivot)
+            {
+                string__sort_entry swap = entries[i]; entries[i] = entries[lt]; entries[lt] = swap;
+                ++lt; ++i;
+            }
+            else if (key > pivot)
+            {
+                --gt;
+                string__sort_entry swap = entries[i]; entries[i] = entries[gt]; entries[gt] = swap;
+            }
+            else {++i;}
+        }
+
+        // The equal part goes on at the next 8 bytes, unless the pivot already ended its strings
+        size_t count_lt = lt;
+        size_t count_eq = (!STRING__SORT_ENDED(pivot) && gt - lt > 1) ? gt - lt : 0;
+        size_t count_gt = count - gt;
+
+        for (size_t k = lt; k < lt + count_eq; ++k)
+        {
+            entries[k].key = string__sort_key(entries[k].str, entries[k].length, depth + 8);
+        }
+
+        // Recurse into the two smaller parts and loop on the largest, so the stack stays O(log n) deep
+        // however long a prefix the strings share
+        if (count_eq >= count_lt && count_eq >= count_gt)
+        {
+            string__sort_range(entries, count_lt, depth);
+            string__sort_range(entries + gt, count_gt, depth);
+
+            entries += lt;
+            count = count_eq;
+            depth += 8;
+        }
+        else if (count_lt >= count_gt)
+        {
+            string__sort_range(entries + lt, count_eq, depth + 8);
+            string__sort_range(entries + gt, count_gt, depth);
+
+            count = count_lt;
+        }
+        else
+        {
+            string__sort_range(entries, count_lt, depth);
+            string__sort_range(entries + lt, count_eq, depth + 8);
+
+            entries += gt;
+            count = count_gt;
+        }
+    }
+}
+
+static string__sort_entry *string__sort_entries(char **strings, size_t count)
+{
+    string__sort_entry *entries = malloc(sizeof(string__sort_entry) * count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length = strlen(strings[i]);
+
+        entries[i].str = strings[i];
+        entries[i].length = length;
+        entries[i].key = string__sort_key(strings[i], length, 0);
+    }
+
+    return entries;
+}
+
+/*
+void string_sort(char **strings, size_t count)
+
+sorts:
+    > the first <count> pointers of <strings> in place, in strcmp() order; only the pointers
+      move, so arrays from string_split_any() / string_split_substr() stay one allocation
+
+example:
+    > string_sort({"pear", "apple", "fig"}, 3) -> {"apple", "fig", "pear"}
+*/
+void string_sort(char **strings, size_t count)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!strings || count < 2) {return;}
+
+    string__sort_entry *entries = string__sort_entries(strings, count);
+
+    string__sort_range(entries, count, 0);
+
+    for (size_t i = 0; i < count; ++i) {strings[i] = entries[i].str;}
+
+    free(entries);
+}
+
+#if defined(ZSTRING_THREADS)
+
+// Entries bucketed by their first two bytes, which threads claim one at a time
+typedef struct string__sort_job
+{
+    string__sort_entry *entries;
+    size_t *offsets;        // 65536 + 1
+    size_t next;
+} string__sort_job;
+
+static void *string__sort_worker(void *argument)
+{
+    string__sort_job *job = argument;
+
+    for (;;)
+    {
+        size_t bucket = STRING__ATOMIC_ADD(&job->next, 1) - 1;
+        if (bucket >= 65536) {break;}
+
+        // Buckets of empty and one byte strings are already sorted
+        if ((bucket & 0xFF) == 0) {continue;}
+
+        size_t start = job->offsets[bucket];
+        string__sort_range(job->entries + start, job->offsets[bucket + 1] - start, 0);
+    }
+
+    return NULL;
+}
+
+#endif
+
+/*
+void string_sort_parallel(char **strings, size_t count, unsigned int threads)
+
+sorts:
+    > like string_sort(), after bucketing by the first two bytes, with <threads> threads
+      sorting buckets; needs ZSTRING_THREADS (pthreads), otherwise it is string_sort()
+
+example:
+    > string_sort_parallel(tokens, token_count, 8)
+*/
+void string_sort_parallel(char **strings, size_t count, unsigned int threads)
+{
+    STRING__TRACK_PUBLIC();
+
+#if defined(ZSTRING_THREADS)
+    if (!strings || threads < 2 || count < (1u << 16)) {string_sort(strings, count); return;}
+
+    string__sort_entry *entries = string__sort_entries(strings, count);
+    string__sort_entry *bucketed = malloc(sizeof(string__sort_entry) * count);
+    size_t *offsets = calloc(65536 + 1, sizeof(size_t));
+
+    for (size_t i = 0; i < count; ++i) {++offsets[(entries[i].key >> 48) + 1];}
+    for (size_t b = 0; b < 65536; ++b) {offsets[b + 1] += offsets[b];}
+
+    {
+        size_t *fill = malloc(sizeof(size_t) * 65536);
+        memcpy(fill, offsets, sizeof(size_t) * 65536);
+
+        for (size_t i = 0; i < count; ++i) {bucketed[fill[entries[i].key >> 48]++] = entries[i];}
+
+        free(fill);
+    }
+
+    string__sort_job job = {bucketed, offsets, 0};
+
+    pthread_t *workers = malloc(sizeof(pthread_t) * threads);
+    unsigned int started = 0;
+
+    for (; started < threads - 1; ++started)
+    {
+        if (pthread_create(&workers[started], NULL, string__sort_worker, &job) != 0) {break;}
+    }
+
+    string__sort_worker(&job);
+
+    for (unsigned int t = 0; t < started; ++t) {pthread_join(workers[t], NULL);}
+
+    for (size_t i = 0; i < count; ++i) {strings[i] = bucketed[i].str;}
+
+    free(workers);
+    free(offsets);
+    free(bucketed);
+    free(entries);
+#else
+    (void)threads;
+    string_sort(strings, count);
+#endif
+}
+
+/*
+size_t string_unique(char **strings, size_t count)
+
+returns:
+    > the number of distinct strings in the sorted first <count> pointers of <strings>,
+      which are moved to the front in order (the rest are left as they were)
+    > 0 if invalid <strings>
+
+example:
+    > string_unique({"a", "a", "b", "c", "c"}, 5) -> 3 ({"a", "b", "c", ...})
+*/
+size_t string_unique(char **strings, size_t count)
+{
+    if (!strings || count == 0) {return 0;}
+
+    size_t kept = 1;
+
+    for (size_t i = 1; i < count; ++i)
+    {
+        if (strcmp(strings[i], strings[kept - 1]) != 0) {strings[kept++] = strings[i];}
+    }
+
+    return kept;
+}
+
+//----------------|
+// Number Parsing |
+//----------------|
+
+// Little-endian load, so the first character is the low byte
+static inline uint64_t string__load_8(const char *ptr)
+{
+    uint64_t chunk;
+    memcpy(&chunk, ptr, sizeof(chunk));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+
+    return chunk;
+}
+
+// True if all 8 characters are '0'-'9'
+static inline bool string__eight_digits(uint64_t chunk)
+{
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// Value of 8 digits with SWAR: adjacent pairs, then quads, then both halves in one multiply
+static inline uint64_t string__parse_eight(uint64_t chunk)
+{
+    const uint64_t mask = 0x000000FF000000FFull;
+    const uint64_t mul1 = 100 + (1000000ull << 32);
+    const uint64_t mul2 = 1 + (10000ull << 32);
+
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+
+    return (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+}
+
+// Accumulates the digits at <ptr> into <value> (wrapping), returns how many there were
+static size_t string__parse_digits(const char *ptr, const char *end, uint64_t *value)
+{
+    const char *start = ptr;
+    uint64_t result = *value;
+
+    while (end - ptr >= 8)
+    {
+        uint64_t chunk = string__load_8(ptr);
+        if (!string__eight_digits(chunk)) {break;}
+
+        result = result * 100000000 + string__parse_eight(chunk);
+        ptr += 8;
+    }
+
+    while (ptr < end && (unsigned char)(*ptr - '0') < 10)
+    {
+        result = result * 10 + (uint64_t)(*ptr - '0');
+        ++ptr;
+    }
+
+    *value = result;
+
+    return (size_t)(ptr - start);
+}
+
+// Length of the digits at <ptr>, 0 if there are none or their value exceeds <limit>
+static size_t string__parse_uint(const char *ptr, const char *end, uint64_t limit, uint64_t *value)
+{
+    const char *start = ptr;
+
+    while (ptr < end && *ptr == '0') {++ptr;}
+
+    uint64_t result = 0;
+    size_t digits = string__parse_digits(ptr, end, &result);
+
+    if (ptr + digits == start) {return 0;}
+    if (digits > 20) {return 0;}
+
+    // 20 significant digits may have wrapped, so check them against UINT64_MAX before the last one
+    if (digits == 20)
+    {
+        uint64_t prefix = 0;
+        string__parse_digits(ptr, ptr + 19, &prefix);
+
+        if (prefix > UINT64_MAX / 10 || (prefix == UINT64_MAX / 10 && (uint64_t)(ptr[19] - '0') > UINT64_MAX % 10)) {return 0;}
+    }
+
+    if (result > limit) {return 0;}
+
+    *value = result;
+
+    return (size_t)(ptr + digits - start);
+}
+
+/*
+size_t string_parse_i64(char *buffer, size_t length, int64_t *value)
+
+returns:
+    > the number of bytes of the decimal integer (optional '+' or '-', then digits)
+      at the start of the <length> bytes at <buffer>, written to <value>
+    > 0 if there is none, it does not fit, or invalid <buffer> or <value>
+
+example:
+    > string_parse_i64("-1024 px", 8, &value) -> 5 (value = -1024)
+*/
+size_t string_parse_i64(char *buffer, size_t length, int64_t *value)
+{
+    if (!buffer || !value) {return 0;}
+
+    const char *ptr = buffer;
+    const char *end = buffer + length;
+    bool negative = false;
+
+    if (ptr < end && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    uint64_t magnitude = 0;
+    size_t digits = string__parse_uint(ptr, end, negative ? (1ull << 63) : (1ull << 63) - 1, &magnitude);
+
+    if (digits == 0) {return 0;}
+
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+
+    return (size_t)(ptr - buffer) + digits;
+}
+
+/*
+size_t string_parse_u64(char *buffer, size_t length, uint64_t *value)
+
+returns:
+    > the number of bytes of the decimal integer (optional '+', then digits)
+      at the start of the <length> bytes at <buffer>, written to <value>
+    > 0 if there is none, it does not fit, or invalid <buffer> or <value>
+
+example:
+    > string_parse_u64("18446744073709551615", 20, &value) -> 20 (value = UINT64_MAX)
+*/
+size_t string_parse_u64(char *buffer, size_t length, uint64_t *value)
+{
+    if (!buffer || !value) {return 0;}
+
+    const char *ptr = buffer;
+    const char *end = buffer + length;
+
+    if (ptr < end && *ptr == '+') {++ptr;}
+
+    size_t digits = string__parse_uint(ptr, end, UINT64_MAX, value);
+
+    return (digits == 0) ? 0 : (size_t)(ptr - buffer) + digits;
+}
+
+/*
+    Correctly rounded decimal to double after Daniel Lemire's "Number Parsing at a Gigabyte
+    per Second" (Eisel-Lemire): 5^q truncated to 128 bits for q in [-342, 308], {low, high}.
+*/
+static const uint64_t string__pow5_128[651][2] = {
+    {0x113FAA2906A13B3Fu, 0xEEF453D6923BD65Au}, {0x4AC7CA59A424C507u, 0x9558B4661B6565F8u},
+    {0x5D79BCF00D2DF649u, 0xBAAEE17FA23EBF76u}, {0xF4D82C2C107973DCu, 0xE95A99DF8ACE6F53u},
+    {0x79071B9B8A4BE869u, 0x91D8A02BB6C10594u}, {0x9748E2826CDEE284u, 0xB64EC836A47146F9u},
+    {0xFD1B1B2308169B25u, 0xE3E27A444D8D98B7u}, {0xFE30F0F5E50E20F7u, 0x8E6D8C6AB0787F72u},
+    {0xBDBD2D335E51A935u, 0xB208EF855C969F4Fu}, {0xAD2C788035E61382u, 0xDE8B2B66B3BC4723u},
+    {0x4C3BCB5021AFCC31u, 0x8B16FB203055AC76u}, {0xDF4ABE242A1BBF3Du, 0xADDCB9E83C6B1793u},
+    {0xD71D6DAD34A2AF0Du, 0xD953E8624B85DD78u}, {0x8672648C40E5AD68u, 0x87D4713D6F33AA6Bu},
+    {0x680EFDAF511F18C2u, 0xA9C98D8CCB009506u}, {0x0212BD1B2566DEF2u, 0xD43BF0EFFDC0BA48u},
+    {0x014BB630F7604B57u, 0x84A57695FE98746Du}, {0x419EA3BD35385E2Du, 0xA5CED43B7E3E9188u},
+    {0x52064CAC828675B9u, 0xCF42894A5DCE35EAu}, {0x7343EFEBD1940993u, 0x818995CE7AA0E1B2u},
+    {0x1014EBE6C5F90BF8u, 0xA1EBFB4219491A1Fu}, {0xD41A26E077774EF6u, 0xCA66FA129F9B60A6u},
+    {0x8920B098955522B4u, 0xFD00B897478238D0u}, {0x55B46E5F5D5535B0u, 0x9E20735E8CB16382u},
+    {0xEB2189F734AA831Du, 0xC5A890362FDDBC62u}, {0xA5E9EC7501D523E4u, 0xF712B443BBD52B7Bu},
+    {0x47B233C92125366Eu, 0x9A6BB0AA55653B2Du}, {0x999EC0BB696E840Au, 0xC1069CD4EABE89F8u},
+    {0xC00670EA43CA250Du, 0xF148440A256E2C76u}, {0x380406926A5E5728u, 0x96CD2A865764DBCAu},
+    {0xC605083704F5ECF2u, 0xBC807527ED3E12BCu}, {0xF7864A44C633682Eu, 0xEBA09271E88D976Bu},
+    {0x7AB3EE6AFBE0211Du, 0x93445B8731587EA3u}, {0x5960EA05BAD82964u, 0xB8157268FDAE9E4Cu},
+    {0x6FB92487298E33BDu, 0xE61ACF033D1A45DFu}, {0xA5D3B6D479F8E056u, 0x8FD0C16206306BABu},
+    {0x8F48A4899877186Cu, 0xB3C4F1BA87BC8696u}, {0x331ACDABFE94DE87u, 0xE0B62E2929ABA83Cu},
+    {0x9FF0C08B7F1D0B14u, 0x8C71DCD9BA0B4925u}, {0x07ECF0AE5EE44DD9u, 0xAF8E5410288E1B6Fu},
+    {0xC9E82CD9F69D6150u, 0xDB71E91432B1A24Au}, {0xBE311C083A225CD2u, 0x892731AC9FAF056Eu},
+    {0x6DBD630A48AAF406u, 0xAB70FE17C79AC6CAu}, {0x092CBBCCDAD5B108u, 0xD64D3D9DB981787Du},
+    {0x25BBF56008C58EA5u, 0x85F0468293F0EB4Eu}, {0xAF2AF2B80AF6F24Eu, 0xA76C582338ED2621u},
+    {0x1AF5AF660DB4AEE1u, 0xD1476E2C07286FAAu}, {0x50D98D9FC890ED4Du, 0x82CCA4DB847945CAu},
+    {0xE50FF107BAB528A0u, 0xA37FCE126597973Cu}, {0x1E53ED49A96272C8u, 0xCC5FC196FEFD7D0Cu},
+    {0x25E8E89C13BB0F7Au, 0xFF77B1FCBEBCDC4Fu}, {0x77B191618C54E9ACu, 0x9FAACF3DF73609B1u},
+    {0xD59DF5B9EF6A2417u, 0xC795830D75038C1Du}, {0x4B0573286B44AD1Du, 0xF97AE3D0D2446F25u},
+    {0x4EE367F9430AEC32u, 0x9BECCE62836AC577u}, {0x229C41F793CDA73Fu, 0xC2E801FB244576D5u},
+    {0x6B43527578C1110Fu, 0xF3A20279ED56D48Au}, {0x830A13896B78AAA9u, 0x9845418C345644D6u},
+    {0x23CC986BC656D553u, 0xBE5691EF416BD60Cu}, {0x2CBFBE86B7EC8AA8u, 0xEDEC366B11C6CB8Fu},
+    {0x7BF7D71432F3D6A9u, 0x94B3A202EB1C3F39u}, {0xDAF5CCD93FB0CC53u, 0xB9E08A83A5E34F07u},
+    {0xD1B3400F8F9CFF68u, 0xE858AD248F5C22C9u}, {0x23100809B9C21FA1u, 0x91376C36D99995BEu},
+    {0xABD40A0C2832A78Au, 0xB58547448FFFFB2Du}, {0x16C90C8F323F516Cu, 0xE2E69915B3FFF9F9u},
+    {0xAE3DA7D97F6792E3u, 0x8DD01FAD907FFC3Bu}, {0x99CD11CFDF41779Cu, 0xB1442798F49FFB4Au},
+    {0x40405643D711D583u, 0xDD95317F31C7FA1Du}, {0x482835EA666B2572u, 0x8A7D3EEF7F1CFC52u},
+    {0xDA3243650005EECFu, 0xAD1C8EAB5EE43B66u}, {0x90BED43E40076A82u, 0xD863B256369D4A40u},
+    {0x5A7744A6E804A291u, 0x873E4F75E2224E68u}, {0x711515D0A205CB36u, 0xA90DE3535AAAE202u},
+    {0x0D5A5B44CA873E03u, 0xD3515C2831559A83u}, {0xE858790AFE9486C2u, 0x8412D9991ED58091u},
+    {0x626E974DBE39A872u, 0xA5178FFF668AE0B6u}, {0xFB0A3D212DC8128Fu, 0xCE5D73FF402D98E3u},
+    {0x7CE66634BC9D0B99u, 0x80FA687F881C7F8Eu}, {0x1C1FFFC1EBC44E80u, 0xA139029F6A239F72u},
+    {0xA327FFB266B56220u, 0xC987434744AC874Eu}, {0x4BF1FF9F0062BAA8u, 0xFBE9141915D7A922u},
+    {0x6F773FC3603DB4A9u, 0x9D71AC8FADA6C9B5u}, {0xCB550FB4384D21D3u, 0xC4CE17B399107C22u},
+    {0x7E2A53A146606A48u, 0xF6019DA07F549B2Bu}, {0x2EDA7444CBFC426Du, 0x99C102844F94E0FBu},
+    {0xFA911155FEFB5308u, 0xC0314325637A1939u}, {0x793555AB7EBA27CAu, 0xF03D93EEBC589F88u},
+    {0x4BC1558B2F3458DEu, 0x96267C7535B763B5u}, {0x9EB1AAEDFB016F16u, 0xBBB01B9283253CA2u},
+    {0x465E15A979C1CADCu, 0xEA9C227723EE8BCBu}, {0x0BFACD89EC191EC9u, 0x92A1958A7675175Fu},
+    {0xCEF980EC671F667Bu, 0xB749FAED14125D36u}, {0x82B7E12780E7401Au, 0xE51C79A85916F484u},
+    {0xD1B2ECB8B0908810u, 0x8F31CC0937AE58D2u}, {0x861FA7E6DCB4AA15u, 0xB2FE3F0B8599EF07u},
+    {0x67A791E093E1D49Au, 0xDFBDCECE67006AC9u}, {0xE0C8BB2C5C6D24E0u, 0x8BD6A141006042BDu},
+    {0x58FAE9F773886E18u, 0xAECC49914078536Du}, {0xAF39A475506A899Eu, 0xDA7F5BF590966848u},
+    {0x6D8406C952429603u, 0x888F99797A5E012Du}, {0xC8E5087BA6D33B83u, 0xAAB37FD7D8F58178u},
+    {0xFB1E4A9A90880A64u, 0xD5605FCDCF32E1D6u}, {0x5CF2EEA09A55067Fu, 0x855C3BE0A17FCD26u},
+    {0xF42FAA48C0EA481Eu, 0xA6B34AD8C9DFC06Fu}, {0xF13B94DAF124DA26u, 0xD0601D8EFC57B08Bu},
+    {0x76C53D08D6B70858u, 0x823C12795DB6CE57u}, {0x54768C4B0C64CA6Eu, 0xA2CB1717B52481EDu},
+    {0xA9942F5DCF7DFD09u, 0xCB7DDCDDA26DA268u}, {0xD3F93B35435D7C4Cu, 0xFE5D54150B090B02u},
+    {0xC47BC5014A1A6DAFu, 0x9EFA548D26E5A6E1u}, {0x359AB6419CA1091Bu, 0xC6B8E9B0709F109Au},
+    {0xC30163D203C94B62u, 0xF867241C8CC6D4C0u}, {0x79E0DE63425DCF1Du, 0x9B407691D7FC44F8u},
+    {0x985915FC12F542E4u, 0xC21094364DFB5636u}, {0x3E6F5B7B17B2939Du, 0xF294B943E17A2BC4u},
+    {0xA705992CEECF9C42u, 0x979CF3CA6CEC5B5Au}, {0x50C6FF782A838353u, 0xBD8430BD08277231u},
+    {0xA4F8BF5635246428u, 0xECE53CEC4A314EBDu}, {0x871B7795E136BE99u, 0x940F4613AE5ED136u},
+    {0x28E2557B59846E3Fu, 0xB913179899F68584u}, {0x331AEADA2FE589CFu, 0xE757DD7EC07426E5u},
+    {0x3FF0D2C85DEF7621u, 0x9096EA6F3848984Fu}, {0x0FED077A756B53A9u, 0xB4BCA50B065ABE63u},
+    {0xD3E8495912C62894u, 0xE1EBCE4DC7F16DFBu}, {0x64712DD7ABBBD95Cu, 0x8D3360F09CF6E4BDu},
+    {0xBD8D794D96AACFB3u, 0xB080392CC4349DECu}, {0xECF0D7A0FC5583A0u, 0xDCA04777F541C567u},
+    {0xF41686C49DB57244u, 0x89E42CAAF9491B60u}, {0x311C2875C522CED5u, 0xAC5D37D5B79B6239u},
+    {0x7D633293366B828Bu, 0xD77485CB25823AC7u}, {0xAE5DFF9C02033197u, 0x86A8D39EF77164BCu},
+    {0xD9F57F830283FDFCu, 0xA8530886B54DBDEBu}, {0xD072DF63C324FD7Bu, 0xD267CAA862A12D66u},
+    {0x4247CB9E59F71E6Du, 0x8380DEA93DA4BC60u}, {0x52D9BE85F074E608u, 0xA46116538D0DEB78u},
+    {0x67902E276C921F8Bu, 0xCD795BE870516656u}, {0x00BA1CD8A3DB53B6u, 0x806BD9714632DFF6u},
+    {0x80E8A40ECCD228A4u, 0xA086CFCD97BF97F3u}, {0x6122CD128006B2CDu, 0xC8A883C0FDAF7DF0u},
+    {0x796B805720085F81u, 0xFAD2A4B13D1B5D6Cu}, {0xCBE3303674053BB0u, 0x9CC3A6EEC6311A63u},
+    {0xBEDBFC4411068A9Cu, 0xC3F490AA77BD60FCu}, {0xEE92FB5515482D44u, 0xF4F1B4D515ACB93Bu},
+    {0x751BDD152D4D1C4Au, 0x991711052D8BF3C5u}, {0xD262D45A78A0635Du, 0xBF5CD54678EEF0B6u},
+    {0x86FB897116C87C34u, 0xEF340A98172AACE4u}, {0xD45D35E6AE3D4DA0u, 0x9580869F0E7AAC0Eu},
+    {0x8974836059CCA109u, 0xBAE0A846D2195712u}, {0x2BD1A438703FC94Bu, 0xE998D258869FACD7u},
+    {0x7B6306A34627DDCFu, 0x91FF83775423CC06u}, {0x1A3BC84C17B1D542u, 0xB67F6455292CBF08u},
+    {0x20CABA5F1D9E4A93u, 0xE41F3D6A7377EECAu}, {0x547EB47B7282EE9Cu, 0x8E938662882AF53Eu},
+    {0xE99E619A4F23AA43u, 0xB23867FB2A35B28Du}, {0x6405FA00E2EC94D4u, 0xDEC681F9F4C31F31u},
+    {0xDE83BC408DD3DD04u, 0x8B3C113C38F9F37Eu}, {0x9624AB50B148D445u, 0xAE0B158B4738705Eu},
+    {0x3BADD624DD9B0957u, 0xD98DDAEE19068C76u}, {0xE54CA5D70A80E5D6u, 0x87F8A8D4CFA417C9u},
+    {0x5E9FCF4CCD211F4Cu, 0xA9F6D30A038D1DBCu}, {0x7647C3200069671Fu, 0xD47487CC8470652Bu},
+    {0x29ECD9F40041E073u, 0x84C8D4DFD2C63F3Bu}, {0xF468107100525890u, 0xA5FB0A17C777CF09u},
+    {0x7182148D4066EEB4u, 0xCF79CC9DB955C2CCu}, {0xC6F14CD848405530u, 0x81AC1FE293D599BFu},
+    {0xB8ADA00E5A506A7Cu, 0xA21727DB38CB002Fu}, {0xA6D90811F0E4851Cu, 0xCA9CF1D206FDC03Bu},
+    {0x908F4A166D1DA663u, 0xFD442E4688BD304Au}, {0x9A598E4E043287FEu, 0x9E4A9CEC15763E2Eu},
+    {0x40EFF1E1853F29FDu, 0xC5DD44271AD3CDBAu}, {0xD12BEE59E68EF47Cu, 0xF7549530E188C128u},
+    {0x82BB74F8301958CEu, 0x9A94DD3E8CF578B9u}, {0xE36A52363C1FAF01u, 0xC13A148E3032D6E7u},
+    {0xDC44E6C3CB279AC1u, 0xF18899B1BC3F8CA1u}, {0x29AB103A5EF8C0B9u, 0x96F5600F15A7B7E5u},
+    {0x7415D448F6B6F0E7u, 0xBCB2B812DB11A5DEu}, {0x111B495B3464AD21u, 0xEBDF661791D60F56u},
+    {0xCAB10DD900BEEC34u, 0x936B9FCEBB25C995u}, {0x3D5D514F40EEA742u, 0xB84687C269EF3BFBu},
+    {0x0CB4A5A3112A5112u, 0xE65829B3046B0AFAu}, {0x47F0E785EABA72ABu, 0x8FF71A0FE2C2E6DCu},
+    {0x59ED216765690F56u, 0xB3F4E093DB73A093u}, {0x306869C13EC3532Cu, 0xE0F218B8D25088B8u},
+    {0x1E414218C73A13FBu, 0x8C974F7383725573u}, {0xE5D1929EF90898FAu, 0xAFBD2350644EEACFu},
+    {0xDF45F746B74ABF39u, 0xDBAC6C247D62A583u}, {0x6B8BBA8C328EB783u, 0x894BC396CE5DA772u},
+    {0x066EA92F3F326564u, 0xAB9EB47C81F5114Fu}, {0xC80A537B0EFEFEBDu, 0xD686619BA27255A2u},
+    {0xBD06742CE95F5F36u, 0x8613FD0145877585u}, {0x2C48113823B73704u, 0xA798FC4196E952E7u},
+    {0xF75A15862CA504C5u, 0xD17F3B51FCA3A7A0u}, {0x9A984D73DBE722FBu, 0x82EF85133DE648C4u},
+    {0xC13E60D0D2E0EBBAu, 0xA3AB66580D5FDAF5u}, {0x318DF905079926A8u, 0xCC963FEE10B7D1B3u},
+    {0xFDF17746497F7052u, 0xFFBBCFE994E5C61Fu}, {0xFEB6EA8BEDEFA633u, 0x9FD561F1FD0F9BD3u},
+    {0xFE64A52EE96B8FC0u, 0xC7CABA6E7C5382C8u}, {0x3DFDCE7AA3C673B0u, 0xF9BD690A1B68637Bu},
+    {0x06BEA10CA65C084Eu, 0x9C1661A651213E2Du}, {0x486E494FCFF30A62u, 0xC31BFA0FE5698DB8u},
+    {0x5A89DBA3C3EFCCFAu, 0xF3E2F893DEC3F126u}, {0xF89629465A75E01Cu, 0x986DDB5C6B3A76B7u},
+    {0xF6BBB397F1135823u, 0xBE89523386091465u}, {0x746AA07DED582E2Cu, 0xEE2BA6C0678B597Fu},
+    {0xA8C2A44EB4571CDCu, 0x94DB483840B717EFu}, {0x92F34D62616CE413u, 0xBA121A4650E4DDEBu},
+    {0x77B020BAF9C81D17u, 0xE896A0D7E51E1566u}, {0x0ACE1474DC1D122Eu, 0x915E2486EF32CD60u},
+    {0x0D819992132456BAu, 0xB5B5ADA8AAFF80B8u}, {0x10E1FFF697ED6C69u, 0xE3231912D5BF60E6u},
+    {0xCA8D3FFA1EF463C1u, 0x8DF5EFABC5979C8Fu}, {0xBD308FF8A6B17CB2u, 0xB1736B96B6FD83B3u},
+    {0xAC7CB3F6D05DDBDEu, 0xDDD0467C64BCE4A0u}, {0x6BCDF07A423AA96Bu, 0x8AA22C0DBEF60EE4u},
+    {0x86C16C98D2C953C6u, 0xAD4AB7112EB3929Du}, {0xE871C7BF077BA8B7u, 0xD89D64D57A607744u},
+    {0x11471CD764AD4972u, 0x87625F056C7C4A8Bu}, {0xD598E40D3DD89BCFu, 0xA93AF6C6C79B5D2Du},
+    {0x4AFF1D108D4EC2C3u, 0xD389B47879823479u}, {0xCEDF722A585139BAu, 0x843610CB4BF160CBu},
+    {0xC2974EB4EE658828u, 0xA54394FE1EEDB8FEu}, {0x733D226229FEEA32u, 0xCE947A3DA6A9273Eu},
+    {0x0806357D5A3F525Fu, 0x811CCC668829B887u}, {0xCA07C2DCB0CF26F7u, 0xA163FF802A3426A8u},
+    {0xFC89B393DD02F0B5u, 0xC9BCFF6034C13052u}, {0xBBAC2078D443ACE2u, 0xFC2C3F3841F17C67u},
+    {0xD54B944B84AA4C0Du, 0x9D9BA7832936EDC0u}, {0x0A9E795E65D4DF11u, 0xC5029163F384A931u},
+    {0x4D4617B5FF4A16D5u, 0xF64335BCF065D37Du}, {0x504BCED1BF8E4E45u, 0x99EA0196163FA42Eu},
+    {0xE45EC2862F71E1D6u, 0xC06481FB9BCF8D39u}, {0x5D767327BB4E5A4Cu, 0xF07DA27A82C37088u},
+    {0x3A6A07F8D510F86Fu, 0x964E858C91BA2655u}, {0x890489F70A55368Bu, 0xBBE226EFB628AFEAu},
+    {0x2B45AC74CCEA842Eu, 0xEADAB0ABA3B2DBE5u}, {0x3B0B8BC90012929Du, 0x92C8AE6B464FC96Fu},
+    {0x09CE6EBB40173744u, 0xB77ADA0617E3BBCBu}, {0xCC420A6A101D0515u, 0xE55990879DDCAABDu},
+    {0x9FA946824A12232Du, 0x8F57FA54C2A9EAB6u}, {0x47939822DC96ABF9u, 0xB32DF8E9F3546564u},
+    {0x59787E2B93BC56F7u, 0xDFF9772470297EBDu}, {0x57EB4EDB3C55B65Au, 0x8BFBEA76C619EF36u},
+    {0xEDE622920B6B23F1u, 0xAEFAE51477A06B03u}, {0xE95FAB368E45ECEDu, 0xDAB99E59958885C4u},
+    {0x11DBCB0218EBB414u, 0x88B402F7FD75539Bu}, {0xD652BDC29F26A119u, 0xAAE103B5FCD2A881u},
+    {0x4BE76D3346F0495Fu, 0xD59944A37C0752A2u}, {0x6F70A4400C562DDBu, 0x857FCAE62D8493A5u},
+    {0xCB4CCD500F6BB952u, 0xA6DFBD9FB8E5B88Eu}, {0x7E2000A41346A7A7u, 0xD097AD07A71F26B2u},
+    {0x8ED400668C0C28C8u, 0x825ECC24C873782Fu}, {0x728900802F0F32FAu, 0xA2F67F2DFA90563Bu},
+    {0x4F2B40A03AD2FFB9u, 0xCBB41EF979346BCAu}, {0xE2F610C84987BFA8u, 0xFEA126B7D78186BCu},
+    {0x0DD9CA7D2DF4D7C9u, 0x9F24B832E6B0F436u}, {0x91503D1C79720DBBu, 0xC6EDE63FA05D3143u},
+    {0x75A44C6397CE912Au, 0xF8A95FCF88747D94u}, {0xC986AFBE3EE11ABAu, 0x9B69DBE1B548CE7Cu},
+    {0xFBE85BADCE996168u, 0xC24452DA229B021Bu}, {0xFAE27299423FB9C3u, 0xF2D56790AB41C2A2u},
+    {0xDCCD879FC967D41Au, 0x97C560BA6B0919A5u}, {0x5400E987BBC1C920u, 0xBDB6B8E905CB600Fu},
+    {0x290123E9AAB23B68u, 0xED246723473E3813u}, {0xF9A0B6720AAF6521u, 0x9436C0760C86E30Bu},
+    {0xF808E40E8D5B3E69u, 0xB94470938FA89BCEu}, {0xB60B1D1230B20E04u, 0xE7958CB87392C2C2u},
+    {0xB1C6F22B5E6F48C2u, 0x90BD77F3483BB9B9u}, {0x1E38AEB6360B1AF3u, 0xB4ECD5F01A4AA828u},
+    {0x25C6DA63C38DE1B0u, 0xE2280B6C20DD5232u}, {0x579C487E5A38AD0Eu, 0x8D590723948A535Fu},
+    {0x2D835A9DF0C6D851u, 0xB0AF48EC79ACE837u}, {0xF8E431456CF88E65u, 0xDCDB1B2798182244u},
+    {0x1B8E9ECB641B58FFu, 0x8A08F0F8BF0F156Bu}, {0xE272467E3D222F3Fu, 0xAC8B2D36EED2DAC5u},
+    {0x5B0ED81DCC6ABB0Fu, 0xD7ADF884AA879177u}, {0x98E947129FC2B4E9u, 0x86CCBB52EA94BAEAu},
+    {0x3F2398D747B36224u, 0xA87FEA27A539E9A5u}, {0x8EEC7F0D19A03AADu, 0xD29FE4B18E88640Eu},
+    {0x1953CF68300424ACu, 0x83A3EEEEF9153E89u}, {0x5FA8C3423C052DD7u, 0xA48CEAAAB75A8E2Bu},
+    {0x3792F412CB06794Du, 0xCDB02555653131B6u}, {0xE2BBD88BBEE40BD0u, 0x808E17555F3EBF11u},
+    {0x5B6ACEAEAE9D0EC4u, 0xA0B19D2AB70E6ED6u}, {0xF245825A5A445275u, 0xC8DE047564D20A8Bu},
+    {0xEED6E2F0F0D56712u, 0xFB158592BE068D2Eu}, {0x55464DD69685606Bu, 0x9CED737BB6C4183Du},
+    {0xAA97E14C3C26B886u, 0xC428D05AA4751E4Cu}, {0xD53DD99F4B3066A8u, 0xF53304714D9265DFu},
+    {0xE546A8038EFE4029u, 0x993FE2C6D07B7FABu}, {0xDE98520472BDD033u, 0xBF8FDB78849A5F96u},
+    {0x963E66858F6D4440u, 0xEF73D256A5C0F77Cu}, {0xDDE7001379A44AA8u, 0x95A8637627989AADu},
+    {0x5560C018580D5D52u, 0xBB127C53B17EC159u}, {0xAAB8F01E6E10B4A6u, 0xE9D71B689DDE71AFu},
+    {0xCAB3961304CA70E8u, 0x9226712162AB070Du}, {0x3D607B97C5FD0D22u, 0xB6B00D69BB55C8D1u},
+    {0x8CB89A7DB77C506Au, 0xE45C10C42A2B3B05u}, {0x77F3608E92ADB242u, 0x8EB98A7A9A5B04E3u},
+    {0x55F038B237591ED3u, 0xB267ED1940F1C61Cu}, {0x6B6C46DEC52F6688u, 0xDF01E85F912E37A3u},
+    {0x2323AC4B3B3DA015u, 0x8B61313BBABCE2C6u}, {0xABEC975E0A0D081Au, 0xAE397D8AA96C1B77u},
+    {0x96E7BD358C904A21u, 0xD9C7DCED53C72255u}, {0x7E50D64177DA2E54u, 0x881CEA14545C7575u},
+    {0xDDE50BD1D5D0B9E9u, 0xAA242499697392D2u}, {0x955E4EC64B44E864u, 0xD4AD2DBFC3D07787u},
+    {0xBD5AF13BEF0B113Eu, 0x84EC3C97DA624AB4u}, {0xECB1AD8AEACDD58Eu, 0xA6274BBDD0FADD61u},
+    {0x67DE18EDA5814AF2u, 0xCFB11EAD453994BAu}, {0x80EACF948770CED7u, 0x81CEB32C4B43FCF4u},
+    {0xA1258379A94D028Du, 0xA2425FF75E14FC31u}, {0x096EE45813A04330u, 0xCAD2F7F5359A3B3Eu},
+    {0x8BCA9D6E188853FCu, 0xFD87B5F28300CA0Du}, {0x775EA264CF55347Eu, 0x9E74D1B791E07E48u},
+    {0x95364AFE032A819Eu, 0xC612062576589DDAu}, {0x3A83DDBD83F52205u, 0xF79687AED3EEC551u},
+    {0xC4926A9672793543u, 0x9ABE14CD44753B52u}, {0x75B7053C0F178294u, 0xC16D9A0095928A27u},
+    {0x5324C68B12DD6339u, 0xF1C90080BAF72CB1u}, {0xD3F6FC16EBCA5E04u, 0x971DA05074DA7BEEu},
+    {0x88F4BB1CA6BCF585u, 0xBCE5086492111AEAu}, {0x2B31E9E3D06C32E6u, 0xEC1E4A7DB69561A5u},
+    {0x3AFF322E62439FD0u, 0x9392EE8E921D5D07u}, {0x09BEFEB9FAD487C3u, 0xB877AA3236A4B449u},
+    {0x4C2EBE687989A9B4u, 0xE69594BEC44DE15Bu}, {0x0F9D37014BF60A11u, 0x901D7CF73AB0ACD9u},
+    {0x538484C19EF38C95u, 0xB424DC35095CD80Fu}, {0x2865A5F206B06FBAu, 0xE12E13424BB40E13u},
+    {0xF93F87B7442E45D4u, 0x8CBCCC096F5088CBu}, {0xF78F69A51539D749u, 0xAFEBFF0BCB24AAFEu},
+    {0xB573440E5A884D1Cu, 0xDBE6FECEBDEDD5BEu}, {0x31680A88F8953031u, 0x89705F4136B4A597u},
+    {0xFDC20D2B36BA7C3Eu, 0xABCC77118461CEFCu}, {0x3D32907604691B4Du, 0xD6BF94D5E57A42BCu},
+    {0xA63F9A49C2C1B110u, 0x8637BD05AF6C69B5u}, {0x0FCF80DC33721D54u, 0xA7C5AC471B478423u},
+    {0xD3C36113404EA4A9u, 0xD1B71758E219652Bu}, {0x645A1CAC083126EAu, 0x83126E978D4FDF3Bu},
+    {0x3D70A3D70A3D70A4u, 0xA3D70A3D70A3D70Au}, {0xCCCCCCCCCCCCCCCDu, 0xCCCCCCCCCCCCCCCCu},
+    {0x0000000000000000u, 0x8000000000000000u}, {0x0000000000000000u, 0xA000000000000000u},
+    {0x0000000000000000u, 0xC800000000000000u}, {0x0000000000000000u, 0xFA00000000000000u},
+    {0x0000000000000000u, 0x9C40000000000000u}, {0x0000000000000000u, 0xC350000000000000u},
+    {0x0000000000000000u, 0xF424000000000000u}, {0x0000000000000000u, 0x9896800000000000u},
+    {0x0000000000000000u, 0xBEBC200000000000u}, {0x0000000000000000u, 0xEE6B280000000000u},
+    {0x0000000000000000u, 0x9502F90000000000u}, {0x0000000000000000u, 0xBA43B74000000000u},
+    {0x0000000000000000u, 0xE8D4A51000000000u}, {0x0000000000000000u, 0x9184E72A00000000u},
+    {0x0000000000000000u, 0xB5E620F480000000u}, {0x0000000000000000u, 0xE35FA931A0000000u},
+    {0x0000000000000000u, 0x8E1BC9BF04000000u}, {0x0000000000000000u, 0xB1A2BC2EC5000000u},
+    {0x0000000000000000u, 0xDE0B6B3A76400000u}, {0x0000000000000000u, 0x8AC7230489E80000u},
+    {0x0000000000000000u, 0xAD78EBC5AC620000u}, {0x0000000000000000u, 0xD8D726B7177A8000u},
+    {0x0000000000000000u, 0x878678326EAC9000u}, {0x0000000000000000u, 0xA968163F0A57B400u},
+    {0x0000000000000000u, 0xD3C21BCECCEDA100u}, {0x0000000000000000u, 0x84595161401484A0u},
+    {0x0000000000000000u, 0xA56FA5B99019A5C8u}, {0x0000000000000000u, 0xCECB8F27F4200F3Au},
+    {0x4000000000000000u, 0x813F3978F8940984u}, {0x5000000000000000u, 0xA18F07D736B90BE5u},
+    {0xA400000000000000u, 0xC9F2C9CD04674EDEu}, {0x4D00000000000000u, 0xFC6F7C4045812296u},
+    {0xF020000000000000u, 0x9DC5ADA82B70B59Du}, {0x6C28000000000000u, 0xC5371912364CE305u},
+    {0xC732000000000000u, 0xF684DF56C3E01BC6u}, {0x3C7F400000000000u, 0x9A130B963A6C115Cu},
+    {0x4B9F100000000000u, 0xC097CE7BC90715B3u}, {0x1E86D40000000000u, 0xF0BDC21ABB48DB20u},
+    {0x1314448000000000u, 0x96769950B50D88F4u}, {0x17D955A000000000u, 0xBC143FA4E250EB31u},
+    {0x5DCFAB0800000000u, 0xEB194F8E1AE525FDu}, {0x5AA1CAE500000000u, 0x92EFD1B8D0CF37BEu},
+    {0xF14A3D9E40000000u, 0xB7ABC627050305ADu}, {0x6D9CCD05D0000000u, 0xE596B7B0C643C719u},
+    {0xE4820023A2000000u, 0x8F7E32CE7BEA5C6Fu}, {0xDDA2802C8A800000u, 0xB35DBF821AE4F38Bu},
+    {0xD50B2037AD200000u, 0xE0352F62A19E306Eu}, {0x4526F422CC340000u, 0x8C213D9DA502DE45u},
+    {0x9670B12B7F410000u, 0xAF298D050E4395D6u}, {0x3C0CDD765F114000u, 0xDAF3F04651D47B4Cu},
+    {0xA5880A69FB6AC800u, 0x88D8762BF324CD0Fu}, {0x8EEA0D047A457A00u, 0xAB0E93B6EFEE0053u},
+    {0x72A4904598D6D880u, 0xD5D238A4ABE98068u}, {0x47A6DA2B7F864750u, 0x85A36366EB71F041u},
+    {0x999090B65F67D924u, 0xA70C3C40A64E6C51u}, {0xFFF4B4E3F741CF6Du, 0xD0CF4B50CFE20765u},
+    {0xBFF8F10E7A8921A4u, 0x82818F1281ED449Fu}, {0xAFF72D52192B6A0Du, 0xA321F2D7226895C7u},
+    {0x9BF4F8A69F764490u, 0xCBEA6F8CEB02BB39u}, {0x02F236D04753D5B4u, 0xFEE50B7025C36A08u},
+    {0x01D762422C946590u, 0x9F4F2726179A2245u}, {0x424D3AD2B7B97EF5u, 0xC722F0EF9D80AAD6u},
+    {0xD2E0898765A7DEB2u, 0xF8EBAD2B84E0D58Bu}, {0x63CC55F49F88EB2Fu, 0x9B934C3B330C8577u},
+    {0x3CBF6B71C76B25FBu, 0xC2781F49FFCFA6D5u}, {0x8BEF464E3945EF7Au, 0xF316271C7FC3908Au},
+    {0x97758BF0E3CBB5ACu, 0x97EDD871CFDA3A56u}, {0x3D52EEED1CBEA317u, 0xBDE94E8E43D0C8ECu},
+    {0x4CA7AAA863EE4BDDu, 0xED63A231D4C4FB27u}, {0x8FE8CAA93E74EF6Au, 0x945E455F24FB1CF8u},
+    {0xB3E2FD538E122B44u, 0xB975D6B6EE39E436u}, {0x60DBBCA87196B616u, 0xE7D34C64A9C85D44u},
+    {0xBC8955E946FE31CDu, 0x90E40FBEEA1D3A4Au}, {0x6BABAB6398BDBE41u, 0xB51D13AEA4A488DDu},
+    {0xC696963C7EED2DD1u, 0xE264589A4DCDAB14u}, {0xFC1E1DE5CF543CA2u, 0x8D7EB76070A08AECu},
+    {0x3B25A55F43294BCBu, 0xB0DE65388CC8ADA8u}, {0x49EF0EB713F39EBEu, 0xDD15FE86AFFAD912u},
+    {0x6E3569326C784337u, 0x8A2DBF142DFCC7ABu}, {0x49C2C37F07965404u, 0xACB92ED9397BF996u},
+    {0xDC33745EC97BE906u, 0xD7E77A8F87DAF7FBu}, {0x69A028BB3DED71A3u, 0x86F0AC99B4E8DAFDu},
+    {0xC40832EA0D68CE0Cu, 0xA8ACD7C0222311BCu}, {0xF50A3FA490C30190u, 0xD2D80DB02AABD62Bu},
+    {0x792667C6DA79E0FAu, 0x83C7088E1AAB65DBu}, {0x577001B891185938u, 0xA4B8CAB1A1563F52u},
+    {0xED4C0226B55E6F86u, 0xCDE6FD5E09ABCF26u}, {0x544F8158315B05B4u, 0x80B05E5AC60B6178u},
+    {0x696361AE3DB1C721u, 0xA0DC75F1778E39D6u}, {0x03BC3A19CD1E38E9u, 0xC913936DD571C84Cu},
+    {0x04AB48A04065C723u, 0xFB5878494ACE3A5Fu}, {0x62EB0D64283F9C76u, 0x9D174B2DCEC0E47Bu},
+    {0x3BA5D0BD324F8394u, 0xC45D1DF942711D9Au}, {0xCA8F44EC7EE36479u, 0xF5746577930D6500u},
+    {0x7E998B13CF4E1ECBu, 0x9968BF6ABBE85F20u}, {0x9E3FEDD8C321A67Eu, 0xBFC2EF456AE276E8u},
+    {0xC5CFE94EF3EA101Eu, 0xEFB3AB16C59B14A2u}, {0xBBA1F1D158724A12u, 0x95D04AEE3B80ECE5u},
+    {0x2A8A6E45AE8EDC97u, 0xBB445DA9CA61281Fu}, {0xF52D09D71A3293BDu, 0xEA1575143CF97226u},
+    {0x593C2626705F9C56u, 0x924D692CA61BE758u}, {0x6F8B2FB00C77836Cu, 0xB6E0C377CFA2E12Eu},
+    {0x0B6DFB9C0F956447u, 0xE498F455C38B997Au}, {0x4724BD4189BD5EACu, 0x8EDF98B59A373FECu},
+    {0x58EDEC91EC2CB657u, 0xB2977EE300C50FE7u}, {0x2F2967B66737E3EDu, 0xDF3D5E9BC0F653E1u},
+    {0xBD79E0D20082EE74u, 0x8B865B215899F46Cu}, {0xECD8590680A3AA11u, 0xAE67F1E9AEC07187u},
+    {0xE80E6F4820CC9495u, 0xDA01EE641A708DE9u}, {0x3109058D147FDCDDu, 0x884134FE908658B2u},
+    {0xBD4B46F0599FD415u, 0xAA51823E34A7EEDEu}, {0x6C9E18AC7007C91Au, 0xD4E5E2CDC1D1EA96u},
+    {0x03E2CF6BC604DDB0u, 0x850FADC09923329Eu}, {0x84DB8346B786151Cu, 0xA6539930BF6BFF45u},
+    {0xE612641865679A63u, 0xCFE87F7CEF46FF16u}, {0x4FCB7E8F3F60C07Eu, 0x81F14FAE158C5F6Eu},
+    {0xE3BE5E330F38F09Du, 0xA26DA3999AEF7749u}, {0x5CADF5BFD3072CC5u, 0xCB090C8001AB551Cu},
+    {0x73D9732FC7C8F7F6u, 0xFDCB4FA002162A63u}, {0x2867E7FDDCDD9AFAu, 0x9E9F11C4014DDA7Eu},
+    {0xB281E1FD541501B8u, 0xC646D63501A1511Du}, {0x1F225A7CA91A4226u, 0xF7D88BC24209A565u},
+    {0x3375788DE9B06958u, 0x9AE757596946075Fu}, {0x0052D6B1641C83AEu, 0xC1A12D2FC3978937u},
+    {0xC0678C5DBD23A49Au, 0xF209787BB47D6B84u}, {0xF840B7BA963646E0u, 0x9745EB4D50CE6332u},
+    {0xB650E5A93BC3D898u, 0xBD176620A501FBFFu}, {0xA3E51F138AB4CEBEu, 0xEC5D3FA8CE427AFFu},
+    {0xC66F336C36B10137u, 0x93BA47C980E98CDFu}, {0xB80B0047445D4184u, 0xB8A8D9BBE123F017u},
+    {0xA60DC059157491E5u, 0xE6D3102AD96CEC1Du}, {0x87C89837AD68DB2Fu, 0x9043EA1AC7E41392u},
+    {0x29BABE4598C311FBu, 0xB454E4A179DD1877u}, {0xF4296DD6FEF3D67Au, 0xE16A1DC9D8545E94u},
+    {0x1899E4A65F58660Cu, 0x8CE2529E2734BB1Du}, {0x5EC05DCFF72E7F8Fu, 0xB01AE745B101E9E4u},
+    {0x76707543F4FA1F73u, 0xDC21A1171D42645Du}, {0x6A06494A791C53A8u, 0x899504AE72497EBAu},
+    {0x0487DB9D17636892u, 0xABFA45DA0EDBDE69u}, {0x45A9D2845D3C42B6u, 0xD6F8D7509292D603u},
+    {0x0B8A2392BA45A9B2u, 0x865B86925B9BC5C2u}, {0x8E6CAC7768D7141Eu, 0xA7F26836F282B732u},
+    {0x3207D795430CD926u, 0xD1EF0244AF2364FFu}, {0x7F44E6BD49E807B8u, 0x8335616AED761F1Fu},
+    {0x5F16206C9C6209A6u, 0xA402B9C5A8D3A6E7u}, {0x36DBA887C37A8C0Fu, 0xCD036837130890A1u},
+    {0xC2494954DA2C9789u, 0x802221226BE55A64u}, {0xF2DB9BAA10B7BD6Cu, 0xA02AA96B06DEB0FDu},
+    {0x6F92829494E5ACC7u, 0xC83553C5C8965D3Du}, {0xCB772339BA1F17F9u, 0xFA42A8B73ABBF48Cu},
+    {0xFF2A760414536EFBu, 0x9C69A97284B578D7u}, {0xFEF5138519684ABAu, 0xC38413CF25E2D70Du},
+    {0x7EB258665FC25D69u, 0xF46518C2EF5B8CD1u}, {0xEF2F773FFBD97A61u, 0x98BF2F79D5993802u},
+    {0xAAFB550FFACFD8FAu, 0xBEEEFB584AFF8603u}, {0x95BA2A53F983CF38u, 0xEEAABA2E5DBF6784u},
+    {0xDD945A747BF26183u, 0x952AB45CFA97A0B2u}, {0x94F971119AEEF9E4u, 0xBA756174393D88DFu},
+    {0x7A37CD5601AAB85Du, 0xE912B9D1478CEB17u}, {0xAC62E055C10AB33Au, 0x91ABB422CCB812EEu},
+    {0x577B986B314D6009u, 0xB616A12B7FE617AAu}, {0xED5A7E85FDA0B80Bu, 0xE39C49765FDF9D94u},
+    {0x14588F13BE847307u, 0x8E41ADE9FBEBC27Du}, {0x596EB2D8AE258FC8u, 0xB1D219647AE6B31Cu},
+    {0x6FCA5F8ED9AEF3BBu, 0xDE469FBD99A05FE3u}, {0x25DE7BB9480D5854u, 0x8AEC23D680043BEEu},
+    {0xAF561AA79A10AE6Au, 0xADA72CCC20054AE9u}, {0x1B2BA1518094DA04u, 0xD910F7FF28069DA4u},
+    {0x90FB44D2F05D0842u, 0x87AA9AFF79042286u}, {0x353A1607AC744A53u, 0xA99541BF57452B28u},
+    {0x42889B8997915CE8u, 0xD3FA922F2D1675F2u}, {0x69956135FEBADA11u, 0x847C9B5D7C2E09B7u},
+    {0x43FAB9837E699095u, 0xA59BC234DB398C25u}, {0x94F967E45E03F4BBu, 0xCF02B2C21207EF2Eu},
+    {0x1D1BE0EEBAC278F5u, 0x8161AFB94B44F57Du}, {0x6462D92A69731732u, 0xA1BA1BA79E1632DCu},
+    {0x7D7B8F7503CFDCFEu, 0xCA28A291859BBF93u}, {0x5CDA735244C3D43Eu, 0xFCB2CB35E702AF78u},
+    {0x3A0888136AFA64A7u, 0x9DEFBF01B061ADABu}, {0x088AAA1845B8FDD0u, 0xC56BAEC21C7A1916u},
+    {0x8AAD549E57273D45u, 0xF6C69A72A3989F5Bu}, {0x36AC54E2F678864Bu, 0x9A3C2087A63F6399u},
+    {0x84576A1BB416A7DDu, 0xC0CB28A98FCF3C7Fu}, {0x656D44A2A11C51D5u, 0xF0FDF2D3F3C30B9Fu},
+    {0x9F644AE5A4B1B325u, 0x969EB7C47859E743u}, {0x873D5D9F0DDE1FEEu, 0xBC4665B596706114u},
+    {0xA90CB506D155A7EAu, 0xEB57FF22FC0C7959u}, {0x09A7F12442D588F2u, 0x9316FF75DD87CBD8u},
+    {0x0C11ED6D538AEB2Fu, 0xB7DCBF5354E9BECEu}, {0x8F1668C8A86DA5FAu, 0xE5D3EF282A242E81u},
+    {0xF96E017D694487BCu, 0x8FA475791A569D10u}, {0x37C981DCC395A9ACu, 0xB38D92D760EC4455u},
+    {0x85BBE253F47B1417u, 0xE070F78D3927556Au}, {0x93956D7478CCEC8Eu, 0x8C469AB843B89562u},
+    {0x387AC8D1970027B2u, 0xAF58416654A6BABBu}, {0x06997B05FCC0319Eu, 0xDB2E51BFE9D0696Au},
+    {0x441FECE3BDF81F03u, 0x88FCF317F22241E2u}, {0xD527E81CAD7626C3u, 0xAB3C2FDDEEAAD25Au},
+    {0x8A71E223D8D3B074u, 0xD60B3BD56A5586F1u}, {0xF6872D5667844E49u, 0x85C7056562757456u},
+    {0xB428F8AC016561DBu, 0xA738C6BEBB12D16Cu}, {0xE13336D701BEBA52u, 0xD106F86E69D785C7u},
+    {0xECC0024661173473u, 0x82A45B450226B39Cu}, {0x27F002D7F95D0190u, 0xA34D721642B06084u},
+    {0x31EC038DF7B441F4u, 0xCC20CE9BD35C78A5u}, {0x7E67047175A15271u, 0xFF290242C83396CEu},
+    {0x0F0062C6E984D386u, 0x9F79A169BD203E41u}, {0x52C07B78A3E60868u, 0xC75809C42C684DD1u},
+    {0xA7709A56CCDF8A82u, 0xF92E0C3537826145u}, {0x88A66076400BB691u, 0x9BBCC7A142B17CCBu},
+    {0x6ACFF893D00EA435u, 0xC2ABF989935DDBFEu}, {0x0583F6B8C4124D43u, 0xF356F7EBF83552FEu},
+    {0xC3727A337A8B704Au, 0x98165AF37B2153DEu}, {0x744F18C0592E4C5Cu, 0xBE1BF1B059E9A8D6u},
+    {0x1162DEF06F79DF73u, 0xEDA2EE1C7064130Cu}, {0x8ADDCB5645AC2BA8u, 0x9485D4D1C63E8BE7u},
+    {0x6D953E2BD7173692u, 0xB9A74A0637CE2EE1u}, {0xC8FA8DB6CCDD0437u, 0xE8111C87C5C1BA99u},
+    {0x1D9C9892400A22A2u, 0x910AB1D4DB9914A0u}, {0x2503BEB6D00CAB4Bu, 0xB54D5E4A127F59C8u},
+    {0x2E44AE64840FD61Du, 0xE2A0B5DC971F303Au}, {0x5CEAECFED289E5D2u, 0x8DA471A9DE737E24u},
+    {0x7425A83E872C5F47u, 0xB10D8E1456105DADu}, {0xD12F124E28F77719u, 0xDD50F1996B947518u},
+    {0x82BD6B70D99AAA6Fu, 0x8A5296FFE33CC92Fu}, {0x636CC64D1001550Bu, 0xACE73CBFDC0BFB7Bu},
+    {0x3C47F7E05401AA4Eu, 0xD8210BEFD30EFA5Au}, {0x65ACFAEC34810A71u, 0x8714A775E3E95C78u},
+    {0x7F1839A741A14D0Du, 0xA8D9D1535CE3B396u}, {0x1EDE48111209A050u, 0xD31045A8341CA07Cu},
+    {0x934AED0AAB460432u, 0x83EA2B892091E44Du}, {0xF81DA84D5617853Fu, 0xA4E4B66B68B65D60u},
+    {0x36251260AB9D668Eu, 0xCE1DE40642E3F4B9u}, {0xC1D72B7C6B426019u, 0x80D2AE83E9CE78F3u},
+    {0xB24CF65B8612F81Fu, 0xA1075A24E4421730u}, {0xDEE033F26797B627u, 0xC94930AE1D529CFCu},
+    {0x169840EF017DA3B1u, 0xFB9B7CD9A4A7443Cu}, {0x8E1F289560EE864Eu, 0x9D412E0806E88AA5u},
+    {0xF1A6F2BAB92A27E2u, 0xC491798A08A2AD4Eu}, {0xAE10AF696774B1DBu, 0xF5B5D7EC8ACB58A2u},
+    {0xACCA6DA1E0A8EF29u, 0x9991A6F3D6BF1765u}, {0x17FD090A58D32AF3u, 0xBFF610B0CC6EDD3Fu},
+    {0xDDFC4B4CEF07F5B0u, 0xEFF394DCFF8A948Eu}, {0x4ABDAF101564F98Eu, 0x95F83D0A1FB69CD9u},
+    {0x9D6D1AD41ABE37F1u, 0xBB764C4CA7A4440Fu}, {0x84C86189216DC5EDu, 0xEA53DF5FD18D5513u},
+    {0x32FD3CF5B4E49BB4u, 0x92746B9BE2F8552Cu}, {0x3FBC8C33221DC2A1u, 0xB7118682DBB66A77u},
+    {0x0FABAF3FEAA5334Au, 0xE4D5E82392A40515u}, {0x29CB4D87F2A7400Eu, 0x8F05B1163BA6832Du},
+    {0x743E20E9EF511012u, 0xB2C71D5BCA9023F8u}, {0x914DA9246B255416u, 0xDF78E4B2BD342CF6u},
+    {0x1AD089B6C2F7548Eu, 0x8BAB8EEFB6409C1Au}, {0xA184AC2473B529B1u, 0xAE9672ABA3D0C320u},
+    {0xC9E5D72D90A2741Eu, 0xDA3C0F568CC4F3E8u}, {0x7E2FA67C7A658892u, 0x8865899617FB1871u},
+    {0xDDBB901B98FEEAB7u, 0xAA7EEBFB9DF9DE8Du}, {0x552A74227F3EA565u, 0xD51EA6FA85785631u},
+    {0xD53A88958F87275Fu, 0x8533285C936B35DEu}, {0x8A892ABAF368F137u, 0xA67FF273B8460356u},
+    {0x2D2B7569B0432D85u, 0xD01FEF10A657842Cu}, {0x9C3B29620E29FC73u, 0x8213F56A67F6B29Bu},
+    {0x8349F3BA91B47B8Fu, 0xA298F2C501F45F42u}, {0x241C70A936219A73u, 0xCB3F2F7642717713u},
+    {0xED238CD383AA0110u, 0xFE0EFB53D30DD4D7u}, {0xF4363804324A40AAu, 0x9EC95D1463E8A506u},
+    {0xB143C6053EDCD0D5u, 0xC67BB4597CE2CE48u}, {0xDD94B7868E94050Au, 0xF81AA16FDC1B81DAu},
+    {0xCA7CF2B4191C8326u, 0x9B10A4E5E9913128u}, {0xFD1C2F611F63A3F0u, 0xC1D4CE1F63F57D72u},
+    {0xBC633B39673C8CECu, 0xF24A01A73CF2DCCFu}, {0xD5BE0503E085D813u, 0x976E41088617CA01u},
+    {0x4B2D8644D8A74E18u, 0xBD49D14AA79DBC82u}, {0xDDF8E7D60ED1219Eu, 0xEC9C459D51852BA2u},
+    {0xCABB90E5C942B503u, 0x93E1AB8252F33B45u}, {0x3D6A751F3B936243u, 0xB8DA1662E7B00A17u},
+    {0x0CC512670A783AD4u, 0xE7109BFBA19C0C9Du}, {0x27FB2B80668B24C5u, 0x906A617D450187E2u},
+    {0xB1F9F660802DEDF6u, 0xB484F9DC9641E9DAu}, {0x5E7873F8A0396973u, 0xE1A63853BBD26451u},
+    {0xDB0B487B6423E1E8u, 0x8D07E33455637EB2u}, {0x91CE1A9A3D2CDA62u, 0xB049DC016ABC5E5Fu},
+    {0x7641A140CC7810FBu, 0xDC5C5301C56B75F7u}, {0xA9E904C87FCB0A9Du, 0x89B9B3E11B6329BAu},
+    {0x546345FA9FBDCD44u, 0xAC2820D9623BF429u}, {0xA97C177947AD4095u, 0xD732290FBACAF133u},
+    {0x49ED8EABCCCC485Du, 0x867F59A9D4BED6C0u}, {0x5C68F256BFFF5A74u, 0xA81F301449EE8C70u},
+    {0x73832EEC6FFF3111u, 0xD226FC195C6A2F8Cu}, {0xC831FD53C5FF7EABu, 0x83585D8FD9C25DB7u},
+    {0xBA3E7CA8B77F5E55u, 0xA42E74F3D032F525u}, {0x28CE1BD2E55F35EBu, 0xCD3A1230C43FB26Fu},
+    {0x7980D163CF5B81B3u, 0x80444B5E7AA7CF85u}, {0xD7E105BCC332621Fu, 0xA0555E361951C366u},
+    {0x8DD9472BF3FEFAA7u, 0xC86AB5C39FA63440u}, {0xB14F98F6F0FEB951u, 0xFA856334878FC150u},
+    {0x6ED1BF9A569F33D3u, 0x9C935E00D4B9D8D2u}, {0x0A862F80EC4700C8u, 0xC3B8358109E84F07u},
+    {0xCD27BB612758C0FAu, 0xF4A642E14C6262C8u}, {0x8038D51CB897789Cu, 0x98E7E9CCCFBD7DBDu},
+    {0xE0470A63E6BD56C3u, 0xBF21E44003ACDD2Cu}, {0x1858CCFCE06CAC74u, 0xEEEA5D5004981478u},
+    {0x0F37801E0C43EBC8u, 0x95527A5202DF0CCBu}, {0xD30560258F54E6BAu, 0xBAA718E68396CFFDu},
+    {0x47C6B82EF32A2069u, 0xE950DF20247C83FDu}, {0x4CDC331D57FA5441u, 0x91D28B7416CDD27Eu},
+    {0xE0133FE4ADF8E952u, 0xB6472E511C81471Du}, {0x58180FDDD97723A6u, 0xE3D8F9E563A198E5u},
+    {0x570F09EAA7EA7648u, 0x8E679C2F5E44FF8Fu}
+};
+
+static inline uint64_t string__mul_128(uint64_t a, uint64_t b, uint64_t *high)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b;
+    uint64_t b_hi = b >> 32;
+
+    uint64_t b00 = a_lo * b_lo;
+    uint64_t mid = a_hi * b_lo + (b00 >> 32);
+    uint64_t mid2 = a_lo * b_hi + (uint32_t)mid;
+
+    *high = a_hi * b_hi + (mid >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | (uint32_t)b00;
+#endif
+}
+
+// Bits of the double nearest <w> * 10^<q> (w != 0), false if the product is too close to call
+static bool string__eisel_lemire(uint64_t w, int64_t q, uint64_t *bits)
+{
+    if (q < -342)   {*bits = 0; return true;}
+    if (q > 308)    {*bits = 0x7FF0000000000000ull; return true;}
+
+    int lz = (int)string__clz64(w);
+    w <<= lz;
+
+    // Top of w * 5^q with 55 + 64 exact bits, refined by the low half of 5^q when they run out
+    const uint64_t *pow5 = string__pow5_128[q + 342];
+    const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFull >> 55;
+
+    uint64_t high;
+    uint64_t low = string__mul_128(w, pow5[1], &high);
+
+    if ((high & precision_mask) == precision_mask)
+    {
+        uint64_t second_high;
+        string__mul_128(w, pow5[0], &second_high);
+
+        low += second_high;
+        if (second_high > low) {++high;}
+    }
+
+    if (low == 0xFFFFFFFFFFFFFFFFull && (q < -27 || q > 55)) {return false;}
+
+    int upperbit = (int)(high >> 63);
+    uint64_t mantissa = high >> (upperbit + 9);
+    int power2 = (int)(((152170 + 65536) * (int32_t)q) >> 16) + 63 + upperbit - lz + 1023;
+
+    if (power2 <= 0)
+    {
+        if (-power2 + 1 >= 64) {*bits = 0; return true;}
+
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+
+        // Rounding up may carry into the smallest normal
+        *bits = mantissa;
+        return true;
+    }
+
+    // Exactly halfway: round to even instead of up
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upperbit + 9)) == high)
+    {
+        mantissa &= ~1ull;
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+
+    if (mantissa >= (2ull << 52))
+    {
+        mantissa = 1ull << 52;
+        ++power2;
+    }
+
+    mantissa &= ~(1ull << 52);
+
+    if (power2 >= 0x7FF) {*bits = 0x7FF0000000000000ull; return true;}
+
+    *bits = ((uint64_t)power2 << 52) | mantissa;
+    return true;
+}
+
+static const double string__exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool string__match_ci(const char *ptr, const char *end, const char *word)
+{
+    size_t length_word = strlen(word);
+
+    return (size_t)(end - ptr) >= length_word && string__equal_ci(ptr, word, length_word);
+}
+
+/*
+size_t string_parse_f64(char *buffer, size_t length, double *value)
+
+returns:
+    > the number of bytes of the decimal number ([+-] digits [. digits] [e [+-] digits],
+      inf, infinity or nan) at the start of the <length> bytes at <buffer>, written to <value>
+      correctly rounded, whatever the locale
+    > 0 if there is none or invalid <buffer> or <value>
+
+example:
+    > string_parse_f64("0.1, 2", 6, &value)  -> 3 (value = 0.1)
+    > string_parse_f64("-1e400", 6, &value)  -> 6 (value = -inf)
+*/
+size_t string_parse_f64(char *buffer, size_t length, double *value)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!buffer || !value) {return 0;}
+
+    const char *ptr = buffer;
+    const char *end = buffer + length;
+    bool negative = false;
+
+    if (ptr < end && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    uint64_t bits;
+
+    if (ptr < end && ((*ptr | 0x20) == 'i' || (*ptr | 0x20) == 'n'))
+    {
+        if (string__match_ci(ptr, end, "infinity"))     {bits = 0x7FF0000000000000ull; ptr += 8;}
+        else if (string__match_ci(ptr, end, "inf"))     {bits = 0x7FF0000000000000ull; ptr += 3;}
+        else if (string__match_ci(ptr, end, "nan"))     {bits = 0x7FF8000000000000ull; ptr += 3;}
+        else {return 0;}
+
+        bits |= (uint64_t)negative << 63;
+        memcpy(value, &bits, sizeof(bits));
+
+        return (size_t)(ptr - buffer);
+    }
+
+    // Digits go into <mantissa> as they come; only past 19 of them is it re-read
+    uint64_t mantissa = 0;
+
+    const char *integer = ptr;
+    size_t length_integer = string__parse_digits(ptr, end, &mantissa);
+    ptr += length_integer;
+
+    const char *fraction = ptr;
+    size_t length_fraction = 0;
+
+    if (ptr < end && *ptr == '.')
+    {
+        fraction = ++ptr;
+        length_fraction = string__parse_digits(ptr, end, &mantissa);
+        ptr += length_fraction;
+    }
+
+    if (length_integer + length_fraction == 0) {return 0;}
+
+    int64_t exponent = 0;
+
+    if (ptr < end && (*ptr | 0x20) == 'e')
+    {
+        const char *e = ptr + 1;
+        bool negative_exponent = false;
+
+        if (e < end && (*e == '-' || *e == '+'))
+        {
+            negative_exponent = (*e == '-');
+            ++e;
+        }
+
+        // Without digits the 'e' is not part of the number
+        if (e < end && (unsigned char)(*e - '0') < 10)
+        {
+            for (; e < end && (unsigned char)(*e - '0') < 10; ++e)
+            {
+                if (exponent < 0x10000000) {exponent = exponent * 10 + (*e - '0');}
+            }
+
+            if (negative_exponent) {exponent = -exponent;}
+
+            ptr = e;
+        }
+    }
+
+    size_t consumed = (size_t)(ptr - buffer);
+
+    // Leading zeros do not count towards the 19 digits a uint64_t holds exactly
+    const char *first = integer;
+    size_t skipped_integer = 0;
+    size_t skipped_fraction = 0;
+
+    while (skipped_integer < length_integer && *first == '0') {++first; ++skipped_integer;}
+
+    if (skipped_integer == length_integer)
+    {
+        first = fraction;
+        while (skipped_fraction < length_fraction && *first == '0') {++first; ++skipped_fraction;}
+    }
+
+    size_t significant = (length_integer - skipped_integer) + (length_fraction - skipped_fraction);
+    int64_t exponent10 = exponent - (int64_t)length_fraction;
+    bool truncated = false;
+
+    if (significant == 0)
+    {
+        bits = (uint64_t)negative << 63;
+        memcpy(value, &bits, sizeof(bits));
+
+        return consumed;
+    }
+
+    if (significant > 19)
+    {
+        // Keep the first 19 significant digits; the rest only shift the exponent
+        truncated = true;
+        mantissa = 0;
+
+        size_t taken = 0;
+        size_t integer_left = length_integer - skipped_integer;
+        const char *p = first;
+
+        for (; taken < 19 && integer_left > 0; ++taken, --integer_left, ++p) {mantissa = mantissa * 10 + (uint64_t)(*p - '0');}
+
+        if (taken < 19)
+        {
+            if (integer_left == 0 && length_integer - skipped_integer > 0) {p = fraction;}
+
+            size_t fraction_taken = 0;
+            for (; taken < 19; ++taken, ++p, ++fraction_taken) {mantissa = mantissa * 10 + (uint64_t)(*p - '0');}
+
+            exponent10 = exponent - (int64_t)(skipped_fraction + fraction_taken);
+        }
+        else
+        {
+            exponent10 = exponent + (int64_t)integer_left;
+        }
+    }
+
+    // Clinger's fast path: both operands and the result are exact doubles
+    if (!truncated && mantissa <= (1ull << 53) && exponent10 >= -22 && exponent10 <= 22)
+    {
+        double result = (double)mantissa;
+        result = (exponent10 < 0) ? result / string__exact_pow10[-exponent10] : result * string__exact_pow10[exponent10];
+
+        *value = negative ? -result : result;
+
+        return consumed;
+    }
+
+    // Truncated digits put the true value between <mantissa> and <mantissa> + 1
+    uint64_t upper;
+    bool exact = string__eisel_lemire(mantissa, exponent10, &bits);
+
+    if (exact && truncated)
+    {
+        exact = string__eisel_lemire(mantissa + 1, exponent10, &upper) && upper == bits;
+    }
+
+    if (!exact)
+    {
+        // Rare: hand the digits to strtod() without a decimal point, which keeps the locale out
+        size_t length_digits = length_integer + length_fraction;
+        char stack[128];
+        char *text = (length_digits + 32 <= sizeof(stack)) ? stack : malloc(length_digits + 32);
+
+        memcpy(text, integer, length_integer);
+        memcpy(text + length_integer, fraction, length_fraction);
+
+        snprintf(text + length_digits, 32, "e%lld", (long long)(exponent - (int64_t)length_fraction));
+
+        double result = strtod(text, NULL);
+
+        if (text != stack) {free(text);}
+
+        *value = negative ? -result : result;
+
+        return consumed;
+    }
+
+    bits |= (uint64_t)negative << 63;
+    memcpy(value, &bits, sizeof(bits));
+
+    return consumed;
+}
+
+//----------|
+// Escaping |
+//----------|
+
+static inline bool string__escape_needed(StringEscape kind, unsigned char c)
+{
+    switch (kind)
+    {
+        case STRING_ESCAPE_JSON:    return c < 0x20 || c == '"' || c == '\\';
+        case STRING_ESCAPE_HTML:    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+        case STRING_ESCAPE_URL:     return !((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                                             c == '-' || c == '.' || c == '_' || c == '~');
+        case STRING_ESCAPE_C:       return c < 0x20 || c >= 0x7F || c == '"' || c == '\\';
+    }
+
+    return false;
+}
+
+// Writes the escape of <c> to <output> (at most 6 bytes), returns its length
+static size_t string__escape_byte(StringEscape kind, unsigned char c, char *output)
+{
+    static const char hex_lower[] = "0123456789abcdef";
+    static const char hex_upper[] = "0123456789ABCDEF";
+
+    const char *named = NULL;
+
+    switch (kind)
+    {
+        case STRING_ESCAPE_JSON:
+        case STRING_ESCAPE_C:
+        {
+            switch (c)
+            {
+                case '"':   named = "\\\""; break;
+                case '\\':  named = "\\\\"; break;
+                case '\b':  named = "\\b";  break;
+                case '\f':  named = "\\f";  break;
+                case '\n':  named = "\\n";  break;
+                case '\r':  named = "\\r";  break;
+                case '\t':  named = "\\t";  break;
+                case '\a':  named = (kind == STRING_ESCAPE_C) ? "\\a" : NULL; break;
+                case '\v':  named = (kind == STRING_ESCAPE_C) ? "\\v" : NULL; break;
+            }
+
+            if (named) {break;}
+
+            if (kind == STRING_ESCAPE_JSON)
+            {
+                memcpy(output, "\\u00", 4);
+                output[4] = hex_lower[c >> 4];
+                output[5] = hex_lower[c & 15];
+                return 6;
+            }
+
+            // Always three octal digits, so a digit that follows cannot join the escape
+            output[0] = '\\';
+            output[1] = (char)('0' + (c >> 6));
+            output[2] = (char)('0' + ((c >> 3) & 7));
+            output[3] = (char)('0' + (c & 7));
+            return 4;
+        }
+
+        case STRING_ESCAPE_HTML:
+        {
+            switch (c)
+            {
+                case '&':   named = "&amp;";  break;
+                case '<':   named = "&lt;";   break;
+                case '>':   named = "&gt;";   break;
+                case '"':   named = "&quot;"; break;
+                default:    named = "&#39;";  break;
+            }
+
+            break;
+        }
+
+        case STRING_ESCAPE_URL:
+        {
+            output[0] = '%';
+            output[1] = hex_upper[c >> 4];
+            output[2] = hex_upper[c & 15];
+            return 3;
+        }
+    }
+
+    size_t length = strlen(named);
+    memcpy(output, named, length);
+
+    return length;
+}
+
+/*
+char *string_escape(char *str, StringEscape kind)
+
+returns:
+    > <str> escaped for a JSON string, HTML text or attribute, a URL component
+      or a C string literal, depending on <kind>
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_escape("a<b & \"c\"", STRING_ESCAPE_HTML)   -> "a&lt;b &amp; &quot;c&quot;"
+    > string_escape("a b/c", STRING_ESCAPE_URL)          -> "a%20b%2Fc"
+*/
+char *string_escape(char *str, StringEscape kind)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    string__byteclass byteclass;
+
+    {
+        char bytes[256];
+        size_t count = 0;
+
+        for (unsigned int c = 1; c < 256; ++c)
+        {
+            if (string__escape_needed(kind, (unsigned char)c)) {bytes[count++] = (char)c;}
+        }
+
+        bytes[count] = '\0';
+        string__byteclass_init(&byteclass, bytes);
+    }
+
+    size_t length_str = strlen(str);
+    char scratch[8];
+
+    // Sizing pass: clean runs are skipped by the classifier, only the bytes it stops at cost anything
+    size_t length_buf = length_str;
+
+    for (size_t i = string__find_any(str, length_str, &byteclass); i < length_str; )
+    {
+        length_buf += string__escape_byte(kind, (unsigned char)str[i], scratch) - 1;
+
+        ++i;
+        i += string__find_any(str + i, length_str - i, &byteclass);
+    }
+
+    char *output = malloc(length_buf + 1);
+
+    if (length_buf == length_str)
+    {
+        memcpy(output, str, length_str + 1);
+        return output;
+    }
+
+    char *ptr = output;
+
+    for (size_t i = 0; i < length_str; )
+    {
+        size_t run = string__find_any(str + i, length_str - i, &byteclass);
+
+        memcpy(ptr, str + i, run);
+        ptr += run;
+        i += run;
+
+        if (i < length_str)
+        {
+            ptr += string__escape_byte(kind, (unsigned char)str[i], ptr);
+            ++i;
+        }
+    }
+
+    *ptr = '\0';
+
+    return output;
+}
+
+static inline int string__hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') {return c - '0';}
+    if (c >= 'a' && c <= 'f') {return c - 'a' + 10;}
+    if (c >= 'A' && c <= 'F') {return c - 'A' + 10;}
+
+    return -1;
+}
+
+// Value of the <count> hex digits at <ptr>, -1 if one of them is not a hex digit
+static long string__hex_value(const char *ptr, size_t count)
+{
+    long value = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        int digit = string__hex_digit(ptr[i]);
+        if (digit < 0) {return -1;}
+
+        value = value * 16 + digit;
+    }
+
+    return value;
+}
+
+// Writes the UTF-8 encoding of <codepoint> to <output>, returns its length
+static size_t string__utf8_encode(unsigned long codepoint, char *output)
+{
+    if (codepoint < 0x80)
+    {
+        output[0] = (char)codepoint;
+        return 1;
+    }
+
+    if (codepoint < 0x800)
+    {
+        output[0] = (char)(0xC0 | (codepoint >> 6));
+        output[1] = (char)(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+
+    if (codepoint < 0x10000)
+    {
+        output[0] = (char)(0xE0 | (codepoint >> 12));
+        output[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        output[2] = (char)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+
+    output[0] = (char)(0xF0 | (codepoint >> 18));
+    output[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    output[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    output[3] = (char)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+/*
+    Decodes the escape starting at <ptr> (on its '\\', '&' or '%') into <output>.
+    Returns how many input bytes it spanned, 0 if it is malformed or would decode
+    to a NUL, in which case it is copied through unchanged.
+*/
+static size_t string__unescape_at(StringEscape kind, const char *ptr, const char *end, char *output, size_t *written)
+{
+    size_t left = (size_t)(end - ptr);
+    *written = 1;
+
+    if (kind == STRING_ESCAPE_URL)
+    {
+        long value = (left >= 3) ? string__hex_value(ptr + 1, 2) : -1;
+        if (value <= 0) {return 0;}
+
+        output[0] = (char)value;
+        return 3;
+    }
+
+    if (kind == STRING_ESCAPE_HTML)
+    {
+        static const struct {const char *name; const char *text;} entities[] = {
+            {"&amp;", "&"}, {"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&apos;", "'"}, {"&nbsp;", "\xC2\xA0"}
+        };
+
+        for (size_t e = 0; e < sizeof(entities) / sizeof(entities[0]); ++e)
+        {
+            size_t length_name = strlen(entities[e].name);
+
+            if (left >= length_name && memcmp(ptr, entities[e].name, length_name) == 0)
+            {
+                *written = strlen(entities[e].text);
+                memcpy(output, entities[e].text, *written);
+                return length_name;
+            }
+        }
+
+        // &#123; or &#x7B;
+        if (left < 4 || ptr[1] != '#') {return 0;}
+
+        bool hex = (ptr[2] == 'x' || ptr[2] == 'X');
+        size_t i = hex ? 3 : 2;
+        unsigned long codepoint = 0;
+        size_t digits = 0;
+
+        for (; i < left && digits < 8; ++i, ++digits)
+        {
+            int digit = hex ? string__hex_digit(ptr[i]) : ((ptr[i] >= '0' && ptr[i] <= '9') ? ptr[i] - '0' : -1);
+            if (digit < 0) {break;}
+
+            codepoint = codepoint * (hex ? 16 : 10) + (unsigned long)digit;
+        }
+
+        if (digits == 0 || i >= left || ptr[i] != ';') {return 0;}
+        if (codepoint == 0 || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {return 0;}
+
+        *written = string__utf8_encode(codepoint, output);
+        return i + 1;
+    }
+
+    if (left < 2) {return 0;}
+
+    char c = ptr[1];
+
+    switch (c)
+    {
+        case '"':   output[0] = '"';  return 2;
+        case '\\':  output[0] = '\\'; return 2;
+        case 'b':   output[0] = '\b'; return 2;
+        case 'f':   output[0] = '\f'; return 2;
+        case 'n':   output[0] = '\n'; return 2;
+        case 'r':   output[0] = '\r'; return 2;
+        case 't':   output[0] = '\t'; return 2;
+    }
+
+    if (kind == STRING_ESCAPE_JSON)
+    {
+        if (c == '/') {output[0] = '/'; return 2;}
+        if (c != 'u') {return 0;}
+
+        long unit = (left >= 6) ? string__hex_value(ptr + 2, 4) : -1;
+        if (unit <= 0) {return 0;}
+
+        unsigned long codepoint = (unsigned long)unit;
+        size_t span = 6;
+
+        // A surrogate pair is one code point; a lone half is left alone
+        if (unit >= 0xDC00 && unit <= 0xDFFF) {return 0;}
+
+        if (unit >= 0xD800 && unit <= 0xDBFF)
+        {
+            long low = (left >= 12 && ptr[6] == '\\' && ptr[7] == 'u') ? string__hex_value(ptr + 8, 4) : -1;
+            if (low < 0xDC00 || low > 0xDFFF) {return 0;}
+
+            codepoint = 0x10000 + (((unsigned long)unit - 0xD800) << 10) + ((unsigned long)low - 0xDC00);
+            span = 12;
+        }
+
+        *written = string__utf8_encode(codepoint, output);
+        return span;
+    }
+
+    switch (c)
+    {
+        case '\'':  output[0] = '\''; return 2;
+        case '?':   output[0] = '?';  return 2;
+        case 'a':   output[0] = '\a'; return 2;
+        case 'v':   output[0] = '\v'; return 2;
+    }
+
+    // \ooo takes up to three octal digits, \xhh up to two hex digits
+    unsigned int value = 0;
+    size_t i = 1;
+
+    if (c >= '0' && c <= '7')
+    {
+        for (; i < left && i < 4 && ptr[i] >= '0' && ptr[i] <= '7'; ++i) {value = value * 8 + (unsigned int)(ptr[i] - '0');}
+    }
+    else if (c == 'x')
+    {
+        for (i = 2; i < left && i < 4 && string__hex_digit(ptr[i]) >= 0; ++i) {value = value * 16 + (unsigned int)string__hex_digit(ptr[i]);}
+
+        if (i == 2) {return 0;}
+    }
+    else {return 0;}
+
+    if (value == 0 || value > 0xFF) {return 0;}
+
+    output[0] = (char)value;
+    return i;
+}
+
+/*
+char *string_unescape(char *str, StringEscape kind)
+
+returns:
+    > <str> with the escapes of <kind> decoded (JSON and HTML code points as UTF-8);
+      malformed escapes and ones that would decode to a NUL are kept as they are
+    > NULL if invalid <str>
+    > needs to be freed!
+
+example:
+    > string_unescape("a&lt;b &#x263A;", STRING_ESCAPE_HTML)  -> "a<b \xE2\x98\xBA"
+    > string_unescape("a%20b%2Fc", STRING_ESCAPE_URL)         -> "a b/c"
+*/
+char *string_unescape(char *str, StringEscape kind)
+{
+    STRING__TRACK_PUBLIC();
+
+    if (!str) {return NULL;}
+
+    size_t length_str = strlen(str);
+    const char *end = str + length_str;
+
+    char marker = (kind == STRING_ESCAPE_HTML) ? '&' : (kind == STRING_ESCAPE_URL) ? '%' : '\\';
+
+    // Every escape decodes to at most as many bytes as it spans
+    char *output = malloc(length_str + 1);
+    char *ptr = output;
+    const char *src = str;
+
+    for (;;)
+    {
+        const char *hit = memchr(src, marker, (size_t)(end - src));
+        size_t run = hit ? (size_t)(hit - src) : (size_t)(end - src);
+
+        memcpy(ptr, src, run);
+        ptr += run;
+        src += run;
+
+        if (!hit) {break;}
+
+        size_t written;
+        size_t span = string__unescape_at(kind, src, end, ptr, &written);
+
+        if (span == 0)
+        {
+            *ptr++ = *src++;
+            continue;
+        }
+
+        ptr += written;
+        src += span;
+    }
+
+    *ptr = '\0';
+
+    return output;
+}
+
+//--------------------|
+// Frequency Counting |
+//--------------------|
+
+static inline uint64_t string__bytes_hash(const char *data, size_t length)
+{
+    uint64_t hash = 1469598103934665603ull ^ length;
+    size_t i = 0;
 
-    if (count == 0) {output[0] = copy; return output;}
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
 
-    int i = 0;
-    char *token = strtok(copy, delimiter);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
 
-    while (token != NULL)
+    if (i < length)
     {
-        output[i++] = token;
-        token = strtok(NULL, delimiter);
+        uint64_t word = 0;
+        memcpy(&word, data + i, length - i);
+
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
     }
 
-    return output;
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 32;
+
+    // 0 marks an empty slot
+    return hash ? hash : 1;
 }
 
-//----------|
-// Trimming |
-//----------|
+static StringCounts string__counts_create(size_t capacity)
+{
+    StringCounts counts = {0};
 
-/*
-char *string_trim_left(char *str, char *substr)
+    counts.capacity = capacity;
+    counts.hashes = calloc(capacity, sizeof(uint64_t));
+    counts.slots = malloc(sizeof(StringCount) * capacity);
 
-returns:
-    > <str> with <substr> trimmed from the left
-    > NULL if invalid <str>
+    return counts;
+}
 
-example:
-    > string_trim_left("Hello World", "Hello ") -> "World"
-                        ^-----
-*/
-char *string_trim_left(char *str, char *substr)
+static void string__counts_grow(StringCounts *counts)
 {
-    if (!str)       {return NULL;}
-    if (!substr)    {return str;}
+    StringCounts grown = string__counts_create(counts->capacity * 2);
+    size_t mask = grown.capacity - 1;
 
-    return strncmp(str, substr, strlen(substr)) == 0 ? str + strlen(substr) : str;
+    for (size_t i = 0; i < counts->capacity; ++i)
+    {
+        if (!counts->hashes[i]) {continue;}
 
-}
+        size_t slot = counts->hashes[i] & mask;
+        while (grown.hashes[slot]) {slot = (slot + 1) & mask;}
 
-/* 
-char *string_trim_right(char *str, char *substr)
+        grown.hashes[slot] = counts->hashes[i];
+        grown.slots[slot] = counts->slots[i];
+    }
 
-returns:
-    > <str> with <substr> trimmed from the right
-    > NULL if invalid <str>
-    > needs to be freed!
+    grown.length = counts->length;
+    grown.total = counts->total;
 
-example:
-    > string_trim_right("Hello World", " World") -> "Hello"
-                              ^-----
-*/
-char *string_trim_right(char *str, char *substr)
+    free(counts->hashes);
+    free(counts->slots);
+
+    *counts = grown;
+}
+
+// Adds <count> occurrences of the key <data>; the probe only touches a slot once the dense hash matches
+static void string__counts_add(StringCounts *counts, const char *data, size_t length, uint64_t hash, size_t count)
 {
-    if (!str)       {return NULL;}
-    if (!substr)    {return str;}
-    
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+    size_t mask = counts->capacity - 1;
+    size_t slot = hash & mask;
 
-    if (strncmp(str + (length_str - length_sub), substr, length_sub) == 0)
-    {
-        size_t length_buf = length_str - length_sub;
+    counts->total += count;
 
-        char *output = malloc(length_buf + 1);
+    while (counts->hashes[slot])
+    {
+        if (counts->hashes[slot] == hash)
+        {
+            StringCount *entry = &counts->slots[slot];
 
-        memcpy(output, str, length_buf);
-        output[length_buf] = '\0';
+            if (entry->key.length == length && memcmp(entry->key.data, data, length) == 0)
+            {
+                entry->count += count;
+                return;
+            }
+        }
 
-        return output;
+        slot = (slot + 1) & mask;
     }
-    else
+
+    counts->hashes[slot] = hash;
+    counts->slots[slot].key.data = (char *)data;
+    counts->slots[slot].key.length = length;
+    counts->slots[slot].count = count;
+
+    // Keep the table at most half full
+    if (++counts->length * 2 > counts->capacity) {string__counts_grow(counts);}
+}
+
+#if defined(ZSTRING_THREADS)
+
+static void string__counts_merge(StringCounts *into, StringCounts *from)
+{
+    for (size_t i = 0; i < from->capacity; ++i)
     {
-        return str;
+        if (!from->hashes[i]) {continue;}
+
+        StringCount *entry = &from->slots[i];
+        string__counts_add(into, entry->key.data, entry->key.length, from->hashes[i], entry->count);
     }
 }
 
-//----------|
-// Removing |
-//----------|
+#endif
 
-/*
-char *string_remove(char *str, char *substr)
+// What one thread counts: keys starting in [start, end) of buffer
+typedef struct string__count_job
+{
+    const char *buffer;
+    size_t length;
+    size_t start;
+    size_t end;
 
-returns:
-    > <str> with first occurence of <substr> removed
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+    size_t n;                               // n-grams if not 0
+    const string__byteclass *delimiters;    // tokens otherwise
 
-example:
-    > string_remove("Hello There World", "There") -> "Hello  World"
-                           ^---^
-*/
-char *string_remove(char *str, char *substr)
-{
-    if (!str)       {return NULL;}
-    if (!substr)    {return str;}
+    StringCounts counts;
+} string__count_job;
 
-    size_t length_str = strlen(str);
+static void *string__count_worker(void *argument)
+{
+    string__count_job *job = argument;
+    const char *buffer = job->buffer;
 
-    // Find position of substr  
-    int pos = -1;
+    job->counts = string__counts_create(1024);
 
-    if (length_str > 0)
+    if (job->n)
     {
-        const char *ptr = str;
+        size_t n = job->n;
 
-        ptr = strstr(ptr, substr);
-    
-        if (ptr != NULL)
+        for (size_t i = job->start; i < job->end; ++i)
         {
-            pos = ptr - str;
+            string__counts_add(&job->counts, buffer + i, n, string__bytes_hash(buffer + i, n), 1);
         }
-    }
 
-    if (pos == -1) {return str;}
+        return NULL;
+    }
 
-    // Remove substring
-    size_t length_sub = strlen(substr);
-    size_t length_buf = length_str - length_sub;
+    size_t i = job->start;
 
-    char *output = malloc(length_buf + 1);
+    while (i < job->end)
+    {
+        size_t run = string__find_any(buffer + i, job->length - i, job->delimiters);
 
-    memcpy(output, str, pos);
-    memcpy(output + pos, str + pos + length_sub, length_buf);
+        if (run) {string__counts_add(&job->counts, buffer + i, run, string__bytes_hash(buffer + i, run), 1);}
 
-    output[length_buf] = '\0';
+        i += run + 1;
+    }
 
-    return output;
+    return NULL;
 }
 
-char *string_remove_all(char *str, char *substr)
+// Splits [0, <keys>) over up to <threads> jobs, each boundary moved past a delimiter for tokens
+static StringCounts string__count(const char *buffer, size_t length, size_t keys, size_t n, const string__byteclass *delimiters, unsigned int threads)
 {
-    if (!str)       {return NULL;}
-    if (!substr)    {return str;}
+    string__count_job single = {buffer, length, 0, keys, n, delimiters, {0}};
 
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+#if defined(ZSTRING_THREADS)
+    size_t chunks = (threads > 1) ? threads : 1;
+    if (chunks > keys / 65536) {chunks = keys / 65536;}
 
-    unsigned int count = 0;
-    
+    if (chunks > 1)
     {
-        char *ptr = str;
+        string__count_job *jobs = malloc(sizeof(string__count_job) * chunks);
+        pthread_t *workers = malloc(sizeof(pthread_t) * chunks);
+        bool *started = calloc(chunks, sizeof(bool));
+        size_t start = 0;
 
-        while (ptr = strstr(ptr, substr))
+        for (size_t t = 0; t < chunks; ++t)
         {
-            ptr += length_sub;
-            ++count;
-        }
-    }
-
-    if (count == 0) {return str;}
+            size_t end = (t + 1 == chunks) ? keys : keys / chunks * (t + 1);
 
-    size_t length_buf = length_str - (length_sub * count);
+            if (!n)
+            {
+                if (end < start) {end = start;}
+                while (end < keys && !string__byteset_has(&delimiters->set, (unsigned char)buffer[end])) {++end;}
+            }
 
-    int pos_str = 0;
-    int pos_out = 0;
-    char *output = malloc(length_buf);
+            string__count_job job = {buffer, length, start, end, n, delimiters, {0}};
+            jobs[t] = job;
+            start = end;
+        }
 
-    for (int i = 0; i < count; ++i)
-    {
-        int pos = -1;
+        for (size_t t = 1; t < chunks; ++t)
+        {
+            started[t] = (pthread_create(&workers[t], NULL, string__count_worker, &jobs[t]) == 0);
+        }
 
-        const char *ptr = str;
+        string__count_worker(&jobs[0]);
 
-        for (int j = 0; j < i + 1; ++j) 
+        for (size_t t = 1; t < chunks; ++t)
         {
-            ptr = strstr(ptr, substr);
-    
-            if (ptr == NULL)
-            {
-                break;
-            } 
+            if (started[t]) {pthread_join(workers[t], NULL);}
+            else            {string__count_worker(&jobs[t]);}
 
-            pos = (ptr - str);
-            ++ptr;
+            string__counts_merge(&jobs[0].counts, &jobs[t].counts);
+            string_counts_free(&jobs[t].counts);
         }
 
-        int length_copy = pos - pos_str;
-        
-        memcpy(output + pos_out, str + pos_str, length_copy);
-        pos_out += length_copy;
-        pos_str += length_copy + length_sub;
+        StringCounts counts = jobs[0].counts;
 
-        //++pos_out;
+        free(started);
+        free(workers);
+        free(jobs);
+
+        return counts;
     }
+#else
+    (void)threads;
+#endif
 
-    memcpy(output + pos_out, str + pos_str, length_str - pos_str);
+    string__count_worker(&single);
 
-    output[length_buf] = '\0';
-    return output;
+    return single.counts;
 }
 
-//----------|
-// Shifting |
-//----------|
-
 /*
-char *string_shift_left(char *str, unsigned int amount)
+StringCounts string_count_ngrams(char *buffer, size_t length, size_t n, unsigned int threads)
 
 returns:
-    > <str> shifted <amount> of letters to the left
-    > NULL if invalid <str>
-    > needs to be freed!
+    > the number of times every distinct <n> bytes occur in the <length> bytes at <buffer>,
+      counted in one pass (by <threads> threads with ZSTRING_THREADS, merged at the end)
+    > an empty table if invalid <buffer>, <n> is 0 or longer than <length>
+    > needs to be freed with string_counts_free()!
 
 example:
-    > string_shift_left("abcdefg", 3) -> "defgabc"
-                         <<^
+    > string_count_ngrams("abab", 4, 2, 1) -> {"ab": 2, "ba": 1}
 */
-char *string_shift_left(char *str, unsigned int amount)
+StringCounts string_count_ngrams(char *buffer, size_t length, size_t n, unsigned int threads)
 {
-    size_t length_str = strlen(str);
+    STRING__TRACK_PUBLIC();
 
-    amount = amount % length_str;
+    if (!buffer || n == 0 || n > length) {StringCounts empty = {0}; return empty;}
 
-    if (!str)        {return NULL;}
-    if (amount == 0) {return str;}
+    return string__count(buffer, length, length - n + 1, n, NULL, threads);
+}
 
-    char *output = malloc(length_str + 1);
+/*
+StringCounts string_count_tokens(char *buffer, size_t length, char *delimiters, unsigned int threads)
 
-    memcpy(output, str + amount, length_str - amount);
-    memcpy(output + (length_str - amount), str, amount);
+returns:
+    > the number of times every distinct token occurs in the <length> bytes at <buffer>,
+      tokens being the non-empty runs between bytes in <delimiters> (as string_split_any() skipping
+      empty fields), counted in one pass (by <threads> threads with ZSTRING_THREADS)
+    > an empty table if invalid <buffer> or <delimiters>
+    > needs to be freed with string_counts_free()!
 
-    output[length_str] = '\0';
+example:
+    > string_count_tokens("to be or not to be", 18, " ", 1) -> {"to": 2, "be": 2, "or": 1, "not": 1}
+*/
+StringCounts string_count_tokens(char *buffer, size_t length, char *delimiters, unsigned int threads)
+{
+    STRING__TRACK_PUBLIC();
 
-    return output;
+    if (!buffer || !delimiters) {StringCounts empty = {0}; return empty;}
+
+    string__byteclass byteclass;
+    string__byteclass_init(&byteclass, delimiters);
+
+    return string__count(buffer, length, length, 0, &byteclass, threads);
 }
 
 /*
-char *string_shift_right(char *str, unsigned int amount)
+size_t string_counts_get(StringCounts *counts, char *key, size_t length)
 
 returns:
-    > <str> shifted <amount> of letters to the right
-    > NULL if invalid <str>
-    > needs to be freed!
+    > how many times the <length> bytes at <key> were counted
+    > 0 if they never were or invalid <counts> or <key>
 
 example:
-    > string_shift_right("abcdefg", 3) -> "efgabcd"
-                              ^>>
+    > string_counts_get(&counts, "be", 2) -> 2
 */
-char *string_shift_right(char *str, unsigned int amount)
+size_t string_counts_get(StringCounts *counts, char *key, size_t length)
 {
-    size_t length_str = strlen(str);
+    if (!counts || !counts->hashes || !key) {return 0;}
 
-    amount = amount % length_str;
+    uint64_t hash = string__bytes_hash(key, length);
+    size_t mask = counts->capacity - 1;
 
-    if (!str)        {return NULL;}
-    if (amount == 0) {return str;}
+    for (size_t slot = hash & mask; counts->hashes[slot]; slot = (slot + 1) & mask)
+    {
+        StringCount *entry = &counts->slots[slot];
 
-    char *output = malloc(length_str + 1);
+        if (counts->hashes[slot] == hash && entry->key.length == length && memcmp(entry->key.data, key, length) == 0)
+        {
+            return entry->count;
+        }
+    }
 
-    memcpy(output, str + (length_str - amount), amount);
-    memcpy(output + amount, str, length_str - amount);
+    return 0;
+}
 
-    output[length_str] = '\0';
+// Higher count first, ties in byte order, so top-k is deterministic
+static inline bool string__count_before(const StringCount *a, const StringCount *b)
+{
+    if (a->count != b->count) {return a->count > b->count;}
 
-    return output;
+    size_t length = (a->key.length < b->key.length) ? a->key.length : b->key.length;
+    int order = memcmp(a->key.data, b->key.data, length);
+
+    return (order != 0) ? order < 0 : a->key.length < b->key.length;
 }
 
-//----------------|
-// Capitalization |
-//----------------|
+// Restores the heap below <i>, whose root is the entry that ranks last
+static void string__count_sift(StringCount *heap, size_t count, size_t i)
+{
+    for (;;)
+    {
+        size_t last = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+
+        if (left < count && string__count_before(&heap[last], &heap[left]))     {last = left;}
+        if (right < count && string__count_before(&heap[last], &heap[right]))   {last = right;}
+
+        if (last == i) {return;}
+
+        StringCount swap = heap[i]; heap[i] = heap[last]; heap[last] = swap;
+        i = last;
+    }
+}
 
 /*
-char *string_upper(char *str) 
+size_t string_counts_top(StringCounts *counts, size_t k, StringCount *output)
 
 returns:
-    > <str> with upper case letters
-    > NULL if invalid <str>
-    > needs to be freed!
+    > the number of keys written to <output> (room for <k>): the <k> most frequent,
+      most frequent first, ties in byte order
+    > 0 if invalid <counts> or <output>
 
 example:
-    > string_upper("Hello World") -> "HELLO WORLD"
+    > string_counts_top(&counts, 2, top) -> 2 ({"be", 2}, {"to", 2})
 */
-char *string_upper(char *str)
+size_t string_counts_top(StringCounts *counts, size_t k, StringCount *output)
 {
-    if (!str) {return NULL;}
+    if (!counts || !counts->hashes || !output || k == 0) {return 0;}
 
-    size_t length_str = strlen(str);
-    char *output = malloc(length_str + 1);
+    // Heap of the best <k> so far, rooted at the one that ranks last
+    size_t count = 0;
 
-    for (int i = 0; i < length_str; ++i)
+    for (size_t i = 0; i < counts->capacity; ++i)
     {
-        if (str[i] != '\0') 
+        if (!counts->hashes[i]) {continue;}
+
+        StringCount *entry = &counts->slots[i];
+
+        if (count < k)
+        {
+            size_t child = count++;
+            output[child] = *entry;
+
+            while (child > 0)
+            {
+                size_t parent = (child - 1) / 2;
+                if (!string__count_before(&output[parent], &output[child])) {break;}
+
+                StringCount swap = output[parent]; output[parent] = output[child]; output[child] = swap;
+                child = parent;
+            }
+        }
+        else if (string__count_before(entry, &output[0]))
         {
-            output[i] = (char)toupper(str[i]);
+            output[0] = *entry;
+            string__count_sift(output, count, 0);
         }
     }
 
-    output[length_str] = '\0';
+    // Popping the root each time leaves the array best first
+    for (size_t end = count; end > 1; --end)
+    {
+        StringCount swap = output[0]; output[0] = output[end - 1]; output[end - 1] = swap;
+        string__count_sift(output, end - 1, 0);
+    }
 
-    return output;
+    return count;
 }
 
 /*
-char *string_lower(char *str)
-
-returns:
-    > <str> with lower case letters
-    > NULL if invalid <str>
-    > needs to be freed!
+void string_counts_free(StringCounts *counts)
 
-example:
-    > string_lower("HELLO WORLD") -> "hello world"
+frees:
+    > the table of <counts> (not the counted buffer) and empties it
 */
-char *string_lower(char *str)
+void string_counts_free(StringCounts *counts)
 {
-    if (!str) {return NULL;}
+    if (!counts) {return;}
+
+    free(counts->hashes);
+    free(counts->slots);
+
+    StringCounts empty = {0};
+    *counts = empty;
+}
+
+//------------------|
+// Pipeline Batches |
+//------------------|
+
+#ifndef ZSTRING_BATCH_READ
+    #define ZSTRING_BATCH_READ (1 << 20)
+#endif
+
+static double string__seconds(void)
+{
+#if defined(TIME_UTC)
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#else
+    return (double)time(NULL);
+#endif
+}
+
+// Files claimed one at a time by whichever worker is free next
+typedef struct string__batch_job
+{
+    const StringPipeline *pipeline;
+    char **inputs;
+    char **outputs;
+    size_t count;
+    size_t next;
+} string__batch_job;
+
+typedef struct string__batch_worker
+{
+    string__batch_job *job;
+    StringBatchWorker stats;
+} string__batch_worker;
+
+// Streams <input> through the pipeline into a temporary file next to <output>, then renames it over <output>
+static bool string__batch_file(const StringPipeline *pipeline, const char *input, const char *output, char *chunk, string__builder *out, StringBatchWorker *stats)
+{
+    FILE *in = fopen(input, "rb");
+    if (!in) {return false;}
+
+    size_t length_output = strlen(output);
+    char *temporary = malloc(length_output + 16);
+    snprintf(temporary, length_output + 16, "%s.zstring-tmp", output);
+
+    FILE *file = fopen(temporary, "wb");
+    if (!file)
+    {
+        fclose(in);
+        free(temporary);
+        return false;
+    }
+
+    string__pipeline_run run;
+    string__pipeline_run_init(&run, pipeline);
 
-    size_t length_str = strlen(str);
-    char *output = malloc(length_str + 1);
+    bool ok = true;
+    bool last = false;
 
-    for (int i = 0; i < length_str; ++i)
+    while (ok && !last)
     {
-        if (str[i] != '\0') 
-        {
-            output[i] = (char)tolower(str[i]);
-        }
-    }
+        size_t length = fread(chunk, 1, ZSTRING_BATCH_READ, in);
 
-    output[length_str] = '\0';
+        last = (length < ZSTRING_BATCH_READ);
+        if (last && ferror(in)) {ok = false; break;}
 
-    return output;
-}
+        stats->bytes_read += length;
 
-//-----------|
-// Replacing |
-//-----------|
+        out->length = 0;
+        string__pipeline_feed(&run, chunk, length, last, out);
 
-/*
-char *string_replace(char *str, char *substr, char *replacement)
+        if (out->length && fwrite(out->data, 1, out->length, file) != out->length) {ok = false;}
 
-returns:
-    > <str> with first occurence of <substr> replaced with <replacement>
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+        stats->bytes_written += out->length;
+    }
 
-example:
-    > string_replace("Hello Hello World", "Hello", "Bye") -> "Bye Hello World"
-                      ^---^
-*/
-char *string_replace(char *str, char *substr, char *replacement)
-{
-    if (!str || !substr)    {return NULL;}
-    if (!replacement)       {return str;}
+    string__pipeline_run_free(&run);
+    fclose(in);
 
-    size_t length_buf;
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
-    size_t length_rep = strlen(replacement);
+    if (fclose(file) != 0) {ok = false;}
 
-    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+#if !defined(_WIN32)
+    // The new file is created with the default mode, so give it the input's (an in-place run keeps an executable executable)
+    struct stat status;
+    if (ok && stat(input, &status) == 0) {chmod(temporary, status.st_mode & 07777);}
+#endif
 
-    char *ptr = strstr(str, substr);
+#if defined(_WIN32)
+    // rename() does not replace an existing file here
+    if (ok) {remove(output);}
+#endif
 
-    if (ptr == NULL) 
+    if (!ok || rename(temporary, output) != 0)
     {
-        return str;
+        remove(temporary);
+        ok = false;
     }
 
-    int pos = (ptr - str);
+    free(temporary);
 
-    if (length_sub < length_rep)
-    {
-        length_buf = length_str + (length_rep - length_sub);
-    }
-    else
+    return ok;
+}
+
+static void *string__batch_worker_run(void *argument)
+{
+    string__batch_worker *worker = argument;
+    string__batch_job *job = worker->job;
+
+    char *chunk = malloc(ZSTRING_BATCH_READ);
+    string__builder out = {NULL, 0, 0};
+
+    double start = string__seconds();
+
+    for (;;)
     {
-        length_buf = length_str - (length_sub - length_rep);
-    }
+        size_t i = STRING__ATOMIC_ADD(&job->next, 1) - 1;
+        if (i >= job->count) {break;}
 
-    char *output = malloc(length_buf);
+        if (string__batch_file(job->pipeline, job->inputs[i], job->outputs[i], chunk, &out, &worker->stats)) {++worker->stats.files;}
+        else {++worker->stats.failed;}
+    }
 
-    memcpy(output, str, pos);
-    memcpy(output + pos, replacement, length_rep);
-    memcpy(output + pos + length_rep, str + pos + length_sub, length_str - length_sub);
+    worker->stats.seconds = string__seconds() - start;
 
-    output[length_buf] = '\0';
+    free(out.data);
+    free(chunk);
 
-    return output;
+    return NULL;
 }
 
 /*
-char *string_replace_all(char *str, char *substr, char *replacement)
+size_t string_pipeline_run_files(StringPipeline *pipeline, char **inputs, char **outputs, size_t count, unsigned int threads, StringBatchWorker *workers)
 
 returns:
-    > <str> with every occurence of <substr> replaced with <replacement>
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+    > the number of the <count> files inputs[i] that were passed through <pipeline> into outputs[i]
+      (inputs[i] itself if <outputs> is NULL), each streamed in ZSTRING_BATCH_READ byte reads and
+      written to a temporary file that is then renamed over the output, so a reader never sees
+      half of one; <threads> workers (with ZSTRING_THREADS) take the next file as they finish one,
+      and what each did goes to <workers> (room for <threads>) if not NULL
+    > 0 if invalid <pipeline> or <inputs>
 
 example:
-    > string_replace_all("Hello Hello World", "Hello", "Bye") -> "Bye Bye World"
-                          ^---^ ^---^
+    > string_pipeline_run_files(rules, paths, NULL, path_count, 8, stats) -> path_count
 */
-char *string_replace_all(char *str, char *substr, char *replacement)
+size_t string_pipeline_run_files(StringPipeline *pipeline, char **inputs, char **outputs, size_t count, unsigned int threads, StringBatchWorker *workers)
 {
-    if (!str || !substr)    {return NULL;}
-    if (!replacement)       {return str;}
+    STRING__TRACK_PUBLIC();
 
-    size_t length_buf;
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
-    size_t length_rep = strlen(replacement);
+    if (!pipeline || !inputs) {return 0;}
 
-    if (length_str < length_sub || length_str == 0 || length_sub == 0) {return 0;}
+    if (threads < 1) {threads = 1;}
 
-    unsigned int count = 0;
-    
-    {
-        char *ptr = str;
+    string__batch_job job = {pipeline, inputs, outputs ? outputs : inputs, count, 0};
+    string__batch_worker *pool = calloc(threads, sizeof(string__batch_worker));
 
-        while (ptr = strstr(ptr, substr)) 
-        {
-            ptr += length_sub;
-            ++count;
-        }
-    }
+    for (unsigned int t = 0; t < threads; ++t) {pool[t].job = &job;}
 
-    if (count == 0) {return str;}
+#if defined(ZSTRING_THREADS)
+    pthread_t *handles = malloc(sizeof(pthread_t) * threads);
+    bool *started = calloc(threads, sizeof(bool));
 
-    if (length_sub < length_rep)
+    for (unsigned int t = 1; t < threads; ++t)
     {
-        length_buf = length_str + ((length_rep - length_sub) * count);
+        started[t] = (pthread_create(&handles[t], NULL, string__batch_worker_run, &pool[t]) == 0);
     }
-    else
+
+    string__batch_worker_run(&pool[0]);
+
+    for (unsigned int t = 1; t < threads; ++t)
     {
-        length_buf = length_str - ((length_sub - length_rep) * count); // Change (Don't make buffer unnecessarily large)
+        if (started[t]) {pthread_join(handles[t], NULL);}
     }
 
-    int pos_str = 0;
-    int pos_out = 0;
-    char *output = malloc(length_buf);
+    free(started);
+    free(handles);
+#else
+    string__batch_worker_run(&pool[0]);
+#endif
+
+    size_t written = 0;
 
-    for (int i = 0; i < count; ++i)
+    for (unsigned int t = 0; t < threads; ++t)
     {
-        int pos = -1;
+        written += pool[t].stats.files;
+        if (workers) {workers[t] = pool[t].stats;}
+    }
 
-        const char *ptr = str;
+    free(pool);
 
-        for (int j = 0; j < i + 1; ++j) 
-        {
-            ptr = strstr(ptr, substr);
-    
-            if (ptr == NULL)
-            {
-                break;
-            } 
+    return written;
+}
 
-            pos = (ptr - str);
-            ++ptr;
-        }
+//---------------|
+// Large Buffers |
+//---------------|
 
-        int length_copy = pos - pos_str;
-        
-        memcpy(output + pos_out, str + pos_str, length_copy);
-        pos_out += length_copy;
-        pos_str += length_copy;
+/*
+    The functions above take NUL terminated strings and mostly give int positions and unsigned
+    int counts, which stop being right past 2 GB. These take a buffer and its length instead
+    (so it may hold NULs and is never strlen()ed) and use size_t / ptrdiff_t throughout.
+*/
 
-        memcpy(output + pos_out, replacement, length_rep);
-        pos_out += length_rep;
-        pos_str += length_sub;
-    }
+// Outputs at least this big are aligned to 2 MiB and offered transparent huge pages where there are any
+#ifndef ZSTRING_HUGE_PAGES_MIN
+    #define ZSTRING_HUGE_PAGES_MIN ((size_t)64 << 20)
+#endif
 
-    memcpy(output + pos_out, str + pos_str, length_str - pos_str);
+// malloc() for an output of <size> bytes, which for big ones means fewer TLB misses while it is written
+static char *string__buffer_alloc(size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE) && !defined(ZSTRING_TRACK_ALLOCATIONS)
+    const size_t huge = (size_t)2 << 20;
 
-    output[length_buf] = '\0';
-    return output;
-}
+    if (size >= ZSTRING_HUGE_PAGES_MIN)
+    {
+        void *ptr = NULL;
 
-//-----------|
-// Inserting |
-//-----------|
+        if (posix_memalign(&ptr, huge, size) == 0)
+        {
+            madvise(ptr, size & ~(huge - 1), MADV_HUGEPAGE);
+            return ptr;
+        }
+    }
+#endif
+
+    return malloc(size);
+}
 
 /*
-char *string_insert(char *str, char *substr, unsigned int index)
+ptrdiff_t string_buffer_find(char *buffer, size_t length, char *substr)
 
 returns:
-    > <str> with <substr> inserted at <index>
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+    > offset of the first occurence of <substr> in the <length> bytes at <buffer>
+    > -1 if <substr> wasn't found, or invalid <buffer> or <substr>
 
 example:
-    > string_insert("Hello World", "There ", 6) -> "Hello There World"
-                           ^
+    > string_buffer_find(dump, dump_length, "\nERROR") -> 5368709131 (past 4 GB)
 */
-char *string_insert(char *str, char *substr, unsigned int index)
+ptrdiff_t string_buffer_find(char *buffer, size_t length, char *substr)
 {
-    if (!str)       {return NULL;}
-    if (!substr)    {return str;}
-
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
-    size_t length_buf = length_str + length_sub;
+    if (!buffer || !substr) {return -1;}
 
-    char *output = malloc(length_buf + 1);
-
-    memcpy(output, str, index);
-    memcpy(output + index, substr, length_sub);
-    memcpy(output + index + length_sub, str + index, length_str);
+    size_t match = string__find(buffer, length, substr, strlen(substr));
 
-    output[length_buf] = '\0';
-
-    return output;
+    return (match == (size_t)-1) ? -1 : (ptrdiff_t)match;
 }
 
-//-----------|
-// Reversing |
-//-----------|
-
 /*
-char *string_reverse(char *str)
+ptrdiff_t string_buffer_find_nth(char *buffer, size_t length, char *substr, size_t nth)
 
 returns:
-    > <str> reversed
-    > NULL if invalid <str>
-    > needs to be freed!
+    > offset of the <nth> occurence of <substr> in the <length> bytes at <buffer>,
+      overlapping ones included (like string_find_nth())
+    > -1 if there are fewer than <nth>, or invalid <buffer>, <substr> or <nth>
 
 example:
-    > string_reverse("Hello World") -> "dlroW olleH"
+    > string_buffer_find_nth("Foo Bar Foo Bar", 15, "Foo", 2) -> 8
 */
-char *string_reverse(char *str)
+ptrdiff_t string_buffer_find_nth(char *buffer, size_t length, char *substr, size_t nth)
 {
-    if (!str) {return NULL;}
+    if (!buffer || !substr || nth == 0) {return -1;}
 
-    size_t length_str = strlen(str);
-    char *output = malloc(length_str + 1);
+    size_t length_sub = strlen(substr);
+    size_t pos = 0;
 
+    for (;;)
     {
-        int j = length_str - 1;
-        for (int i = 0; i < length_str; ++i)
-        {
-            output[i] = str[j];
-            --j;
-        }
-    }
+        size_t match = string__find(buffer + pos, length - pos, substr, length_sub);
+        if (match == (size_t)-1) {return -1;}
 
-    output[length_str] = '\0';
+        if (--nth == 0) {return (ptrdiff_t)(pos + match);}
 
-    return output;
+        pos += match + 1;
+        if (pos > length) {return -1;}
+    }
 }
 
-//---------|
-// Getting |
-//---------|
+// Matches of <substr> in <buffer>, each search starting <step> bytes after the last match (0 for its length)
+static size_t string__buffer_count(const char *buffer, size_t length, const char *substr, size_t length_sub, size_t step)
+{
+    size_t count = 0;
+    size_t pos = 0;
+    size_t match;
+
+    if (step == 0) {step = length_sub;}
+
+    while (pos < length && (match = string__find(buffer + pos, length - pos, substr, length_sub)) != (size_t)-1)
+    {
+        pos += match + step;
+        ++count;
+    }
+
+    return count;
+}
 
 /*
-char *string_before(char *str, char *substr)
+size_t string_buffer_count(char *buffer, size_t length, char *substr)
 
 returns:
-    > returns the string before <substr> in <str>
-    > NULL if invalid <str> or <substr>
-    > needs to be freed!
+    > the amount of times <substr> occurs in the <length> bytes at <buffer> (like string_count())
+    > 0 if invalid <buffer> or <substr>, or <substr> is empty
 
 example:
-    > string_before("Hello There World", "There") -> "Hello "
+    > string_buffer_count("Fooo Foo", 8, "oo") -> 2
 */
-char *string_before(char *str, char *substr)
+size_t string_buffer_count(char *buffer, size_t length, char *substr)
 {
-    if (!str || !substr) {return NULL;}
-    
-    size_t length_str = strlen(str);
-    size_t length_sub = strlen(substr);
+    if (!buffer || !substr || *substr == '\0') {return 0;}
 
-    int pos;
-
-    if (length_str > 0 && length_sub > 0)
-    {
-        const char *ptr;
+    return string__buffer_count(buffer, length, substr, strlen(substr), 0);
+}
 
-        ptr = str;
-        ptr = strstr(ptr, substr);
-    
-        if (ptr != NULL)
-        {
-            pos = ptr - str;
-        } 
-        else {return NULL;}
-    }
+/*
+size_t string_buffer_count_overlap(char *buffer, size_t length, char *substr)
 
-    char *output = malloc(pos + 1);
+returns:
+    > the amount of times <substr> occurs in the <length> bytes at <buffer> with overlap
+      (like string_count_overlap())
+    > 0 if invalid <buffer> or <substr>, or <substr> is empty
 
-    memcpy(output, str, pos);
-    
-    output[pos] = '\0';
+example:
+    > string_buffer_count_overlap("Fooo Foo", 8, "oo") -> 3
+*/
+size_t string_buffer_count_overlap(char *buffer, size_t length, char *substr)
+{
+    if (!buffer || !substr || *substr == '\0') {return 0;}
 
-    return output;
+    return string__buffer_count(buffer, length, substr, strlen(substr), 1);
 }
 
 /*
-char *string_after(char *str, char *substr)
+char *string_buffer_replace_all(char *buffer, size_t length, char *substr, char *replacement, size_t *length_output)
 
 returns:
-    > returns the string after <substr> in <str>
-    > NULL if invalid <str> or <substr>
+    > a NUL terminated copy of the <length> bytes at <buffer> with every occurence of <substr>
+      replaced with <replacement>, its length written to <length_output> if not NULL
+    > NULL if invalid <buffer>, <substr> or <replacement>, or <substr> is empty
     > needs to be freed!
 
 example:
-    > string_after("Hello There World", "There") -> " World"
+    > string_buffer_replace_all(dump, dump_length, "\r\n", "\n", &length) -> dump with LF line ends
 */
-char *string_after(char *str, char *substr)
+char *string_buffer_replace_all(char *buffer, size_t length, char *substr, char *replacement, size_t *length_output)
 {
-    if (!str || !substr) {return NULL;}
-    
-    size_t length_str = strlen(str);
+    STRING__TRACK_PUBLIC();
+
+    if (!buffer || !substr || !replacement || *substr == '\0') {return NULL;}
+
     size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+    size_t count = string__buffer_count(buffer, length, substr, length_sub, 0);
+
+    size_t length_buf = length - length_sub * count + length_rep * count;
+    char *output = string__buffer_alloc(length_buf + 1);
 
-    int pos;
+    if (!output) {return NULL;}
 
-    if (length_str > 0 && length_sub > 0)
+    size_t pos = 0;
+    size_t pos_out = 0;
+
+    for (size_t i = 0; i < count; ++i)
     {
-        const char *ptr;
+        size_t match = string__find(buffer + pos, length - pos, substr, length_sub);
 
-        ptr = str;
-        ptr = strstr(ptr, substr);
-    
-        if (ptr != NULL)
-        {
-            pos = ptr - str;
-        } 
-        else {return NULL;}
-    }
+        memcpy(output + pos_out, buffer + pos, match);
+        pos_out += match;
 
-    size_t length_buf = (length_str - length_sub) - pos;
+        memcpy(output + pos_out, replacement, length_rep);
+        pos_out += length_rep;
 
-    char *output = malloc(length_buf + 1);
+        pos += match + length_sub;
+    }
+
+    memcpy(output + pos_out, buffer + pos, length - pos);
 
-    memcpy(output, str + pos + length_sub, length_buf);
-    
     output[length_buf] = '\0';
+    if (length_output) {*length_output = length_buf;}
 
     return output;
 }
 
 /*
-char *string_between(char *str, char *a, char *b)
+char *string_buffer_remove_all(char *buffer, size_t length, char *substr, size_t *length_output)
 
 returns:
-    > returns the string between <a> and <b> in <str>
-    > NULL if invalid <str>, <a> or <b>
+    > string_buffer_replace_all() with an empty replacement
     > needs to be freed!
 
 example:
-    > string_between("Hello There World", "Hello", "World") -> " There "
+    > string_buffer_remove_all(dump, dump_length, "\r", &length) -> dump without CRs
 */
-char *string_between(char *str, char *a, char *b)
+char *string_buffer_remove_all(char *buffer, size_t length, char *substr, size_t *length_output)
 {
-    if (!str || !a || !b) {return NULL;}
-    
-    size_t length_str = strlen(str);
-    size_t length_a = strlen(a);
-    size_t length_b = strlen(b);
+    STRING__TRACK_PUBLIC();
 
-    int pos_a;
-    int pos_b;
+    return string_buffer_replace_all(buffer, length, substr, "", length_output);
+}
 
-    if (length_str > 0 && length_a > 0 && length_b > 0)
-    {
-        const char *ptr;
+/*
+char *string_buffer_reverse(char *buffer, size_t length)
 
-        ptr = str;
-        ptr = strstr(ptr, a);
-    
-        if (ptr != NULL)
-        {
-            pos_a = ptr - str;
-        } 
-        else {return NULL;}
+returns:
+    > a NUL terminated copy of the <length> bytes at <buffer> in reverse order
+    > NULL if invalid <buffer>
+    > needs to be freed!
 
-        ptr = str;
-        ptr = strstr(ptr, b);
-    
-        if (ptr != NULL)
-        {
-            pos_b = ptr - str;
-        }
-        else {return NULL;}
-    }
+example:
+    > string_buffer_reverse("Hello World", 11) -> "dlroW olleH"
+*/
+char *string_buffer_reverse(char *buffer, size_t length)
+{
+    STRING__TRACK_PUBLIC();
 
-    size_t length_buf = (pos_b - (pos_a + length_a));
+    if (!buffer) {return NULL;}
 
-    char *output = malloc(length_buf + 1);
+    char *output = string__buffer_alloc(length + 1);
 
-    memcpy(output, str + (pos_a + length_a), length_buf);
-    
-    output[length_buf] = '\0';
+    if (!output) {return NULL;}
+
+    string__reverse_copy((unsigned char *)output, (const unsigned char *)buffer, length);
 
+    output[length] = '\0';
     return output;
 }
 
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    #undef malloc
+    #undef calloc
+    #undef realloc
+    #undef free
+    #undef pthread_create
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,454 @@
+/*
+    C++20 front end for ZString.h
+
+    #define ZSTRING_IMPLEMENTATION in one C file, then include this header from C++
+*/
+
+#ifndef ZSTRING_HPP
+#define ZSTRING_HPP
+
+#if __cplusplus < 202002L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+    #error "ZString.hpp requires C++20"
+#endif
+
+#include "ZString.h"
+
+#include <array>        // std::array
+#include <bit>          // std::bit_cast, std::countr_zero
+#include <cstdint>      // uint16_t, uint32_t, uint64_t
+#include <cstring>      // std::memchr, std::memcmp, std::memcpy, std::memmove
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <type_traits>  // std::is_integral_v, std::type_identity_t
+#include <vector>       // std::vector
+
+namespace zstring
+{
+    //------------------------------------------------------------------------
+    // Formatting
+    //------------------------------------------------------------------------
+
+    namespace detail
+    {
+        // Amount of "{}" in <fmt> ("{{" and "}}" are literal braces), -1 if <fmt> is malformed
+        constexpr int count_placeholders(std::string_view fmt)
+        {
+            int count = 0;
+
+            for (size_t i = 0; i < fmt.size(); ++i)
+            {
+                if (fmt[i] == '{')
+                {
+                    if (i + 1 < fmt.size() && fmt[i + 1] == '{') {++i; continue;}
+                    if (i + 1 < fmt.size() && fmt[i + 1] == '}') {++i; ++count; continue;}
+                    return -1;
+                }
+
+                if (fmt[i] == '}')
+                {
+                    if (i + 1 < fmt.size() && fmt[i + 1] == '}') {++i; continue;}
+                    return -1;
+                }
+            }
+
+            return count;
+        }
+
+        // Not constexpr on purpose: reaching it during constant evaluation is the compile error
+        inline void format_string_does_not_match_arguments() {}
+
+        template <class T>
+        constexpr bool is_formattable_v =
+            std::is_arithmetic_v<T> || std::is_convertible_v<const T &, std::string_view>;
+
+        template <class T>
+        void append(std::string &out, const T &value)
+        {
+            static_assert(is_formattable_v<T>, "zstring::format: unsupported argument type");
+
+            char buffer[32];
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                out += value ? "true" : "false";
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                out += value;
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                out.append(buffer, string_write_int(buffer, value));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                out.append(buffer, string_write_uint(buffer, value));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                out.append(buffer, string_write_double(buffer, static_cast<double>(value)));
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                out += value ? std::string_view(value) : std::string_view("(null)");
+            }
+            else
+            {
+                out += std::string_view(value);
+            }
+        }
+
+        // Copies literal text up to (and consumes) the next "{}"
+        inline void append_literal(std::string &out, std::string_view &fmt)
+        {
+            size_t i = 0;
+
+            while (i < fmt.size())
+            {
+                if (fmt[i] == '{' && i + 1 < fmt.size() && fmt[i + 1] == '}') {fmt.remove_prefix(i + 2); return;}
+
+                out += fmt[i];
+                i += (fmt[i] == '{' || fmt[i] == '}') ? 2 : 1;
+            }
+
+            fmt.remove_prefix(fmt.size());
+        }
+
+        template <class... Args>
+        struct basic_format_string
+        {
+            std::string_view str;
+
+            template <class S>
+                requires std::is_convertible_v<const S &, std::string_view>
+            consteval basic_format_string(const S &s) : str(s)
+            {
+                if (count_placeholders(str) != static_cast<int>(sizeof...(Args)))
+                {
+                    format_string_does_not_match_arguments();
+                }
+
+                static_assert((is_formattable_v<std::remove_cvref_t<Args>> && ...), "zstring::format: unsupported argument type");
+            }
+        };
+    }
+
+    // Format string checked at compile time against the argument count and types
+    template <class... Args>
+    using format_string = detail::basic_format_string<std::type_identity_t<Args>...>;
+
+    /*
+    void zstring::format_to(std::string &out, format_string fmt, args...)
+
+    appends:
+        > <fmt> to <out> with every "{}" replaced by the next argument
+          (integers in decimal, floating point as the shortest round-trip text)
+
+    example:
+        > zstring::format_to(out, "{} took {}s", "parse", 0.25) -> out += "parse took 0.25s"
+    */
+    template <class... Args>
+    void format_to(std::string &out, format_string<Args...> fmt, const Args &... args)
+    {
+        std::string_view rest = fmt.str;
+
+        (void)(( detail::append_literal(out, rest), detail::append(out, args) ), ...);
+
+        detail::append_literal(out, rest);
+    }
+
+    /*
+    std::string zstring::format(format_string fmt, args...)
+
+    returns:
+        > <fmt> with every "{}" replaced by the next argument
+
+    example:
+        > zstring::format("id={} t={}", 42, 1.5)  -> "id=42 t=1.5"
+        > zstring::format("id={} t={}", 42)       -> compile error
+    */
+    template <class... Args>
+    std::string format(format_string<Args...> fmt, const Args &... args)
+    {
+        std::string out;
+        out.reserve(fmt.str.size() + sizeof...(Args) * 16);
+
+        format_to<Args...>(out, fmt, args...);
+
+        return out;
+    }
+
+    //------------------------------------------------------------------------
+    // Literal Needles
+    //------------------------------------------------------------------------
+
+    inline constexpr size_t npos = std::string_view::npos;
+
+    // String literal usable as a template argument, e.g. zstring::count<"ERROR">(line)
+    template <size_t N>
+    struct literal
+    {
+        char data[N + 1] {};
+
+        constexpr literal(const char (&str)[N + 1])
+        {
+            for (size_t i = 0; i <= N; ++i) {data[i] = str[i];}
+        }
+
+        static constexpr size_t size() {return N;}
+        constexpr std::string_view view() const {return {data, N};}
+    };
+
+    template <size_t N>
+    literal(const char (&)[N]) -> literal<N - 1>;
+
+    namespace detail
+    {
+        template <size_t N>
+        using word_t = std::conditional_t<N == 2, uint16_t, std::conditional_t<N == 4, uint32_t, uint64_t>>;
+
+        // <Needle> as the integer an unaligned load of it yields, for 2, 4 and 8 byte needles
+        template <literal Needle>
+        constexpr word_t<Needle.size()> packed()
+        {
+            std::array<char, Needle.size()> bytes {};
+
+            for (size_t i = 0; i < Needle.size(); ++i) {bytes[i] = Needle.data[i];}
+
+            return std::bit_cast<word_t<Needle.size()>>(bytes);
+        }
+
+        template <literal Needle>
+        inline bool matches_at(const char *ptr)
+        {
+            constexpr size_t N = Needle.size();
+
+            if constexpr (N == 2 || N == 4 || N == 8)
+            {
+                // One load and one compare against a constant
+                word_t<N> word;
+                std::memcpy(&word, ptr, N);
+
+                return word == packed<Needle>();
+            }
+            else
+            {
+                return std::memcmp(ptr, Needle.data, N) == 0;
+            }
+        }
+
+        // Position of <Needle> in <hay>, npos if not found
+        template <literal Needle>
+        inline size_t find(const char *hay, size_t length)
+        {
+            constexpr size_t N = Needle.size();
+            static_assert(N > 0, "zstring: empty needle");
+
+            if (length < N) {return npos;}
+
+            if constexpr (N == 1)
+            {
+                const void *ptr = std::memchr(hay, Needle.data[0], length);
+                return ptr ? static_cast<size_t>(static_cast<const char *>(ptr) - hay) : npos;
+            }
+            else
+            {
+                size_t i = 0;
+
+                // Candidates must match the first and last byte of <Needle>, both broadcast once at compile time
+#if defined(ZSTRING_AVX2)
+                const __m256i first = _mm256_set1_epi8(Needle.data[0]);
+                const __m256i last = _mm256_set1_epi8(Needle.data[N - 1]);
+
+                for (; i + N - 1 + 32 <= length; i += 32)
+                {
+                    __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i)), first);
+                    __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i + N - 1)), last);
+
+                    for (unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(a, b))); mask; mask &= mask - 1)
+                    {
+                        size_t pos = i + std::countr_zero(mask);
+                        if (matches_at<Needle>(hay + pos)) {return pos;}
+                    }
+                }
+#elif defined(ZSTRING_SSE2)
+                const __m128i first = _mm_set1_epi8(Needle.data[0]);
+                const __m128i last = _mm_set1_epi8(Needle.data[N - 1]);
+
+                for (; i + N - 1 + 16 <= length; i += 16)
+                {
+                    __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i)), first);
+                    __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i + N - 1)), last);
+
+                    for (unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(a, b))); mask; mask &= mask - 1)
+                    {
+                        size_t pos = i + std::countr_zero(mask);
+                        if (matches_at<Needle>(hay + pos)) {return pos;}
+                    }
+                }
+#endif
+
+                for (; i + N <= length; ++i)
+                {
+                    if (hay[i] == Needle.data[0] && matches_at<Needle>(hay + i)) {return i;}
+                }
+
+                return npos;
+            }
+        }
+    }
+
+    /*
+    size_t zstring::find<"needle">(std::string_view str)
+
+    returns:
+        > position of the first occurence of the literal needle in <str>
+        > zstring::npos if it wasn't found
+
+    example:
+        > zstring::find<"\r\n">("GET / HTTP/1.1\r\n") -> 14
+    */
+    template <literal Needle>
+    constexpr size_t find(std::string_view str)
+    {
+        if (std::is_constant_evaluated()) {return str.find(Needle.view());}
+
+        return detail::find<Needle>(str.data(), str.size());
+    }
+
+    /*
+    size_t zstring::count<"needle">(std::string_view str)
+
+    returns:
+        > the amount of non-overlapping occurences of the literal needle in <str>
+
+    example:
+        > zstring::count<"ERROR">(line) -> 2
+    */
+    template <literal Needle>
+    constexpr size_t count(std::string_view str)
+    {
+        size_t amount = 0;
+        size_t pos = 0;
+        size_t match;
+
+        while ((match = find<Needle>(str.substr(pos))) != npos)
+        {
+            pos += match + Needle.size();
+            ++amount;
+        }
+
+        return amount;
+    }
+
+    /*
+    bool zstring::contains<"needle">(std::string_view str)
+
+    returns:
+        > true if the literal needle occurs in <str>
+    */
+    template <literal Needle>
+    constexpr bool contains(std::string_view str)
+    {
+        return find<Needle>(str) != npos;
+    }
+
+    /*
+    std::vector<std::string_view> zstring::split<"delimiter">(std::string_view str)
+
+    returns:
+        > views into <str> between the occurences of the literal delimiter (empty fields are kept)
+
+    example:
+        > zstring::split<", ">("a, b, c") -> {"a", "b", "c"}
+    */
+    template <literal Delimiter>
+    std::vector<std::string_view> split(std::string_view str)
+    {
+        std::vector<std::string_view> fields;
+        size_t match;
+
+        while ((match = find<Delimiter>(str)) != npos)
+        {
+            fields.push_back(str.substr(0, match));
+            str.remove_prefix(match + Delimiter.size());
+        }
+
+        fields.push_back(str);
+
+        return fields;
+    }
+
+    /*
+    std::string zstring::replace_all<"needle">(std::string_view str, std::string_view replacement)
+
+    returns:
+        > <str> with every occurence of the literal needle replaced with <replacement>
+
+    example:
+        > zstring::replace_all<"\r\n">("a\r\nb\r\n", "\n") -> "a\nb\n"
+    */
+    template <literal Needle>
+    std::string replace_all(std::string_view str, std::string_view replacement)
+    {
+        std::string out;
+        out.reserve(str.size());
+
+        size_t match;
+
+        while ((match = find<Needle>(str)) != npos)
+        {
+            out.append(str.data(), match);
+            out.append(replacement);
+            str.remove_prefix(match + Needle.size());
+        }
+
+        out.append(str);
+
+        return out;
+    }
+
+    /*
+    std::string zstring::replace_all<"needle">(std::string &&str, std::string_view replacement)
+
+    returns:
+        > same as above, but reuses the buffer of <str> when <replacement>
+          isn't longer than the needle (no allocation)
+
+    example:
+        > text = zstring::replace_all<"\r\n">(std::move(text), "\n");
+    */
+    template <literal Needle, class S>
+        requires (std::is_same_v<S, std::string> && !std::is_lvalue_reference_v<S>)
+    std::string replace_all(S &&str, std::string_view replacement)
+    {
+        if (replacement.size() > Needle.size()) {return replace_all<Needle>(std::string_view(str), replacement);}
+
+        std::string out = std::move(str);
+
+        char *data = out.data();
+        size_t length = out.size();
+        size_t read = 0;
+        size_t write = 0;
+        size_t match;
+
+        // <write> never passes <read>, so the text still to be searched is never overwritten
+        while ((match = detail::find<Needle>(data + read, length - read)) != npos)
+        {
+            std::memmove(data + write, data + read, match);
+            write += match;
+
+            std::memcpy(data + write, replacement.data(), replacement.size());
+            write += replacement.size();
+
+            read += match + Needle.size();
+        }
+
+        std::memmove(data + write, data + read, length - read);
+        out.resize(write + (length - read));
+
+        return out;
+    }
+}
+
+#endif // ZSTRING_HPP
@@ -0,0 +1,1964 @@
+/*
+    Fuzz harness for ZString.h: LLVMFuzzerTestOneInput() runs the library on what the fuzzer
+    feeds it and checks each function against a plain byte-at-a-time reference, the C library
+    (snprintf(), strtod(), strtoll(), strtoull(), regexec(), fnmatch(), qsort()) or, for the
+    engines built on them, against the function they must agree with, aborting on the first
+    difference.
+
+    libFuzzer:  cc -O1 -g -fsanitize=fuzzer,address,undefined ZStringFuzz.c -lm -lpthread
+    standalone: cc -O1 -g -fsanitize=address,undefined -DZSTRING_FUZZ_MAIN ZStringFuzz.c -lm -lpthread
+
+    The standalone build replays the files it is given (for AFL and crash reproduction) or runs
+    ZSTRING_FUZZ_RUNS random inputs and reports the throughput.
+
+    An input is two bytes of amounts followed by <str>, <substr> and <replacement>, separated
+    by NULs; each is copied to a buffer of exactly its size, so any read past its end shows.
+    The number, format and pattern checks also draw bytes from the whole input.
+
+    With -DZSTRING_TRACK_ALLOCATIONS the harness allocates through the tracker too, and every
+    input must leave nothing live on its books.
+*/
+
+#define ZSTRING_IMPLEMENTATION
+#include "ZString.h"
+
+#include <math.h>       // isnan(), isfinite()
+#include <errno.h>      // errno, ERANGE
+
+#if !defined(_WIN32)
+    #include <regex.h>      // regcomp(), regexec()
+    #include <fnmatch.h>    // fnmatch()
+    #include <unistd.h>     // close()
+#endif
+
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    // The header's own redirection ends with its implementation; this one lets results be freed as any other block
+    #define malloc(size) string__track_malloc((size), __func__)
+    #define realloc(ptr, size) string__track_realloc((ptr), (size), __func__)
+    #define free(ptr) string_free(ptr)
+#endif
+
+#ifndef ZSTRING_FUZZ_RUNS
+    #define ZSTRING_FUZZ_RUNS 1000000
+#endif
+
+#define STRING__FUZZ_CHECK(condition) do {if (!(condition)) {string__fuzz_fail(#condition, __LINE__);}} while (0)
+
+static void string__fuzz_fail(const char *condition, int line)
+{
+    fprintf(stderr, "ZString: fuzz check failed on line %d: %s\n", line, condition);
+    abort();
+}
+
+static char string__fuzz_fold(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+static bool string__fuzz_equal(const char *str, const char *data, size_t length)
+{
+    return str && strlen(str) == length && memcmp(str, data, length) == 0;
+}
+
+static bool string__fuzz_span_equal(StringSpan span, const char *data, size_t length)
+{
+    return span.length == length && (length == 0 || memcmp(span.data, data, length) == 0);
+}
+
+// First match of <substr> in <str> at or after <from>, trying every position
+static size_t string__fuzz_find(const char *str, size_t length, const char *substr, size_t length_sub, size_t from, bool ci)
+{
+    for (size_t i = from; i + length_sub <= length; ++i)
+    {
+        size_t j = 0;
+
+        while (j < length_sub && (ci ? string__fuzz_fold(str[i + j]) == string__fuzz_fold(substr[j]) : str[i + j] == substr[j])) {++j;}
+
+        if (j == length_sub) {return i;}
+    }
+
+    return (size_t)-1;
+}
+
+static size_t string__fuzz_count(const char *str, const char *substr, bool overlap, bool ci)
+{
+    size_t length = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t count = 0;
+
+    for (size_t pos = 0; (pos = string__fuzz_find(str, length, substr, length_sub, pos, ci)) != (size_t)-1; ++count)
+    {
+        pos += overlap ? 1 : length_sub;
+    }
+
+    return count;
+}
+
+// <str> with the first <limit> non-overlapping matches of <substr> (not empty) replaced
+static char *string__fuzz_replace(const char *str, const char *substr, const char *replacement, size_t limit, bool ci)
+{
+    size_t length = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t length_rep = strlen(replacement);
+
+    char *output = malloc(length + (length / length_sub + 1) * length_rep + 1);
+    size_t pos = 0;
+    size_t pos_out = 0;
+    size_t match;
+
+    while (limit-- > 0 && (match = string__fuzz_find(str, length, substr, length_sub, pos, ci)) != (size_t)-1)
+    {
+        memcpy(output + pos_out, str + pos, match - pos);
+        pos_out += match - pos;
+
+        memcpy(output + pos_out, replacement, length_rep);
+        pos_out += length_rep;
+
+        pos = match + length_sub;
+    }
+
+    memcpy(output + pos_out, str + pos, length - pos + 1);
+
+    return output;
+}
+
+// Fields of <str> between each byte of <delimiters> (mode 0), or each whole <delimiters> (1, or 2 ignoring case)
+static size_t string__fuzz_fields(const char *str, const char *delimiters, int mode, bool skip_empty, StringSpan *fields)
+{
+    size_t length = strlen(str);
+    size_t length_sub = strlen(delimiters);
+    size_t count = 0;
+    size_t start = 0;
+
+    for (;;)
+    {
+        size_t end;
+        size_t skip;
+
+        if (mode == 0)
+        {
+            end = start;
+            while (end < length && !strchr(delimiters, str[end])) {++end;}
+            skip = 1;
+        }
+        else
+        {
+            end = string__fuzz_find(str, length, delimiters, length_sub, start, mode == 2);
+            if (end == (size_t)-1) {end = length;}
+            skip = length_sub;
+        }
+
+        if (end > start || !skip_empty)
+        {
+            fields[count].data = (char *)str + start;
+            fields[count].length = end - start;
+            ++count;
+        }
+
+        if (end >= length) {break;}
+
+        start = end + skip;
+    }
+
+    return count;
+}
+
+static void string__fuzz_check_fields(char **output, StringSpan *fields, size_t count)
+{
+    STRING__FUZZ_CHECK(output != NULL);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        STRING__FUZZ_CHECK(string__fuzz_equal(output[i], fields[i].data, fields[i].length));
+    }
+
+    STRING__FUZZ_CHECK(output[count] == NULL);
+}
+
+static unsigned int string__fuzz_edit_distance(const char *a, const char *b)
+{
+    size_t length_a = strlen(a);
+    size_t length_b = strlen(b);
+    unsigned int *row = malloc(sizeof(unsigned int) * (length_b + 1));
+
+    for (size_t j = 0; j <= length_b; ++j) {row[j] = (unsigned int)j;}
+
+    for (size_t i = 1; i <= length_a; ++i)
+    {
+        unsigned int diagonal = row[0];
+        row[0] = (unsigned int)i;
+
+        for (size_t j = 1; j <= length_b; ++j)
+        {
+            unsigned int above = row[j];
+            unsigned int best = diagonal + (a[i - 1] != b[j - 1]);
+
+            if (above + 1 < best)      {best = above + 1;}
+            if (row[j - 1] + 1 < best) {best = row[j - 1] + 1;}
+
+            row[j] = best;
+            diagonal = above;
+        }
+    }
+
+    unsigned int distance = row[length_b];
+    free(row);
+
+    return distance;
+}
+
+// Well-formed UTF-8 by the table in Unicode 15, chapter 3.9
+static bool string__fuzz_utf8_valid(const unsigned char *str, size_t *codepoints)
+{
+    *codepoints = 0;
+
+    while (*str)
+    {
+        unsigned char c = *str;
+        size_t extra = 0;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+
+        if (c < 0x80)                   {extra = 0;}
+        else if (c >= 0xC2 && c <= 0xDF) {extra = 1;}
+        else if (c >= 0xE0 && c <= 0xEF) {extra = 2; if (c == 0xE0) {low = 0xA0;} if (c == 0xED) {high = 0x9F;}}
+        else if (c >= 0xF0 && c <= 0xF4) {extra = 3; if (c == 0xF0) {low = 0x90;} if (c == 0xF4) {high = 0x8F;}}
+        else                            {return false;}
+
+        for (size_t i = 1; i <= extra; ++i)
+        {
+            unsigned char lo = (i == 1) ? low : 0x80;
+            unsigned char hi = (i == 1) ? high : 0xBF;
+
+            if (str[i] < lo || str[i] > hi) {return false;}
+        }
+
+        str += extra + 1;
+        ++*codepoints;
+    }
+
+    return true;
+}
+
+// Frees <output> unless it is <str> itself, which some functions hand back when there is nothing to do
+static void string__fuzz_release(char *output, char *str)
+{
+    if (output != str) {free(output);}
+}
+
+static char *string__fuzz_copy(const char *str)
+{
+    size_t length = strlen(str);
+    char *output = malloc(length + 1);
+
+    memcpy(output, str, length + 1);
+
+    return output;
+}
+
+// A string_ref_ result of <ref> against what the plain function gave, then released; only an unchanged one may be <ref> itself
+static void string__fuzz_check_ref(char *ref, char *output, const char *expected)
+{
+    STRING__FUZZ_CHECK(output && string_ref_length(output) == strlen(expected) && strcmp(output, expected) == 0);
+    STRING__FUZZ_CHECK(output != ref || strcmp(ref, expected) == 0);
+    STRING__FUZZ_CHECK(string_ref_count(ref) == ((output == ref) ? 2 : 1));
+
+    string_ref_release(output);
+}
+
+static void string__fuzz_search(char *str, char *substr, unsigned int amount)
+{
+    size_t length = strlen(str);
+    size_t length_sub = strlen(substr);
+
+    size_t first = string__fuzz_find(str, length, substr, length_sub, 0, false);
+    size_t first_ci = string__fuzz_find(str, length, substr, length_sub, 0, true);
+
+    STRING__FUZZ_CHECK(string_find(str, substr) == ((first == (size_t)-1 || length == 0) ? -1 : (int)first));
+    STRING__FUZZ_CHECK(string_contains(str, substr) == (first != (size_t)-1));
+    STRING__FUZZ_CHECK(string_starts_with(str, substr) == (length_sub <= length && memcmp(str, substr, length_sub) == 0));
+    STRING__FUZZ_CHECK(string_ends_with(str, substr) == (length_sub <= length && memcmp(str + length - length_sub, substr, length_sub) == 0));
+
+    unsigned int nth = amount % 4 + 1;
+    size_t pos = (size_t)-1;
+
+    for (unsigned int i = 0, from = 0; i < nth; ++i)
+    {
+        pos = string__fuzz_find(str, length, substr, length_sub, from, false);
+        if (pos == (size_t)-1) {break;}
+        from = (unsigned int)pos + 1;
+    }
+
+    if (length > 0 || length_sub == 0) {STRING__FUZZ_CHECK(string_find_nth(str, substr, nth) == ((pos == (size_t)-1) ? -1 : (int)pos));}
+
+    if (length_sub > 0 && length >= length_sub)
+    {
+        STRING__FUZZ_CHECK(string_count(str, substr) == string__fuzz_count(str, substr, false, false));
+        STRING__FUZZ_CHECK(string_count_overlap(str, substr) == string__fuzz_count(str, substr, true, false));
+
+        unsigned int streak = 0;
+        for (size_t at = first; at != (size_t)-1 && at + length_sub <= length && memcmp(str + at, substr, length_sub) == 0; at += length_sub) {++streak;}
+
+        STRING__FUZZ_CHECK(string_streak(str, substr) == streak);
+    }
+
+    if (length_sub > 0)
+    {
+        STRING__FUZZ_CHECK(string_find_ci(str, substr) == ((first_ci == (size_t)-1) ? -1 : (int)first_ci));
+        STRING__FUZZ_CHECK(string_contains_ci(str, substr) == (first_ci != (size_t)-1));
+        STRING__FUZZ_CHECK(string_count_ci(str, substr) == string__fuzz_count(str, substr, false, true));
+    }
+
+    bool starts_ci = (length_sub <= length);
+    bool ends_ci = (length_sub <= length);
+
+    for (size_t i = 0; i < length_sub && length_sub <= length; ++i)
+    {
+        if (string__fuzz_fold(str[i]) != string__fuzz_fold(substr[i])) {starts_ci = false;}
+        if (string__fuzz_fold(str[length - length_sub + i]) != string__fuzz_fold(substr[i])) {ends_ci = false;}
+    }
+
+    STRING__FUZZ_CHECK(string_starts_with_ci(str, substr) == starts_ci);
+    STRING__FUZZ_CHECK(string_ends_with_ci(str, substr) == ends_ci);
+
+    if (length_sub > 0 && length > 0)
+    {
+        StringIndex index = string_index_build(str, length);
+
+        STRING__FUZZ_CHECK(string_index_find(&index, substr) == ((first == (size_t)-1) ? -1 : (int)first));
+        STRING__FUZZ_CHECK(string_index_count(&index, substr) == string__fuzz_count(str, substr, true, false));
+
+        for (unsigned int nth = amount % 4 + 1; nth > 0; --nth)
+        {
+            STRING__FUZZ_CHECK(string_index_find_nth(&index, substr, nth) == string_find_nth(str, substr, nth));
+        }
+
+        string_index_free(&index);
+    }
+
+    if (length <= 256 && length_sub <= 256)
+    {
+        STRING__FUZZ_CHECK(string_edit_distance(str, substr) == string__fuzz_edit_distance(str, substr));
+    }
+}
+
+static void string__fuzz_slicing(char *str, unsigned int a, unsigned int b)
+{
+    size_t length = strlen(str);
+    char *output;
+
+    output = string_slice(str, a, b);
+    if (a <= b && b < length) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + a, b - a + 1));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    StringSpan span = string_span_slice(str, a, b);
+    if (a <= b && b < length) {STRING__FUZZ_CHECK(string__fuzz_span_equal(span, str + a, b - a + 1));}
+    else {STRING__FUZZ_CHECK(span.data == NULL);}
+
+    output = string_span_copy(span);
+    STRING__FUZZ_CHECK(span.data ? (output && string_span_equals(span, output)) : output == NULL);
+    free(output);
+
+    span = string_span(str);
+    STRING__FUZZ_CHECK(span.data == str && span.length == length && string_span_equals(span, str));
+
+    span = string_span_cut_left(str, a);
+    if (a <= length) {STRING__FUZZ_CHECK(span.data == str + a && span.length == length - a);}
+    else {STRING__FUZZ_CHECK(span.data == NULL);}
+
+    span = string_span_cut_right(str, a);
+    if (a <= length) {STRING__FUZZ_CHECK(span.data == str && span.length == length - a);}
+    else {STRING__FUZZ_CHECK(span.data == NULL);}
+
+    output = string_cut_left(str, a);
+    if (a <= length) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + a, length - a));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    output = string_cut_right(str, a);
+    if (a <= length) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str, length - a));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    output = string_insert(str, "<>", a);
+    if (a <= length)
+    {
+        STRING__FUZZ_CHECK(output && strlen(output) == length + 2 && memcmp(output, str, a) == 0 && memcmp(output + a, "<>", 2) == 0 && strcmp(output + a + 2, str + a) == 0);
+    }
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    // Shifts and reversal, copying and in place
+    char *copy = malloc(length + 1);
+    size_t shift = length ? a % length : 0;
+
+    memcpy(copy, str, length + 1);
+
+    output = string_shift_left(str, a);
+    STRING__FUZZ_CHECK(output && strlen(output) == length && memcmp(output, str + shift, length - shift) == 0 && memcmp(output + length - shift, str, shift) == 0);
+    STRING__FUZZ_CHECK(strcmp(string_shift_left_in_place(copy, a), output) == 0);
+    STRING__FUZZ_CHECK(strcmp(string_shift_right_in_place(copy, a), str) == 0);
+    string__fuzz_release(output, str);
+
+    output = string_shift_right(str, a);
+    STRING__FUZZ_CHECK(output && strlen(output) == length && memcmp(output, str + length - shift, shift) == 0 && memcmp(output + shift, str, length - shift) == 0);
+    string__fuzz_release(output, str);
+
+    // Refcounted strings, against the plain functions
+    char *ref = string_ref_new(str);
+
+    output = string_shift_left(str, a);
+    string__fuzz_check_ref(ref, string_ref_shift_left(ref, a), output);
+    string__fuzz_release(output, str);
+
+    output = string_shift_right(str, a);
+    string__fuzz_check_ref(ref, string_ref_shift_right(ref, a), output);
+    string__fuzz_release(output, str);
+
+    output = string_upper(str);
+    string__fuzz_check_ref(ref, string_ref_upper(ref), output);
+    free(output);
+
+    output = string_lower(str);
+    string__fuzz_check_ref(ref, string_ref_lower(ref), output);
+    free(output);
+
+    string_ref_release(ref);
+
+    output = string_reverse(str);
+    STRING__FUZZ_CHECK(output && strlen(output) == length);
+    for (size_t i = 0; i < length; ++i) {STRING__FUZZ_CHECK(output[i] == str[length - 1 - i]);}
+    STRING__FUZZ_CHECK(strcmp(string_reverse_in_place(copy), output) == 0);
+    free(output);
+
+    // Case, against the C library
+    output = string_upper(str);
+    STRING__FUZZ_CHECK(output && strlen(output) == length);
+    for (size_t i = 0; i < length; ++i) {STRING__FUZZ_CHECK(output[i] == (char)toupper((unsigned char)str[i]));}
+    free(output);
+
+    output = string_lower(str);
+    STRING__FUZZ_CHECK(output && strlen(output) == length);
+    for (size_t i = 0; i < length; ++i) {STRING__FUZZ_CHECK(output[i] == (char)tolower((unsigned char)str[i]));}
+    free(output);
+
+    free(copy);
+}
+
+// Against the byte offsets of the codepoints, which start at every byte that is not a continuation byte (valid UTF-8 or not)
+static void string__fuzz_utf8(char *str, unsigned int a, unsigned int b)
+{
+    size_t length = strlen(str);
+    size_t *leads = malloc(sizeof(size_t) * (length + 1));
+    size_t count = 0;
+    char *output;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (((unsigned char)str[i] & 0xC0) != 0x80) {leads[count++] = i;}
+    }
+
+    leads[count] = length;
+
+    output = string_utf8_slice(str, a, b);
+    if (a <= b && a < count && b < count) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + leads[a], leads[b + 1] - leads[a]));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    output = string_utf8_cut_left(str, a);
+    if (a <= count) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + leads[a], length - leads[a]));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    output = string_utf8_cut_right(str, a);
+    if (a <= count) {STRING__FUZZ_CHECK(string__fuzz_equal(output, str, leads[count - a]));}
+    else {STRING__FUZZ_CHECK(output == NULL);}
+    free(output);
+
+    size_t shift = count ? a % count : 0;
+    size_t pos = shift ? leads[shift] : 0;
+
+    output = string_utf8_shift_left(str, a);
+    STRING__FUZZ_CHECK(output && strlen(output) == length && memcmp(output, str + pos, length - pos) == 0 && memcmp(output + length - pos, str, pos) == 0);
+    free(output);
+
+    pos = shift ? leads[count - shift] : 0;
+
+    output = string_utf8_shift_right(str, a);
+    STRING__FUZZ_CHECK(output && strlen(output) == length && memcmp(output, str + pos, length - pos) == 0 && memcmp(output + length - pos, str, pos) == 0);
+    free(output);
+
+    // Invalid UTF-8 has no codepoint order to reverse, so only its length is kept
+    size_t codepoints;
+    output = string_utf8_reverse(str);
+    STRING__FUZZ_CHECK(output && strlen(output) == length);
+
+    if (string__fuzz_utf8_valid((const unsigned char *)str, &codepoints))
+    {
+        for (size_t i = 0, at = 0; i < count; ++i)
+        {
+            size_t size = leads[count - i] - leads[count - 1 - i];
+
+            STRING__FUZZ_CHECK(memcmp(output + at, str + leads[count - 1 - i], size) == 0);
+            at += size;
+        }
+    }
+
+    free(output);
+    free(leads);
+}
+
+static void string__fuzz_editing(char *str, char *substr, char *replacement)
+{
+    size_t length = strlen(str);
+    size_t length_sub = strlen(substr);
+    size_t first = string__fuzz_find(str, length, substr, length_sub, 0, false);
+    char *output;
+    char *expected;
+
+    bool starts = (length_sub <= length && memcmp(str, substr, length_sub) == 0);
+    bool ends = (length_sub <= length && memcmp(str + length - length_sub, substr, length_sub) == 0);
+
+    // Refcounted strings, against the plain functions
+    char *ref = string_ref_new(str);
+
+    output = string_trim_left(str, substr);
+    STRING__FUZZ_CHECK(strcmp(output, str + (starts ? length_sub : 0)) == 0);
+    string__fuzz_check_ref(ref, string_ref_trim_left(ref, substr), output);
+
+    StringSpan span = string_span_trim_left(str, substr);
+    STRING__FUZZ_CHECK(span.data == str + (starts ? length_sub : 0) && span.length == length - (starts ? length_sub : 0));
+
+    output = string_trim_right(str, substr);
+    STRING__FUZZ_CHECK(string__fuzz_equal(output, str, length - (ends ? length_sub : 0)));
+    string__fuzz_check_ref(ref, string_ref_trim_right(ref, substr), output);
+    string__fuzz_release(output, str);
+
+    span = string_span_trim_right(str, substr);
+    STRING__FUZZ_CHECK(span.data == str && span.length == length - (ends ? length_sub : 0));
+
+    output = string_remove(str, substr);
+    if (first == (size_t)-1) {STRING__FUZZ_CHECK(output == str);}
+    else {STRING__FUZZ_CHECK(output && strlen(output) == length - length_sub && memcmp(output, str, first) == 0 && strcmp(output + first, str + first + length_sub) == 0);}
+    string__fuzz_check_ref(ref, string_ref_remove(ref, substr), output);
+    string__fuzz_release(output, str);
+
+    if (length_sub == 0)
+    {
+        string_ref_release(ref);
+        return;
+    }
+
+    expected = string__fuzz_replace(str, substr, "", (size_t)-1, false);
+    output = string_remove_all(str, substr);
+    STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);
+    string__fuzz_check_ref(ref, string_ref_remove_all(ref, substr), output);
+    string__fuzz_release(output, str);
+    free(expected);
+
+    // The legacy replacers give NULL for an empty <str> or one shorter than <substr>
+    bool replaceable = (length >= length_sub);
+
+    expected = string__fuzz_replace(str, substr, replacement, 1, false);
+    output = string_replace(str, substr, replacement);
+    STRING__FUZZ_CHECK(replaceable ? (output && strcmp(output, expected) == 0) : output == NULL);
+    string__fuzz_check_ref(ref, string_ref_replace(ref, substr, replacement), expected);
+    string__fuzz_release(output, str);
+    free(expected);
+
+    expected = string__fuzz_replace(str, substr, replacement, (size_t)-1, false);
+    output = string_replace_all(str, substr, replacement);
+    STRING__FUZZ_CHECK(replaceable ? (output && strcmp(output, expected) == 0) : output == NULL);
+    string__fuzz_release(output, str);
+
+    // Engines that must agree with string_replace_all()
+    string__fuzz_check_ref(ref, string_ref_replace_all(ref, substr, replacement), expected);
+    string_ref_release(ref);
+
+    StringPipeline *pipeline = string_pipeline_upper(string_pipeline_replace_all(string_pipeline_create(), substr, replacement));
+    char *upper = string_upper(expected);
+    output = string_pipeline_run(pipeline, str);
+    STRING__FUZZ_CHECK(output && strcmp(output, upper) == 0);
+    free(output);
+    free(upper);
+    string_pipeline_free(pipeline);
+
+    free(expected);
+
+    expected = string__fuzz_replace(str, substr, replacement, (size_t)-1, true);
+    output = string_replace_all_ci(str, substr, replacement);
+    STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);
+    free(output);
+    free(expected);
+
+    // Getting, copied and as spans
+    output = string_before(str, substr);
+    if (first == (size_t)-1) {STRING__FUZZ_CHECK(output == NULL);}
+    else {STRING__FUZZ_CHECK(string__fuzz_equal(output, str, first));}
+    free(output);
+
+    span = string_span_before(str, substr);
+    if (first == (size_t)-1) {STRING__FUZZ_CHECK(span.data == NULL);}
+    else {STRING__FUZZ_CHECK(span.data == str && span.length == first);}
+
+    output = string_after(str, substr);
+    if (first == (size_t)-1) {STRING__FUZZ_CHECK(output == NULL);}
+    else {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + first + length_sub, length - first - length_sub));}
+    free(output);
+
+    span = string_span_after(str, substr);
+    if (first == (size_t)-1) {STRING__FUZZ_CHECK(span.data == NULL);}
+    else {STRING__FUZZ_CHECK(span.data == str + first + length_sub && span.length == length - first - length_sub);}
+
+    size_t length_rep = strlen(replacement);
+    size_t close = (first == (size_t)-1) ? (size_t)-1 : string__fuzz_find(str, length, replacement, length_rep, first + length_sub, false);
+
+    output = string_between(str, substr, replacement);
+    if (close == (size_t)-1) {STRING__FUZZ_CHECK(output == NULL);}
+    else {STRING__FUZZ_CHECK(string__fuzz_equal(output, str + first + length_sub, close - first - length_sub));}
+    free(output);
+
+    span = string_span_between(str, substr, replacement);
+    if (close == (size_t)-1) {STRING__FUZZ_CHECK(span.data == NULL);}
+    else {STRING__FUZZ_CHECK(span.data == str + first + length_sub && span.length == close - first - length_sub);}
+}
+
+// Every string of <column> against <expected>, which is freed
+static void string__fuzz_check_column(StringColumn column, char **expected, size_t count)
+{
+    STRING__FUZZ_CHECK(column.data && column.count == count && column.offsets[0] == 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t length = strlen(expected[i]);
+
+        STRING__FUZZ_CHECK(column.offsets[i + 1] - column.offsets[i] == length && memcmp(column.data + column.offsets[i], expected[i], length) == 0);
+        free(expected[i]);
+    }
+}
+
+// Against the plain function on each string
+static void string__fuzz_columns(char *str, char *substr, char *replacement)
+{
+    char *strings[3] = {str, substr, replacement};
+    char *expected[3];
+    StringColumn column = string_column_from_array(strings, 3);
+    StringColumn output;
+
+    for (size_t i = 0; i < 3; ++i) {expected[i] = string__fuzz_copy(strings[i]);}
+    string__fuzz_check_column(column, expected, 3);
+
+    for (size_t i = 0; i < 3; ++i) {expected[i] = string_upper(strings[i]);}
+    output = string_column_upper(column);
+    string__fuzz_check_column(output, expected, 3);
+    string_column_free(&output);
+
+    for (size_t i = 0; i < 3; ++i) {expected[i] = string_lower(strings[i]);}
+    output = string_column_lower(column);
+    string__fuzz_check_column(output, expected, 3);
+    string_column_free(&output);
+
+    for (size_t i = 0; i < 3; ++i) {expected[i] = string__fuzz_copy(string_trim_left(strings[i], substr));}
+    output = string_column_trim_left(column, substr);
+    string__fuzz_check_column(output, expected, 3);
+    string_column_free(&output);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        char *trimmed = string_trim_right(strings[i], substr);
+        expected[i] = string__fuzz_copy(trimmed);
+        string__fuzz_release(trimmed, strings[i]);
+    }
+
+    output = string_column_trim_right(column, substr);
+    string__fuzz_check_column(output, expected, 3);
+    string_column_free(&output);
+
+    if (*substr != '\0')
+    {
+        for (size_t i = 0; i < 3; ++i) {expected[i] = string__fuzz_replace(strings[i], substr, replacement, (size_t)-1, false);}
+        output = string_column_replace_all(column, substr, replacement);
+        string__fuzz_check_column(output, expected, 3);
+        string_column_free(&output);
+
+        for (size_t i = 0; i < 3; ++i) {expected[i] = string__fuzz_replace(strings[i], substr, "", (size_t)-1, false);}
+        output = string_column_remove_all(column, substr);
+        string__fuzz_check_column(output, expected, 3);
+        string_column_free(&output);
+    }
+
+    string_column_free(&column);
+}
+
+// Up to three stages picked by <stages>, against their plain functions called one after the other,
+// with the input fed whole, in pieces and from a file
+static void string__fuzz_pipelines(char *str, char *substr, char *replacement, unsigned int stages)
+{
+    StringPipeline *pipeline = string_pipeline_create();
+    char *expected = string__fuzz_copy(str);
+    size_t length = strlen(str);
+
+    for (unsigned int count = stages % 4, i = 0; i < count; ++i)
+    {
+        unsigned int kind = (stages >> (2 + 3 * i)) % 6;
+        char *next;
+
+        // Replacing "" is a stage that does nothing, but not a plain function that does
+        if (kind >= 4 && *substr == '\0') {kind -= 2;}
+
+        switch (kind)
+        {
+            case 0:
+            {
+                pipeline = string_pipeline_trim_left(pipeline, substr);
+                next = string__fuzz_copy(string_trim_left(expected, substr));
+            } break;
+
+            case 1:
+            {
+                pipeline = string_pipeline_trim_right(pipeline, substr);
+                char *trimmed = string_trim_right(expected, substr);
+                next = string__fuzz_copy(trimmed);
+                string__fuzz_release(trimmed, expected);
+            } break;
+
+            case 2:
+            {
+                pipeline = string_pipeline_upper(pipeline);
+                next = string_upper(expected);
+            } break;
+
+            case 3:
+            {
+                pipeline = string_pipeline_lower(pipeline);
+                next = string_lower(expected);
+            } break;
+
+            case 4:
+            {
+                pipeline = string_pipeline_replace_all(pipeline, substr, replacement);
+                next = string__fuzz_replace(expected, substr, replacement, (size_t)-1, false);
+            } break;
+
+            default:
+            {
+                pipeline = string_pipeline_remove_all(pipeline, substr);
+                next = string__fuzz_replace(expected, substr, "", (size_t)-1, false);
+            } break;
+        }
+
+        free(expected);
+        expected = next;
+    }
+
+    char *output = string_pipeline_run(pipeline, str);
+    STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);
+    free(output);
+
+    // Pieces of 1 to 4 bytes, so that matches and trims straddle them
+    string__pipeline_run run;
+    string__pipeline_run_init(&run, pipeline);
+
+    string__builder pieces = {NULL, 0, 0};
+    string__builder_reserve(&pieces, length);
+
+    size_t pos = 0;
+
+    do
+    {
+        size_t piece = (stages >> (pos % 8)) % 4 + 1;
+        if (piece > length - pos) {piece = length - pos;}
+
+        string__pipeline_feed(&run, str + pos, piece, pos + piece == length, &pieces);
+        pos += piece;
+    }
+    while (pos < length);
+
+    string__pipeline_run_free(&run);
+
+    pieces.data[pieces.length] = '\0';
+    STRING__FUZZ_CHECK(pieces.length == strlen(expected) && strcmp(pieces.data, expected) == 0);
+    free(pieces.data);
+
+#if !defined(_WIN32)
+    // The file is rewritten in place, through a temporary one next to it; one input in eight, as
+    // the trip through the file system costs more than all the other checks together
+    char path[] = "/tmp/zstring-fuzz-XXXXXX";
+    int descriptor = (stages >> 13 == 0) ? mkstemp(path) : -1;
+    FILE *file = (descriptor >= 0) ? fdopen(descriptor, "wb") : NULL;
+
+    if (file)
+    {
+        fwrite(str, 1, length, file);
+        fclose(file);
+
+        char *paths[1] = {path};
+        StringBatchWorker workers[2];
+        unsigned int threads = stages % 2 + 1;
+
+        STRING__FUZZ_CHECK(string_pipeline_run_files(pipeline, paths, NULL, 1, threads, workers) == 1);
+
+        size_t bytes_read = 0;
+        size_t bytes_written = 0;
+
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+            bytes_read += workers[t].bytes_read;
+            bytes_written += workers[t].bytes_written;
+        }
+
+        STRING__FUZZ_CHECK(bytes_read == length && bytes_written == strlen(expected));
+
+        file = fopen(path, "rb");
+        STRING__FUZZ_CHECK(file != NULL);
+
+        char *written = malloc(length * 4 + strlen(expected) + 1);
+        size_t length_written = fread(written, 1, length * 4 + strlen(expected), file);
+        fclose(file);
+
+        STRING__FUZZ_CHECK(length_written == strlen(expected) && memcmp(written, expected, length_written) == 0);
+        free(written);
+    }
+    else if (descriptor >= 0) {close(descriptor);}
+
+    if (descriptor >= 0) {remove(path);}
+#endif
+
+    string_pipeline_free(pipeline);
+    free(expected);
+}
+
+static void string__fuzz_splitting(char *str, char *delimiter)
+{
+    size_t length = strlen(str);
+    StringSpan *fields = malloc(sizeof(StringSpan) * (length + 2));
+    size_t count;
+    char **output;
+
+    if (*delimiter == '\0') {free(fields); return;}
+
+    count = string__fuzz_fields(str, delimiter, 0, true, fields);
+    output = string_split(str, delimiter);
+    if (count == 0) {STRING__FUZZ_CHECK(output == NULL);}
+    else
+    {
+        string__fuzz_check_fields(output, fields, count);
+        free(output[0]);
+    }
+    free(output);
+
+    for (int skip_empty = 0; skip_empty <= 1; ++skip_empty)
+    {
+        count = string__fuzz_fields(str, delimiter, 0, skip_empty, fields);
+        output = string_split_any(str, delimiter, skip_empty);
+        string__fuzz_check_fields(output, fields, count);
+        free(output);
+    }
+
+    count = string__fuzz_fields(str, delimiter, 1, false, fields);
+    output = string_split_substr(str, delimiter);
+    string__fuzz_check_fields(output, fields, count);
+    free(output);
+
+    count = string__fuzz_fields(str, delimiter, 2, false, fields);
+    output = string_split_substr_ci(str, delimiter);
+    string__fuzz_check_fields(output, fields, count);
+    free(output);
+
+    free(fields);
+}
+
+// The escapes string_escape() documents, one byte at a time
+static char *string__fuzz_escape(const char *str, StringEscape kind)
+{
+    size_t length = strlen(str);
+    char *output = malloc(length * 6 + 1);
+    char *ptr = output;
+
+    for (const unsigned char *c = (const unsigned char *)str; *c; ++c)
+    {
+        const char *named = NULL;
+
+        if (kind == STRING_ESCAPE_JSON || kind == STRING_ESCAPE_C)
+        {
+            switch (*c)
+            {
+                case '"':  named = "\\\""; break;
+                case '\\': named = "\\\\"; break;
+                case '\b': named = "\\b"; break;
+                case '\f': named = "\\f"; break;
+                case '\n': named = "\\n"; break;
+                case '\r': named = "\\r"; break;
+                case '\t': named = "\\t"; break;
+                case '\a': named = (kind == STRING_ESCAPE_C) ? "\\a" : NULL; break;
+                case '\v': named = (kind == STRING_ESCAPE_C) ? "\\v" : NULL; break;
+            }
+
+            if (named) {ptr += sprintf(ptr, "%s", named);}
+            else if (kind == STRING_ESCAPE_JSON && *c < 0x20) {ptr += sprintf(ptr, "\\u%04x", *c);}
+            else if (kind == STRING_ESCAPE_C && (*c < 0x20 || *c >= 0x7F)) {ptr += sprintf(ptr, "\\%03o", *c);}
+            else {*ptr++ = (char)*c;}
+        }
+        else if (kind == STRING_ESCAPE_HTML)
+        {
+            switch (*c)
+            {
+                case '&':  named = "&amp;"; break;
+                case '<':  named = "&lt;"; break;
+                case '>':  named = "&gt;"; break;
+                case '"':  named = "&quot;"; break;
+                case '\'': named = "&#39;"; break;
+            }
+
+            if (named) {ptr += sprintf(ptr, "%s", named);}
+            else {*ptr++ = (char)*c;}
+        }
+        else
+        {
+            if (isalnum(*c) || strchr("-._~", *c)) {*ptr++ = (char)*c;}
+            else {ptr += sprintf(ptr, "%%%02X", *c);}
+        }
+    }
+
+    *ptr = '\0';
+    return output;
+}
+
+static void string__fuzz_encoding(char *str)
+{
+    size_t codepoints;
+    bool valid = string__fuzz_utf8_valid((const unsigned char *)str, &codepoints);
+
+    STRING__FUZZ_CHECK(string_utf8_valid(str) == valid);
+    if (valid) {STRING__FUZZ_CHECK(string_utf8_length(str) == codepoints);}
+
+    StringEscape kinds[4] = {STRING_ESCAPE_JSON, STRING_ESCAPE_HTML, STRING_ESCAPE_URL, STRING_ESCAPE_C};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        char *escaped = string_escape(str, kinds[i]);
+        char *expected = string__fuzz_escape(str, kinds[i]);
+        char *unescaped = string_unescape(escaped, kinds[i]);
+
+        STRING__FUZZ_CHECK(escaped && strcmp(escaped, expected) == 0);
+        STRING__FUZZ_CHECK(unescaped && strcmp(unescaped, str) == 0);
+
+        free(unescaped);
+        free(expected);
+        free(escaped);
+    }
+}
+
+static void string__fuzz_buffers(char *buffer, size_t length, char *substr, char *replacement, unsigned int amount)
+{
+    size_t length_sub = strlen(substr);
+    size_t first = string__fuzz_find(buffer, length, substr, length_sub, 0, false);
+
+    STRING__FUZZ_CHECK(string_buffer_find(buffer, length, substr) == ((first == (size_t)-1) ? -1 : (ptrdiff_t)first));
+
+    size_t nth = amount % 4 + 1;
+    size_t pos = (size_t)-1;
+
+    for (size_t i = 0, from = 0; i < nth; ++i)
+    {
+        pos = string__fuzz_find(buffer, length, substr, length_sub, from, false);
+        if (pos == (size_t)-1) {break;}
+        from = pos + 1;
+    }
+
+    STRING__FUZZ_CHECK(string_buffer_find_nth(buffer, length, substr, nth) == ((pos == (size_t)-1) ? -1 : (ptrdiff_t)pos));
+
+    if (length_sub == 0) {return;}
+
+    size_t count = 0;
+    size_t count_overlap = 0;
+
+    for (size_t at = 0; (at = string__fuzz_find(buffer, length, substr, length_sub, at, false)) != (size_t)-1; at += length_sub) {++count;}
+    for (size_t at = 0; (at = string__fuzz_find(buffer, length, substr, length_sub, at, false)) != (size_t)-1; at += 1) {++count_overlap;}
+
+    STRING__FUZZ_CHECK(string_buffer_count(buffer, length, substr) == count);
+    STRING__FUZZ_CHECK(string_buffer_count_overlap(buffer, length, substr) == count_overlap);
+
+    // Reference replacement over a buffer that may hold NULs
+    size_t length_rep = strlen(replacement);
+    size_t length_expected = length - count * length_sub + count * length_rep;
+    size_t length_output = 0;
+    char *output = string_buffer_replace_all(buffer, length, substr, replacement, &length_output);
+
+    STRING__FUZZ_CHECK(output && length_output == length_expected && output[length_output] == '\0');
+
+    size_t at = 0;
+    size_t pos_out = 0;
+    size_t match;
+
+    while ((match = string__fuzz_find(buffer, length, substr, length_sub, at, false)) != (size_t)-1)
+    {
+        STRING__FUZZ_CHECK(memcmp(output + pos_out, buffer + at, match - at) == 0);
+        pos_out += match - at;
+
+        STRING__FUZZ_CHECK(memcmp(output + pos_out, replacement, length_rep) == 0);
+        pos_out += length_rep;
+
+        at = match + length_sub;
+    }
+
+    STRING__FUZZ_CHECK(memcmp(output + pos_out, buffer + at, length - at) == 0);
+    free(output);
+
+    size_t length_removed = 0;
+    char *removed = string_buffer_remove_all(buffer, length, substr, &length_removed);
+    char *replaced = string_buffer_replace_all(buffer, length, substr, "", &length_output);
+
+    STRING__FUZZ_CHECK(removed && replaced && length_removed == length_output && memcmp(removed, replaced, length_removed + 1) == 0);
+    free(replaced);
+    free(removed);
+
+    output = string_buffer_reverse(buffer, length);
+    for (size_t i = 0; i < length; ++i) {STRING__FUZZ_CHECK(output[i] == buffer[length - 1 - i]);}
+    free(output);
+}
+
+// Bytes of a fuzz input handed out one at a time, wrapping around (all zeros if there are none)
+typedef struct string__fuzz_source
+{
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+} string__fuzz_source;
+
+static unsigned int string__fuzz_next(string__fuzz_source *source)
+{
+    return source->size ? source->data[source->pos++ % source->size] : 0;
+}
+
+// <str> with every byte replaced by one of <alphabet>, so the input reads as the syntax under test
+static char *string__fuzz_map(const char *str, const char *alphabet)
+{
+    size_t length = strlen(str);
+    size_t length_alphabet = strlen(alphabet);
+    char *output = malloc(length + 1);
+
+    for (size_t i = 0; i < length; ++i) {output[i] = alphabet[(unsigned char)str[i] % length_alphabet];}
+    output[length] = '\0';
+
+    return output;
+}
+
+// Significant digits of a number written by string_write_double() ("0" has one)
+static int string__fuzz_digits(const char *number)
+{
+    const char *first = NULL;
+    const char *last = NULL;
+
+    for (const char *ptr = number; *ptr && *ptr != 'e' && *ptr != 'E'; ++ptr)
+    {
+        if (*ptr < '1' || *ptr > '9') {continue;}
+
+        if (!first) {first = ptr;}
+        last = ptr;
+    }
+
+    if (!first) {return 1;}
+
+    int digits = 0;
+    for (const char *ptr = first; ptr <= last; ++ptr) {digits += (*ptr >= '0' && *ptr <= '9');}
+
+    return digits;
+}
+
+static void string__fuzz_numbers(const uint8_t *data, size_t size)
+{
+    // Any 8 bytes are a double, NaNs and subnormals included
+    uint64_t bits = 0;
+    memcpy(&bits, data, size < sizeof(bits) ? size : sizeof(bits));
+
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+
+    char buffer[32];
+    char expected[64];
+
+    unsigned int length = string_write_double(buffer, value);
+    STRING__FUZZ_CHECK(length > 0 && length < sizeof(buffer) && strlen(buffer) == length);
+
+    char *output = string_from_double(value);
+    STRING__FUZZ_CHECK(output && strcmp(output, buffer) == 0);
+    free(output);
+
+    double back = strtod(buffer, NULL);
+    double parsed = 0;
+
+    STRING__FUZZ_CHECK(string_parse_f64(buffer, length, &parsed) == length);
+
+    if (isnan(value)) {STRING__FUZZ_CHECK(isnan(back) && isnan(parsed));}
+    else
+    {
+        STRING__FUZZ_CHECK(memcmp(&back, &value, sizeof(value)) == 0 && memcmp(&parsed, &value, sizeof(value)) == 0);
+
+        // Shortest: as many digits as the fewest that snprintf() (correctly rounded) needs to read back
+        if (isfinite(value))
+        {
+            int shortest = 17;
+
+            for (int precision = 1; precision < 17; ++precision)
+            {
+                snprintf(expected, sizeof(expected), "%.*e", precision - 1, value);
+                if (strtod(expected, NULL) == value) {shortest = precision; break;}
+            }
+
+            STRING__FUZZ_CHECK(string__fuzz_digits(buffer) == shortest);
+        }
+    }
+
+    long long integer = (long long)bits;
+
+    snprintf(expected, sizeof(expected), "%lld", integer);
+    STRING__FUZZ_CHECK(string_write_int(buffer, integer) == strlen(expected) && strcmp(buffer, expected) == 0);
+
+    output = string_from_int(integer);
+    STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);
+    free(output);
+
+    snprintf(expected, sizeof(expected), "%llu", (unsigned long long)bits);
+    STRING__FUZZ_CHECK(string_write_uint(buffer, (unsigned long long)bits) == strlen(expected) && strcmp(buffer, expected) == 0);
+}
+
+// Against strtoll(), strtoull() and strtod() in the C locale, on text made of number characters
+static void string__fuzz_parsing(char *str)
+{
+    char *text = string__fuzz_map(str, "0123456789012345.eE+-xinfatyINF");
+    size_t length = strlen(text);
+    char *end;
+
+    errno = 0;
+    long long expected_i64 = strtoll(text, &end, 10);
+    size_t length_i64 = (errno == 0) ? (size_t)(end - text) : 0;
+    int64_t value_i64 = 0;
+
+    STRING__FUZZ_CHECK(string_parse_i64(text, length, &value_i64) == length_i64);
+    if (length_i64) {STRING__FUZZ_CHECK(value_i64 == expected_i64);}
+
+    // strtoull() also takes a '-' and negates, which string_parse_u64() does not
+    errno = 0;
+    unsigned long long expected_u64 = strtoull(text, &end, 10);
+    size_t length_u64 = (errno == 0 && text[0] != '-') ? (size_t)(end - text) : 0;
+    uint64_t value_u64 = 0;
+
+    STRING__FUZZ_CHECK(string_parse_u64(text, length, &value_u64) == length_u64);
+    if (length_u64) {STRING__FUZZ_CHECK(value_u64 == expected_u64);}
+
+    // strtod() also reads hex floats, which string_parse_f64() stops at after the "0"
+    double expected_f64 = strtod(text, &end);
+    size_t length_f64 = (size_t)(end - text);
+    double value_f64 = 0;
+
+    if (!memchr(text, 'x', length_f64))
+    {
+        STRING__FUZZ_CHECK(string_parse_f64(text, length, &value_f64) == length_f64);
+
+        if (length_f64 && isnan(expected_f64)) {STRING__FUZZ_CHECK(isnan(value_f64));}
+        else if (length_f64) {STRING__FUZZ_CHECK(memcmp(&value_f64, &expected_f64, sizeof(double)) == 0);}
+    }
+
+    // Only the <length> bytes given may be read
+    if (length > 0)
+    {
+        char *part = malloc(length / 2 + 1);
+        memcpy(part, text, length / 2);
+
+        size_t length_part = string_parse_f64(part, length / 2, &value_f64);
+        STRING__FUZZ_CHECK(length_part <= length / 2);
+
+        free(part);
+    }
+
+    free(text);
+}
+
+// Against snprintf(), on one conversion built from the input
+// string_vformat() with the va_list of a call, as wrappers of it pass one on
+static char *string__fuzz_vformat(char *str, ...)
+{
+    va_list args;
+    va_start(args, str);
+
+    char *output = string_vformat(str, args);
+
+    va_end(args);
+
+    return output;
+}
+
+static void string__fuzz_format(const uint8_t *data, size_t size, char *str)
+{
+    string__fuzz_source source = {data, size, 0};
+    char expected[1024];
+    char spec[64];
+
+    static const char conversions[] = "diuxXocs%feEgGaA";
+    static const char *const lengths[] = {"", "", "hh", "h", "l", "ll", "z", "j"};
+
+    for (int round = 0; round < 4; ++round)
+    {
+        char conversion = conversions[string__fuzz_next(&source) % (sizeof(conversions) - 1)];
+        bool integer = strchr("diuxXo", conversion) != NULL;
+        bool floating = strchr("feEgGaA", conversion) != NULL;
+        unsigned int flags = string__fuzz_next(&source);
+        bool stars = string__fuzz_next(&source) & 1;
+        int width = (int)(string__fuzz_next(&source) % 40) - 8;
+        int precision = (int)(string__fuzz_next(&source) % 40) - 8;
+
+        // Only the flags that are defined for <conversion>, none for "%%"
+        size_t length_spec = 0;
+        spec[length_spec++] = 'a';
+        spec[length_spec++] = '%';
+
+        if (conversion == '%') {flags = 0;}
+
+        if (flags & 1)                                          {spec[length_spec++] = '-';}
+        if ((flags & 2) && (conversion == 'd' || conversion == 'i' || floating)) {spec[length_spec++] = '+';}
+        if ((flags & 4) && (conversion == 'd' || conversion == 'i' || floating)) {spec[length_spec++] = ' ';}
+        if ((flags & 8) && (strchr("xXo", conversion) || floating)) {spec[length_spec++] = '#';}
+        if ((flags & 16) && (integer || floating))              {spec[length_spec++] = '0';}
+
+        if (conversion != '%')
+        {
+            if (stars) {spec[length_spec++] = '*';}
+            else if (width > 0) {length_spec += (size_t)sprintf(spec + length_spec, "%d", width);}
+
+            if (conversion != 'c')
+            {
+                if (stars) {memcpy(spec + length_spec, ".*", 2); length_spec += 2;}
+                else if (precision >= 0) {length_spec += (size_t)sprintf(spec + length_spec, ".%d", precision);}
+            }
+        }
+
+        const char *length_modifier = integer ? lengths[string__fuzz_next(&source) % 8] : "";
+        length_spec += (size_t)sprintf(spec + length_spec, "%s%cb", length_modifier, conversion);
+
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {bits = (bits << 8) | string__fuzz_next(&source);}
+
+        double real;
+        memcpy(&real, &bits, sizeof(real));
+
+        // A call of both with the same arguments, the star ones first
+        #define STRING__FUZZ_FORMAT(value)                                                                      \
+            do                                                                                                  \
+            {                                                                                                   \
+                char *output;                                                                                   \
+                char *output_va;                                                                                \
+                int length_expected;                                                                            \
+                if (stars && conversion == 'c')                                                                 \
+                {                                                                                               \
+                    output = string_format(spec, width, value);                                                 \
+                    output_va = string__fuzz_vformat(spec, width, value);                                       \
+                    length_expected = snprintf(expected, sizeof(expected), spec, width, value);                 \
+                }                                                                                               \
+                else if (stars)                                                                                 \
+                {                                                                                               \
+                    output = string_format(spec, width, precision, value);                                      \
+                    output_va = string__fuzz_vformat(spec, width, precision, value);                            \
+                    length_expected = snprintf(expected, sizeof(expected), spec, width, precision, value);      \
+                }                                                                                               \
+                else                                                                                            \
+                {                                                                                               \
+                    output = string_format(spec, value);                                                        \
+                    output_va = string__fuzz_vformat(spec, value);                                              \
+                    length_expected = snprintf(expected, sizeof(expected), spec, value);                        \
+                }                                                                                               \
+                if (length_expected >= 0 && (size_t)length_expected < sizeof(expected))                         \
+                {                                                                                               \
+                    STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);                                \
+                }                                                                                               \
+                STRING__FUZZ_CHECK((output == NULL) == (output_va == NULL));                                    \
+                STRING__FUZZ_CHECK(output == NULL || strcmp(output, output_va) == 0);                           \
+                free(output_va);                                                                                \
+                free(output);                                                                                   \
+            } while (0)
+
+        if (conversion == 's' || conversion == '%') {STRING__FUZZ_FORMAT(str);}
+        else if (conversion == 'c') {STRING__FUZZ_FORMAT((int)(bits & 0xFF));}
+        else if (floating) {STRING__FUZZ_FORMAT(real);}
+        else if (conversion == 'd' || conversion == 'i')
+        {
+            if      (!strcmp(length_modifier, "l"))  {STRING__FUZZ_FORMAT((long)bits);}
+            else if (!strcmp(length_modifier, "ll")) {STRING__FUZZ_FORMAT((long long)bits);}
+            else if (!strcmp(length_modifier, "z"))  {STRING__FUZZ_FORMAT((ptrdiff_t)bits);}
+            else if (!strcmp(length_modifier, "j"))  {STRING__FUZZ_FORMAT((intmax_t)bits);}
+            else                                     {STRING__FUZZ_FORMAT((int)bits);}
+        }
+        else
+        {
+            if      (!strcmp(length_modifier, "l"))  {STRING__FUZZ_FORMAT((unsigned long)bits);}
+            else if (!strcmp(length_modifier, "ll")) {STRING__FUZZ_FORMAT((unsigned long long)bits);}
+            else if (!strcmp(length_modifier, "z"))  {STRING__FUZZ_FORMAT((size_t)bits);}
+            else if (!strcmp(length_modifier, "j"))  {STRING__FUZZ_FORMAT((uintmax_t)bits);}
+            else                                     {STRING__FUZZ_FORMAT((unsigned int)bits);}
+        }
+
+        #undef STRING__FUZZ_FORMAT
+    }
+}
+
+#if !defined(_WIN32)
+
+// Appends to <output> a regex that POSIX ERE and ZString both define, nested at most <depth> deep
+static void string__fuzz_regex(string__fuzz_source *source, char *output, size_t *length, int depth)
+{
+    static const char *const atoms[] = {"a", "b", "c", ".", "[ab]", "[^a]", "[a-c]", "\\."};
+
+    unsigned int branches = (string__fuzz_next(source) % 4 == 0) ? 2 : 1;
+
+    for (unsigned int branch = 0; branch < branches; ++branch)
+    {
+        if (branch > 0) {output[(*length)++] = '|';}
+
+        unsigned int pieces = string__fuzz_next(source) % 3 + 1;
+
+        for (unsigned int piece = 0; piece < pieces; ++piece)
+        {
+            unsigned int choice = string__fuzz_next(source);
+
+            if (depth > 0 && choice % 5 == 0)
+            {
+                output[(*length)++] = '(';
+                string__fuzz_regex(source, output, length, depth - 1);
+                output[(*length)++] = ')';
+            }
+            else
+            {
+                const char *atom = atoms[(choice >> 3) % 8];
+                memcpy(output + *length, atom, strlen(atom));
+                *length += strlen(atom);
+            }
+
+            unsigned int quantifier = string__fuzz_next(source) % 6;
+            if (quantifier < 3) {output[(*length)++] = "*+?"[quantifier];}
+        }
+    }
+}
+
+// Against regexec() (leftmost-longest, like ZString) and fnmatch()
+static void string__fuzz_patterns(const uint8_t *data, size_t size, char *str, char *substr)
+{
+    string__fuzz_source source = {data, size, 0};
+    char *text = string__fuzz_map(str, "abcab.\n");
+    size_t length_text = strlen(text);
+
+    // Regexes, in parentheses so that an anchor applies to all of them in both syntaxes
+    char regex[2048];
+    size_t length = 0;
+    bool anchor_start = string__fuzz_next(&source) % 4 == 0;
+    bool anchor_end = string__fuzz_next(&source) % 4 == 0;
+
+    if (anchor_start) {regex[length++] = '^';}
+    regex[length++] = '(';
+    string__fuzz_regex(&source, regex, &length, 2);
+    regex[length++] = ')';
+    if (anchor_end) {regex[length++] = '$';}
+    regex[length] = '\0';
+
+    // The same regex anchored at both ends, for a whole-string match
+    char whole[2064];
+    snprintf(whole, sizeof(whole), "^%.*s$", (int)(length - anchor_start - anchor_end), regex + anchor_start);
+
+    StringPattern *pattern = string_pattern_compile(regex, STRING_PATTERN_REGEX);
+    regex_t posix;
+    regex_t posix_whole;
+
+    // NULL only past ZSTRING_PATTERN_MAX_STATES, as nested repeats of classes can get
+    if (pattern && regcomp(&posix, regex, REG_EXTENDED) == 0 && regcomp(&posix_whole, whole, REG_EXTENDED | REG_NOSUB) == 0)
+    {
+        STRING__FUZZ_CHECK(string_pattern_match(pattern, text) == (regexec(&posix_whole, text, 0, NULL, 0) == 0));
+
+        // Only where the empty string does not match, as POSIX reports empty matches that ZString skips
+        if (!string_pattern_match(pattern, ""))
+        {
+            regmatch_t match;
+            size_t pos = 0;
+            unsigned int count = 0;
+            unsigned int length_first = 0;
+            int first = string_pattern_find(pattern, text, &length_first);
+
+            char *expected = malloc(length_text * 2 + 2);
+            size_t length_expected = 0;
+
+            while (pos <= length_text && regexec(&posix, text + pos, 1, &match, pos ? REG_NOTBOL : 0) == 0)
+            {
+                if (count == 0) {STRING__FUZZ_CHECK(first == (int)(pos + match.rm_so) && length_first == (unsigned int)(match.rm_eo - match.rm_so));}
+
+                memcpy(expected + length_expected, text + pos, (size_t)match.rm_so);
+                length_expected += (size_t)match.rm_so;
+                expected[length_expected++] = '#';
+
+                pos += (size_t)match.rm_eo;
+                ++count;
+            }
+
+            if (count == 0) {STRING__FUZZ_CHECK(first == -1);}
+
+            memcpy(expected + length_expected, text + pos, length_text - pos + 1);
+
+            STRING__FUZZ_CHECK(string_pattern_count(pattern, text) == count);
+
+            char *output = string_pattern_replace_all(pattern, text, "#");
+            STRING__FUZZ_CHECK(output && strcmp(output, expected) == 0);
+            free(output);
+
+            free(expected);
+        }
+
+        regfree(&posix);
+        regfree(&posix_whole);
+    }
+
+    // The cache compiles each regex once and gives that same pattern back until it is cleared
+    if (pattern)
+    {
+        StringPattern *cached = string_pattern_cached(regex, STRING_PATTERN_REGEX);
+
+        STRING__FUZZ_CHECK(cached && string_pattern_cached(regex, STRING_PATTERN_REGEX) == cached);
+        STRING__FUZZ_CHECK(string_pattern_match(cached, text) == string_pattern_match(pattern, text));
+        STRING__FUZZ_CHECK(string_pattern_count(cached, text) == string_pattern_count(pattern, text));
+    }
+
+    string_pattern_free(pattern);
+
+    // Globs straight from the input; fnmatch() has no errors, so only the ones ZString takes
+    char *glob = string__fuzz_map(substr, "ab*?[]!-\\a");
+    char *name = string__fuzz_map(str, "ab*?-]\\");
+    size_t length_glob = strlen(glob);
+    size_t slashes = 0;
+
+    while (slashes < length_glob && glob[length_glob - 1 - slashes] == '\\') {++slashes;}
+
+    pattern = string_pattern_compile(glob, STRING_PATTERN_GLOB);
+
+    if (pattern && slashes % 2 == 0)
+    {
+        STRING__FUZZ_CHECK(string_pattern_match(pattern, name) == (fnmatch(glob, name, 0) == 0));
+    }
+
+    string_pattern_free(pattern);
+    free(name);
+    free(glob);
+    free(text);
+}
+
+#endif
+
+// A long run of 'a' that the longer alternatives never finish, once quadratic for find/count/replace_all
+static void string__fuzz_patterns_linear(void)
+{
+    size_t length = 1 << 20;
+    char *str = malloc(length + 1);
+    memset(str, 'a', length);
+    str[length] = '\0';
+
+    StringPattern *any = string_pattern_compile("a|a*b", STRING_PATTERN_REGEX);
+    StringPattern *pairs = string_pattern_compile("(aa)*b|a", STRING_PATTERN_REGEX);
+    StringPattern *none = string_pattern_compile("a*b", STRING_PATTERN_REGEX);
+
+    double start = string__seconds();
+
+    STRING__FUZZ_CHECK(string_pattern_count(any, str) == length);
+    STRING__FUZZ_CHECK(string_pattern_count(pairs, str) == length);
+    STRING__FUZZ_CHECK(string_pattern_find(none, str, NULL) == -1);
+
+    char *output = string_pattern_replace_all(any, str, "");
+    STRING__FUZZ_CHECK(output && output[0] == '\0');
+    free(output);
+
+    // Linear takes milliseconds, quadratic about 10^12 steps
+    STRING__FUZZ_CHECK(string__seconds() - start < 10.0);
+
+    string_pattern_free(any);
+    string_pattern_free(pairs);
+    string_pattern_free(none);
+    free(str);
+}
+
+// Against a byte-at-a-time tokenizer: fields end at the delimiter or '\n' outside of quotes
+static void string__fuzz_csv(char *buffer, size_t length, char *str, unsigned int amount)
+{
+    char delimiter = ",;\t"[amount % 3];
+    size_t *ends = malloc(sizeof(size_t) * (length + 1));
+    size_t count = 0;
+    bool in_quotes = false;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (buffer[i] == '"') {in_quotes = !in_quotes;}
+        else if (!in_quotes && (buffer[i] == delimiter || buffer[i] == '\n')) {ends[count++] = i;}
+    }
+
+    if (length > 0 && (buffer[length - 1] != '\n' || in_quotes)) {ends[count++] = length;}
+
+    StringCsv csv = string_csv_parse(buffer, length, delimiter);
+    STRING__FUZZ_CHECK(csv.count == count && (csv.in_quotes != 0) == in_quotes);
+
+    // The same stream fed in two chunks
+    size_t split = length ? amount % (length + 1) : 0;
+    StringCsv chunked = string_csv_init(delimiter);
+
+    string_csv_feed(&chunked, buffer, split);
+    string_csv_feed(&chunked, buffer + split, length - split);
+    STRING__FUZZ_CHECK(string_csv_finish(&chunked) == !in_quotes && chunked.count == count);
+
+    for (size_t i = 0; i < count && i < csv.count; ++i)
+    {
+        size_t start = i ? ends[i - 1] + 1 : 0;
+        size_t end = ends[i];
+        bool row_end = (end == length || buffer[end] == '\n');
+
+        if (row_end && end > start && buffer[end - 1] == '\r') {--end;}
+        if (end - start >= 2 && buffer[start] == '"' && buffer[end - 1] == '"') {++start; --end;}
+
+        StringSpan field = string_csv_field(&csv, buffer, i);
+
+        STRING__FUZZ_CHECK(csv.ends[i] == ends[i] && chunked.ends[i] == ends[i]);
+        STRING__FUZZ_CHECK(field.data == buffer + start && field.length == end - start);
+        STRING__FUZZ_CHECK(string_csv_row_end(&csv, buffer, i) == row_end);
+
+        char *unquoted = string_csv_unquote(field);
+        size_t j = 0;
+
+        for (size_t k = start; k < end; ++k, ++j)
+        {
+            STRING__FUZZ_CHECK(unquoted[j] == buffer[k]);
+            if (buffer[k] == '"' && k + 1 < end && buffer[k + 1] == '"') {++k;}
+        }
+
+        STRING__FUZZ_CHECK(unquoted[j] == '\0');
+        free(unquoted);
+    }
+
+    string_csv_free(&chunked);
+    string_csv_free(&csv);
+
+    // A record as a NUL terminated string, unquoted, and at least one (empty) field
+    char **fields = string_csv_split(str, delimiter);
+    StringCsv record = string_csv_parse(str, strlen(str), delimiter);
+    size_t i = 0;
+
+    STRING__FUZZ_CHECK(fields != NULL);
+
+    for (; i < record.count; ++i)
+    {
+        char *unquoted = string_csv_unquote(string_csv_field(&record, str, i));
+        STRING__FUZZ_CHECK(fields[i] && strcmp(fields[i], unquoted) == 0);
+        free(unquoted);
+    }
+
+    if (record.count == 0) {STRING__FUZZ_CHECK(fields[i++][0] == '\0');}
+    STRING__FUZZ_CHECK(fields[i] == NULL);
+
+    string_csv_free(&record);
+    free(fields);
+    free(ends);
+}
+
+// Against splitting at every '\n' and dropping one '\r' before it
+static void string__fuzz_lines(char *buffer, size_t length)
+{
+    StringLines lines = string_lines(buffer, length);
+    StringSpan line;
+    size_t start = 0;
+    size_t count = 0;
+
+    while (start < length)
+    {
+        const char *newline = memchr(buffer + start, '\n', length - start);
+        size_t end = newline ? (size_t)(newline - buffer) : length;
+        size_t length_line = end - start;
+
+        if (newline && length_line > 0 && buffer[end - 1] == '\r') {--length_line;}
+
+        STRING__FUZZ_CHECK(string_lines_next(&lines, &line));
+        STRING__FUZZ_CHECK(line.data == buffer + start && line.length == length_line);
+
+        start = end + 1;
+        ++count;
+    }
+
+    STRING__FUZZ_CHECK(!string_lines_next(&lines, &line));
+    STRING__FUZZ_CHECK(string_count_lines(buffer, length) == count);
+}
+
+static int string__fuzz_compare(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Against qsort() with strcmp()
+static void string__fuzz_sorting(char *str, unsigned int threads)
+{
+    char **tokens = string_split_any(str, " ,;", true);
+    size_t count = 0;
+
+    while (tokens[count]) {++count;}
+
+    char **sorted = malloc(sizeof(char *) * (count + 1));
+    char **expected = malloc(sizeof(char *) * (count + 1));
+
+    memcpy(sorted, tokens, sizeof(char *) * count);
+    memcpy(expected, tokens, sizeof(char *) * count);
+
+    string_sort(sorted, count);
+    qsort(expected, count, sizeof(char *), string__fuzz_compare);
+
+    for (size_t i = 0; i < count; ++i) {STRING__FUZZ_CHECK(strcmp(sorted[i], expected[i]) == 0);}
+
+    // Buckets sorted by <threads> threads, which must come out in the same order
+    memcpy(sorted, tokens, sizeof(char *) * count);
+    string_sort_parallel(sorted, count, threads);
+
+    for (size_t i = 0; i < count; ++i) {STRING__FUZZ_CHECK(strcmp(sorted[i], expected[i]) == 0);}
+
+    size_t distinct = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i == 0 || strcmp(expected[i], expected[i - 1]) != 0) {expected[distinct++] = expected[i];}
+    }
+
+    STRING__FUZZ_CHECK(string_unique(sorted, count) == distinct);
+
+    for (size_t i = 0; i < distinct; ++i) {STRING__FUZZ_CHECK(strcmp(sorted[i], expected[i]) == 0);}
+
+    free(expected);
+    free(sorted);
+    free(tokens);
+}
+
+// Key order of string_counts_top(): most frequent first, ties in byte order
+static int string__fuzz_compare_counts(const void *a, const void *b)
+{
+    const StringCount *x = a;
+    const StringCount *y = b;
+
+    if (x->count != y->count) {return (x->count < y->count) ? 1 : -1;}
+
+    size_t length = (x->key.length < y->key.length) ? x->key.length : y->key.length;
+    int order = length ? memcmp(x->key.data, y->key.data, length) : 0;
+
+    if (order != 0) {return order;}
+
+    return (x->key.length > y->key.length) - (x->key.length < y->key.length);
+}
+
+// <keys> (spans into the counted buffer) against <counts>, which was built from them
+static void string__fuzz_check_counts(StringCounts *counts, StringCount *keys, size_t count, unsigned int amount)
+{
+    size_t distinct = 0;
+
+    // Counted the slow way: each key against all the ones before it
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t j = 0;
+
+        while (j < distinct && !(keys[j].key.length == keys[i].key.length && memcmp(keys[j].key.data, keys[i].key.data, keys[i].key.length) == 0)) {++j;}
+
+        if (j == distinct) {keys[distinct].key = keys[i].key; keys[distinct++].count = 1;}
+        else {++keys[j].count;}
+    }
+
+    STRING__FUZZ_CHECK(counts->length == distinct && counts->total == count);
+
+    for (size_t i = 0; i < distinct; ++i)
+    {
+        STRING__FUZZ_CHECK(string_counts_get(counts, keys[i].key.data, keys[i].key.length) == keys[i].count);
+    }
+
+    qsort(keys, distinct, sizeof(StringCount), string__fuzz_compare_counts);
+
+    size_t k = amount % 8 + 1;
+    StringCount top[8];
+    size_t written = string_counts_top(counts, k, top);
+
+    STRING__FUZZ_CHECK(written == (distinct < k ? distinct : k));
+
+    for (size_t i = 0; i < written; ++i)
+    {
+        STRING__FUZZ_CHECK(top[i].count == keys[i].count && string__fuzz_span_equal(top[i].key, keys[i].key.data, keys[i].key.length));
+    }
+}
+
+static void string__fuzz_counting(char *buffer, size_t length, char *delimiters, unsigned int amount)
+{
+    StringCount *keys = malloc(sizeof(StringCount) * (length + 1));
+    size_t n = amount % 4 + 1;
+    size_t count = 0;
+
+    for (size_t i = 0; i + n <= length; ++i)
+    {
+        keys[count].key.data = buffer + i;
+        keys[count++].key.length = n;
+    }
+
+    StringCounts counts = string_count_ngrams(buffer, length, n, 1);
+    string__fuzz_check_counts(&counts, keys, count, amount);
+    string_counts_free(&counts);
+
+    if (*delimiters != '\0')
+    {
+        count = 0;
+
+        for (size_t i = 0; i < length;)
+        {
+            size_t end = i;
+            while (end < length && (buffer[end] == '\0' || !strchr(delimiters, buffer[end]))) {++end;}
+
+            if (end > i)
+            {
+                keys[count].key.data = buffer + i;
+                keys[count++].key.length = end - i;
+            }
+
+            i = end + 1;
+        }
+
+        counts = string_count_tokens(buffer, length, delimiters, 1);
+        string__fuzz_check_counts(&counts, keys, count, amount);
+        string_counts_free(&counts);
+    }
+
+    free(keys);
+}
+
+// Against the textbook dynamic programs: every candidate for the batch, every start and end for find_k
+static void string__fuzz_approximate(char *str, char *pattern, unsigned int amount)
+{
+    size_t length = strlen(str);
+    size_t length_pat = strlen(pattern);
+
+    if (length > 128 || length_pat > 128) {return;}
+
+    char **candidates = string_split_any(str, " ,", false);
+    size_t count = 0;
+
+    while (candidates[count]) {++count;}
+
+    unsigned int *distances = malloc(sizeof(unsigned int) * (count + 1));
+    string_edit_distance_batch(pattern, candidates, count, distances);
+
+    for (size_t i = 0; i < count; ++i) {STRING__FUZZ_CHECK(distances[i] == string__fuzz_edit_distance(pattern, candidates[i]));}
+
+    free(distances);
+    free(candidates);
+
+    unsigned int k = amount % 4;
+    unsigned int length_match = 0;
+    int found = string_find_k(str, pattern, k, &length_match);
+
+    if (length_pat <= k)
+    {
+        STRING__FUZZ_CHECK(found == 0 && length_match == 0);
+        return;
+    }
+
+    // First end where some substring is within <k> (Sellers: any start is free), then the closest (and shortest) start for it
+    unsigned int *column = malloc(sizeof(unsigned int) * (length_pat + 1));
+    size_t end = (size_t)-1;
+
+    for (size_t i = 0; i <= length_pat; ++i) {column[i] = (unsigned int)i;}
+
+    for (size_t e = 1; e <= length && end == (size_t)-1; ++e)
+    {
+        unsigned int diagonal = column[0];
+        column[0] = 0;
+
+        for (size_t i = 1; i <= length_pat; ++i)
+        {
+            unsigned int above = column[i];
+            unsigned int best = diagonal + (str[e - 1] != pattern[i - 1]);
+
+            if (above + 1 < best)         {best = above + 1;}
+            if (column[i - 1] + 1 < best) {best = column[i - 1] + 1;}
+
+            column[i] = best;
+            diagonal = above;
+        }
+
+        if (column[length_pat] <= k) {end = e;}
+    }
+
+    free(column);
+
+    if (end == (size_t)-1)
+    {
+        STRING__FUZZ_CHECK(found == -1);
+        return;
+    }
+
+    unsigned int best = (unsigned int)-1;
+    size_t best_length = 0;
+
+    for (size_t t = 1; t <= end && t <= length_pat + k; ++t)
+    {
+        char *part = string_slice(str, (unsigned int)(end - t), (unsigned int)(end - 1));
+        unsigned int distance = string__fuzz_edit_distance(part, pattern);
+        free(part);
+
+        if (distance < best) {best = distance; best_length = t;}
+    }
+
+    STRING__FUZZ_CHECK(found == (int)(end - best_length) && length_match == best_length);
+}
+
+// Nothing may outlive the input that made it, so every function's books are back at zero
+static void string__fuzz_tracking(void)
+{
+#if defined(ZSTRING_TRACK_ALLOCATIONS)
+    static StringAllocations rows[STRING__TRACK_FUNCTIONS];
+    size_t count = string_allocations(rows, STRING__TRACK_FUNCTIONS);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (rows[i].live != 0 || rows[i].live_bytes != 0) {fprintf(stderr, "ZString: %s left %zu blocks live\n", rows[i].function, rows[i].live);}
+        STRING__FUZZ_CHECK(rows[i].live == 0 && rows[i].live_bytes == 0);
+    }
+
+    STRING__FUZZ_CHECK(string__track.invalid_frees == 0 && string__track.live_bytes == 0);
+#else
+    STRING__FUZZ_CHECK(string_allocations(NULL, 0) == 0);
+#endif
+}
+
+// Whatever <data> is, no function may read outside the three strings it is cut into, or <data> itself
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    unsigned int a = (size > 0) ? data[0] : 0;
+    unsigned int b = (size > 1) ? data[1] : 0;
+
+    const char *rest = (size > 2) ? (const char *)data + 2 : "";
+    size_t length_rest = (size > 2) ? size - 2 : 0;
+
+    char *fields[3];
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const char *nul = memchr(rest, '\0', length_rest);
+        size_t length = nul ? (size_t)(nul - rest) : length_rest;
+
+        fields[i] = malloc(length + 1);
+        memcpy(fields[i], rest, length);
+        fields[i][length] = '\0';
+
+        rest += nul ? length + 1 : length;
+        length_rest -= nul ? length + 1 : length;
+    }
+
+    string__fuzz_search(fields[0], fields[1], a);
+    string__fuzz_slicing(fields[0], a % 64, b % 64);
+    string__fuzz_utf8(fields[0], a % 32, b % 32);
+    string__fuzz_editing(fields[0], fields[1], fields[2]);
+    string__fuzz_columns(fields[0], fields[1], fields[2]);
+    string__fuzz_pipelines(fields[0], fields[1], fields[2], a | b << 8);
+    string__fuzz_splitting(fields[0], fields[1]);
+    string__fuzz_encoding(fields[0]);
+    string__fuzz_numbers(data, size);
+    string__fuzz_parsing(fields[0]);
+    string__fuzz_format(data, size, fields[0]);
+#if !defined(_WIN32)
+    string__fuzz_patterns(data, size, fields[0], fields[1]);
+#endif
+    string__fuzz_sorting(fields[0], b % 4 + 1);
+    string__fuzz_approximate(fields[0], fields[1], a);
+
+    // The whole input, NULs and all, for the functions that take a length
+    char *buffer = malloc(size ? size : 1);
+    memcpy(buffer, data, size);
+
+    char delimiters[4] = {0};
+    strncpy(delimiters, fields[1], 3);
+
+    string__fuzz_buffers(buffer, size, fields[1], fields[2], a);
+    string__fuzz_csv(buffer, size, fields[0], a);
+    string__fuzz_lines(buffer, size);
+    string__fuzz_counting(buffer, size, delimiters, a);
+
+    free(buffer);
+
+    for (int i = 0; i < 3; ++i) {free(fields[i]);}
+
+    string_pattern_cache_clear();
+    string__fuzz_tracking();
+
+    return 0;
+}
+
+#if defined(ZSTRING_FUZZ_MAIN)
+
+int main(int argc, char **argv)
+{
+    // Replay: every argument is one input, as AFL (@@) and crash reproduction pass them
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            FILE *file = fopen(argv[i], "rb");
+            if (!file) {fprintf(stderr, "ZString: can not open %s\n", argv[i]); return 1;}
+
+            unsigned char *input = NULL;
+            size_t length = 0;
+            size_t read;
+            unsigned char chunk[4096];
+
+            while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            {
+                input = (realloc)(input, length + read);
+                memcpy(input + length, chunk, read);
+                length += read;
+            }
+
+            fclose(file);
+
+            LLVMFuzzerTestOneInput(input, length);
+            (free)(input);
+        }
+
+        return 0;
+    }
+
+    // Random inputs from a small alphabet, so that matches, case pairs, escapes and UTF-8 are common
+    static const char alphabet[] = "aaAbB ,;:\0\0x&<%\\\"\xC3\xA9\x80\xED\xF0" "019.e-\n\r*?[]\x1B\x7F";
+    unsigned char input[96];
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    size_t bytes = 0;
+
+    double start = string__seconds();
+
+    string__fuzz_patterns_linear();
+
+    for (size_t run = 0; run < ZSTRING_FUZZ_RUNS; ++run)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        size_t length = (size_t)(state % sizeof(input));
+        uint64_t bits = state;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (i % 8 == 0) {bits = (bits * 0x2545F4914F6CDD1DULL) ^ (bits >> 29) ^ i;}
+
+            input[i] = (i < 2) ? (unsigned char)bits : (unsigned char)alphabet[(bits >> (i % 8 * 8)) % (sizeof(alphabet) - 1)];
+        }
+
+        LLVMFuzzerTestOneInput(input, length);
+        bytes += length;
+    }
+
+    double seconds = string__seconds() - start;
+
+    fprintf(stderr, "ZString: %d random inputs checked in %.2f s, %.0f inputs/s, %.2f MB/s\n",
+        ZSTRING_FUZZ_RUNS, seconds, ZSTRING_FUZZ_RUNS / seconds, bytes / seconds / 1e6);
+
+    return 0;
+}
+
+#endif